@@ -178,6 +178,26 @@ class V8_EXPORT Heap {
       const char* source, const char* reason,
       StackState stack_state = StackState::kMayContainHeapPointers);
 
+  /**
+   * Forces a garbage collection of the young generation, i.e., of the objects
+   * allocated since the previous garbage collection. Objects that survived a
+   * garbage collection are treated as live and are only reclaimed by a full
+   * garbage collection.
+   *
+   * The stack is not scanned, so this must only be called when the stack does
+   * not contain references to young objects. The call has no effect while a
+   * full garbage collection is in progress. Without young generation support
+   * (`cppgc_enable_young_generation`), a full garbage collection is performed
+   * instead.
+   *
+   * \param source String specifying the source (or caller) triggering a
+   *   forced garbage collection.
+   * \param reason String specifying the reason for the forced garbage
+   *   collection.
+   */
+  void ForceYoungGenerationGarbageCollectionSlow(const char* source,
+                                                 const char* reason);
+
   /**
    * \returns the opaque handle for allocating objects using
    * `MakeGarbageCollected()`.
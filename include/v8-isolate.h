@@ -153,6 +153,19 @@ class V8_EXPORT ResourceConstraints {
     initial_young_generation_size_ = initial_size;
   }
 
+  /**
+   * The target for the duration of a single garbage collection pause in
+   * milliseconds. When set, V8 favors short pauses over throughput and
+   * memory: incremental marking steps, the young generation size and the
+   * priority of concurrent marking are adjusted based on the pauses observed
+   * so far. 0 means that there is no target. See also
+   * Isolate::GetGCPauseStatistics.
+   */
+  double gc_pause_target_in_ms() const { return gc_pause_target_in_ms_; }
+  void set_gc_pause_target_in_ms(double target) {
+    gc_pause_target_in_ms_ = target;
+  }
+
  private:
   static constexpr size_t kMB = 1048576u;
   size_t code_range_size_ = 0;
@@ -160,6 +173,7 @@ class V8_EXPORT ResourceConstraints {
   size_t max_young_generation_size_ = 0;
   size_t initial_old_generation_size_ = 0;
   size_t initial_young_generation_size_ = 0;
+  double gc_pause_target_in_ms_ = 0.0;
   uint32_t* stack_limit_ = nullptr;
 };
 
@@ -761,6 +775,28 @@ class V8_EXPORT Isolate {
   bool GetHeapObjectStatisticsAtLastGC(HeapObjectStatistics* object_statistics,
                                        size_t type_index);
 
+  /**
+   * Enables collection of object statistics on every |gc_interval|-th full
+   * GC. Only live objects are visited, which keeps the overhead low enough
+   * for production use with a sufficiently large interval. Passing 0 disables
+   * collection.
+   */
+  void SetHeapObjectStatisticsSamplingInterval(int gc_interval);
+
+  /**
+   * Get per-type statistics of the most recent sampled full GC, along with
+   * the change since the previous sampled GC. Only types whose count or size
+   * changed are reported. The first sample reports all live types.
+   *
+   * \param statistics The vector to append the statistics to.
+   * \param gc_count Optionally receives the number of full GCs at the time of
+   *   the sample.
+   * \returns false if no new sample has been taken since the previous call.
+   */
+  bool GetHeapObjectStatisticsDelta(
+      std::vector<HeapObjectStatisticsDelta>* statistics,
+      int* gc_count = nullptr);
+
   /**
    * Get statistics about code and its metadata in the heap.
    *
@@ -770,6 +806,22 @@ class V8_EXPORT Isolate {
    */
   bool GetHeapCodeAndMetadataStatistics(HeapCodeStatistics* object_statistics);
 
+  /**
+   * Sets the target for the duration of garbage collection pauses in
+   * milliseconds, overriding ResourceConstraints::gc_pause_target_in_ms.
+   * 0 removes the target.
+   */
+  void SetGCPauseTarget(double target_in_ms);
+
+  /**
+   * Get a histogram of the garbage collection pauses of this isolate and
+   * whether they met the pause target.
+   *
+   * \param pause_statistics The GCPauseStatistics object to fill in.
+   * \returns true on success.
+   */
+  bool GetGCPauseStatistics(GCPauseStatistics* pause_statistics);
+
   /**
    * This API is experimental and may change significantly.
    *
@@ -786,6 +838,35 @@ class V8_EXPORT Isolate {
       std::unique_ptr<MeasureMemoryDelegate> delegate,
       MeasureMemoryExecution execution = MeasureMemoryExecution::kDefault);
 
+  /**
+   * This API is experimental and may change significantly.
+   *
+   * Enables continuous memory accounting for the given context. Every full
+   * garbage collection then attributes the objects it marks to the accounted
+   * contexts, like MeasureMemory does, and records the result. Accounting
+   * slows down marking slightly.
+   *
+   * If |callback| is set, it is invoked from a task after a garbage collection
+   * that attributed more than |budget_in_bytes| to the context. Calling this
+   * function again for the same context updates its budget.
+   */
+  void SetContextMemoryBudget(Local<Context> context, size_t budget_in_bytes,
+                              ContextMemoryBudgetCallback callback = nullptr,
+                              void* data = nullptr);
+
+  /**
+   * Stops memory accounting for the given context.
+   */
+  void ClearContextMemoryBudget(Local<Context> context);
+
+  /**
+   * Returns the size in bytes of the objects attributed to the given context
+   * by the most recent full garbage collection. Returns 0 if the context is
+   * not accounted or if no full garbage collection finished since accounting
+   * started. This function is cheap and does not trigger a garbage collection.
+   */
+  size_t GetContextMemoryUsage(Local<Context> context);
+
   /**
    * Get a call stack sample from the isolate.
    * \param state Execution state.
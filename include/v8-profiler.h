@@ -172,6 +172,48 @@ class V8_EXPORT CpuProfileNode {
   static const int kNoColumnNumberInfo = Message::kNoColumnInfo;
 };
 
+/**
+ * Allocation statistics of a single call site, see
+ * HeapProfiler::GetAllocationCallsiteStats.
+ */
+struct AllocationCallsiteStats {
+  /**
+   * Name of the function that allocated. The string is owned by the heap
+   * profiler and stays valid until the profiler releases its names.
+   */
+  const char* function_name;
+
+  /**
+   * Id of the script containing the function, or
+   * UnboundScript::kNoScriptId for functions without a script.
+   */
+  int script_id;
+
+  /**
+   * Start position of the function in the script.
+   */
+  int start_position;
+
+  /**
+   * Offset of the allocating bytecode in the function, or -1 if the
+   * function was running as optimized code.
+   */
+  int bytecode_offset;
+
+  /**
+   * Number of sampled allocations and their total size in bytes.
+   */
+  size_t allocation_samples;
+  size_t allocation_bytes;
+
+  /**
+   * Number of sampled objects that survived the configured number of
+   * garbage collections and their total size in bytes.
+   */
+  size_t surviving_samples;
+  size_t surviving_bytes;
+};
+
 
 /**
  * CpuProfile contains a CPU profile in a form of top-down call tree
@@ -532,7 +574,8 @@ class V8_EXPORT OutputStream {
 class V8_EXPORT HeapSnapshot {
  public:
   enum SerializationFormat {
-    kJSON = 0  // See format description near 'Serialize' method.
+    kJSON = 0,   // See format description near 'Serialize' method.
+    kBinary = 1  // See format description near 'Serialize' method.
   };
 
   /** Returns the root node of the heap graph. */
@@ -582,9 +625,23 @@ class V8_EXPORT HeapSnapshot {
    *
    * Nodes reference strings, other nodes, and edges by their indexes
    * in corresponding arrays.
+   *
+   * The binary format carries the same nodes, edges, locations, and strings
+   * in a compact varint encoding that is written incrementally, with strings
+   * emitted on first use. It does not include allocation tracking data. The
+   * chunks are written through WriteAsciiChunk() but contain arbitrary bytes.
+   * Use ConvertBinaryToJSON() to obtain the JSON format.
    */
   void Serialize(OutputStream* stream,
                  SerializationFormat format = kJSON) const;
+
+  /**
+   * Converts a snapshot serialized in the kBinary format into the kJSON
+   * format, writing the result into the stream provided. Returns false if
+   * |data| is not a valid binary snapshot.
+   */
+  static bool ConvertBinaryToJSON(const char* data, size_t length,
+                                  OutputStream* stream);
 };
 
 
@@ -986,6 +1043,34 @@ class V8_EXPORT HeapProfiler {
    */
   AllocationProfile* GetAllocationProfile();
 
+  /**
+   * Starts a lightweight allocation sampler that attributes sampled
+   * allocations to the call site that made them, i.e. the top JavaScript
+   * function and bytecode offset. Unlike the sampling heap profiler, no stack
+   * traces are collected and samples are aggregated off the main thread,
+   * which makes it suitable for running continuously in production.
+   *
+   * On average, one allocation is sampled every |sample_interval| bytes. A
+   * sampled object that is still alive after |survival_gc_count| garbage
+   * collections is counted as a survivor of its call site.
+   *
+   * Returns false if the sampler is already running.
+   */
+  bool StartAllocationCallsiteSampling(uint64_t sample_interval = 512 * 1024,
+                                       int survival_gc_count = 2);
+
+  /**
+   * Stops the allocation call site sampler and discards its statistics.
+   */
+  void StopAllocationCallsiteSampling();
+
+  /**
+   * Appends the statistics accumulated since the previous call to |stats|,
+   * one entry per call site with new samples or survivors. Returns false if
+   * the allocation call site sampler is not running.
+   */
+  bool GetAllocationCallsiteStats(std::vector<AllocationCallsiteStats>* stats);
+
   /**
    * Deletes all snapshots taken. All previously returned pointers to
    * snapshots and their contents become invalid after this call.
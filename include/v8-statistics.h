@@ -86,6 +86,19 @@ class V8_EXPORT MeasureMemoryDelegate {
       Local<Promise::Resolver> promise_resolver, MeasureMemoryMode mode);
 };
 
+/**
+ * Called after a full garbage collection that attributed more than the budget
+ * set with Isolate::SetContextMemoryBudget to |context|.
+ *
+ * \param size_in_bytes the size attributed to the context by that garbage
+ *   collection.
+ */
+using ContextMemoryBudgetCallback = void (*)(Isolate* isolate,
+                                             Local<Context> context,
+                                             size_t size_in_bytes,
+                                             size_t budget_in_bytes,
+                                             void* data);
+
 /**
  * Collection of shared per-process V8 memory information.
  *
@@ -195,6 +208,21 @@ class V8_EXPORT HeapObjectStatistics {
   friend class Isolate;
 };
 
+/**
+ * Statistics of one object type at a sampled full GC, see
+ * Isolate::GetHeapObjectStatisticsDelta().
+ */
+struct HeapObjectStatisticsDelta {
+  /** Name of the object type, with static lifetime. */
+  const char* object_type;
+  /** Live objects of this type and their size at the sampled GC. */
+  size_t object_count;
+  size_t object_size;
+  /** Change compared to the previous sampled GC. */
+  int64_t object_count_delta;
+  int64_t object_size_delta;
+};
+
 class V8_EXPORT HeapCodeStatistics {
  public:
   HeapCodeStatistics();
@@ -210,6 +238,52 @@ class V8_EXPORT HeapCodeStatistics {
   friend class Isolate;
 };
 
+/**
+ * Histogram of the garbage collection pauses of an isolate. Pauses are
+ * atomic garbage collections and incremental marking steps on the main
+ * thread.
+ *
+ * Instances of this class can be passed to v8::Isolate::GetGCPauseStatistics.
+ */
+class V8_EXPORT GCPauseStatistics {
+ public:
+  static constexpr size_t kNumberOfBuckets = 10;
+
+  GCPauseStatistics();
+
+  /**
+   * Returns the exclusive upper bound of the pause durations counted in
+   * bucket |index| in milliseconds. The bounds double from bucket to bucket,
+   * the last bucket is unbounded.
+   */
+  static double bucket_upper_bound_in_ms(size_t index);
+
+  size_t bucket_count(size_t index) { return bucket_counts_[index]; }
+  size_t total_pauses() { return total_pauses_; }
+  double max_pause_in_ms() { return max_pause_in_ms_; }
+
+  /**
+   * The pause target in effect, or 0 if there is none, and the number of
+   * pauses that took longer than the target at the time they happened.
+   */
+  double pause_target_in_ms() { return pause_target_in_ms_; }
+  size_t pauses_over_target() { return pauses_over_target_; }
+
+  /**
+   * Returns true if at least 99% of the pauses met the pause target.
+   */
+  bool target_met() { return pauses_over_target_ * 100 <= total_pauses_; }
+
+ private:
+  size_t bucket_counts_[kNumberOfBuckets];
+  size_t total_pauses_;
+  size_t pauses_over_target_;
+  double max_pause_in_ms_;
+  double pause_target_in_ms_;
+
+  friend class Isolate;
+};
+
 }  // namespace v8
 
 #endif  // INCLUDE_V8_STATISTICS_H_
@@ -58,6 +58,7 @@
 #include "src/handles/global-handles.h"
 #include "src/handles/persistent-handles.h"
 #include "src/heap/embedder-tracing.h"
+#include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
 #include "src/init/bootstrapper.h"
 #include "src/init/icu_util.h"
@@ -6091,6 +6092,21 @@ HeapCodeStatistics::HeapCodeStatistics()
       bytecode_and_metadata_size_(0),
       external_script_source_size_(0) {}
 
+GCPauseStatistics::GCPauseStatistics()
+    : bucket_counts_{},
+      total_pauses_(0),
+      pauses_over_target_(0),
+      max_pause_in_ms_(0.0),
+      pause_target_in_ms_(0.0) {}
+
+// static
+double GCPauseStatistics::bucket_upper_bound_in_ms(size_t index) {
+  Utils::ApiCheck(index < kNumberOfBuckets,
+                  "v8::GCPauseStatistics::bucket_upper_bound_in_ms()",
+                  "Bucket index out of range");
+  return i::GCTracer::PauseHistogramBucketBoundInMs(static_cast<int>(index));
+}
+
 bool v8::V8::InitializeICU(const char* icu_data_file) {
   return i::InitializeICU(icu_data_file);
 }
@@ -8826,6 +8842,19 @@ bool Isolate::GetHeapObjectStatisticsAtLastGC(
   return true;
 }
 
+void Isolate::SetHeapObjectStatisticsSamplingInterval(int gc_interval) {
+  CHECK_GE(gc_interval, 0);
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->set_object_stats_sampling_interval(gc_interval);
+}
+
+bool Isolate::GetHeapObjectStatisticsDelta(
+    std::vector<HeapObjectStatisticsDelta>* statistics, int* gc_count) {
+  if (!statistics) return false;
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  return isolate->heap()->GetObjectStatsDelta(statistics, gc_count);
+}
+
 bool Isolate::GetHeapCodeAndMetadataStatistics(
     HeapCodeStatistics* code_statistics) {
   if (!code_statistics) return false;
@@ -8847,6 +8876,56 @@ bool Isolate::MeasureMemory(std::unique_ptr<MeasureMemoryDelegate> delegate,
   return isolate->heap()->MeasureMemory(std::move(delegate), execution);
 }
 
+void Isolate::SetContextMemoryBudget(Local<Context> context,
+                                     size_t budget_in_bytes,
+                                     ContextMemoryBudgetCallback callback,
+                                     void* data) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::Handle<i::NativeContext> native_context =
+      i::Handle<i::NativeContext>::cast(Utils::OpenHandle(*context));
+  isolate->heap()->memory_measurement()->SetContextBudget(
+      native_context, budget_in_bytes, callback, data);
+}
+
+void Isolate::ClearContextMemoryBudget(Local<Context> context) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::Handle<i::NativeContext> native_context =
+      i::Handle<i::NativeContext>::cast(Utils::OpenHandle(*context));
+  isolate->heap()->memory_measurement()->ClearContextBudget(native_context);
+}
+
+size_t Isolate::GetContextMemoryUsage(Local<Context> context) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::Handle<i::NativeContext> native_context =
+      i::Handle<i::NativeContext>::cast(Utils::OpenHandle(*context));
+  return isolate->heap()->memory_measurement()->GetContextSize(
+      native_context);
+}
+
+void Isolate::SetGCPauseTarget(double target_in_ms) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->SetGCPauseTarget(std::max(target_in_ms, 0.0));
+}
+
+bool Isolate::GetGCPauseStatistics(GCPauseStatistics* pause_statistics) {
+  if (!pause_statistics) return false;
+  STATIC_ASSERT(GCPauseStatistics::kNumberOfBuckets ==
+                i::GCTracer::kPauseHistogramBuckets);
+
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::Heap* heap = isolate->heap();
+  const i::GCTracer::PauseHistogram& histogram =
+      heap->tracer()->pause_histogram();
+  for (size_t i = 0; i < GCPauseStatistics::kNumberOfBuckets; i++) {
+    pause_statistics->bucket_counts_[i] = histogram.buckets[i];
+  }
+  pause_statistics->total_pauses_ = histogram.total_pauses;
+  pause_statistics->pauses_over_target_ = histogram.pauses_over_target;
+  pause_statistics->max_pause_in_ms_ = histogram.max_pause_in_ms;
+  pause_statistics->pause_target_in_ms_ = heap->gc_pause_target_ms();
+  return true;
+}
+
 std::unique_ptr<MeasureMemoryDelegate> MeasureMemoryDelegate::Default(
     Isolate* isolate, Local<Context> context,
     Local<Promise::Resolver> promise_resolver, MeasureMemoryMode mode) {
@@ -9969,14 +10048,30 @@ SnapshotObjectId HeapSnapshot::GetMaxSnapshotJSObjectId() const {
 
 void HeapSnapshot::Serialize(OutputStream* stream,
                              HeapSnapshot::SerializationFormat format) const {
-  Utils::ApiCheck(format == kJSON, "v8::HeapSnapshot::Serialize",
+  Utils::ApiCheck(format == kJSON || format == kBinary,
+                  "v8::HeapSnapshot::Serialize",
                   "Unknown serialization format");
   Utils::ApiCheck(stream->GetChunkSize() > 0, "v8::HeapSnapshot::Serialize",
                   "Invalid stream chunk size");
+  if (format == kBinary) {
+    i::HeapSnapshotBinarySerializer serializer(ToInternal(this));
+    serializer.Serialize(stream);
+    return;
+  }
   i::HeapSnapshotJSONSerializer serializer(ToInternal(this));
   serializer.Serialize(stream);
 }
 
+// static
+bool HeapSnapshot::ConvertBinaryToJSON(const char* data, size_t length,
+                                       OutputStream* stream) {
+  Utils::ApiCheck(stream->GetChunkSize() > 0,
+                  "v8::HeapSnapshot::ConvertBinaryToJSON",
+                  "Invalid stream chunk size");
+  i::HeapSnapshotBinaryConverter converter(data, length);
+  return converter.Convert(stream);
+}
+
 // static
 STATIC_CONST_MEMBER_DEFINITION const SnapshotObjectId
     HeapProfiler::kUnknownObjectId;
@@ -10049,6 +10144,22 @@ AllocationProfile* HeapProfiler::GetAllocationProfile() {
   return reinterpret_cast<i::HeapProfiler*>(this)->GetAllocationProfile();
 }
 
+bool HeapProfiler::StartAllocationCallsiteSampling(uint64_t sample_interval,
+                                                   int survival_gc_count) {
+  return reinterpret_cast<i::HeapProfiler*>(this)
+      ->StartAllocationCallsiteSampling(sample_interval, survival_gc_count);
+}
+
+void HeapProfiler::StopAllocationCallsiteSampling() {
+  reinterpret_cast<i::HeapProfiler*>(this)->StopAllocationCallsiteSampling();
+}
+
+bool HeapProfiler::GetAllocationCallsiteStats(
+    std::vector<AllocationCallsiteStats>* stats) {
+  return reinterpret_cast<i::HeapProfiler*>(this)->GetAllocationCallsiteStats(
+      stats);
+}
+
 void HeapProfiler::DeleteAllHeapSnapshots() {
   reinterpret_cast<i::HeapProfiler*>(this)->DeleteAllSnapshots();
 }
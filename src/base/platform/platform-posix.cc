@@ -31,6 +31,7 @@
 #include <android/log.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 
@@ -661,6 +662,99 @@ int OS::GetCurrentThreadId() {
 #endif
 }
 
+int OS::NumberOfNumaNodes() {
+#if V8_OS_LINUX && !V8_OS_ANDROID
+  // The file holds the ranges of possible node ids, e.g. "0-3".
+  static const int count = [] {
+    FILE* file = fopen("/sys/devices/system/node/possible", "r");
+    if (file == nullptr) return 1;
+    int max_node = 0;
+    int node;
+    char separator;
+    while (fscanf(file, "%d", &node) == 1) {
+      if (node > max_node) max_node = node;
+      if (fscanf(file, "%c", &separator) != 1) break;
+    }
+    fclose(file);
+    return max_node + 1;
+  }();
+  return count;
+#else
+  return 1;
+#endif
+}
+
+int OS::GetCurrentNumaNode() {
+#if V8_OS_LINUX && !V8_OS_ANDROID && defined(__NR_getcpu)
+  unsigned cpu;
+  unsigned node;
+  if (syscall(__NR_getcpu, &cpu, &node, nullptr) != 0) return 0;
+  return static_cast<int>(node);
+#else
+  return 0;
+#endif
+}
+
+bool OS::SetPreferredNumaNode(void* address, size_t size, int node) {
+#if V8_OS_LINUX && !V8_OS_ANDROID && defined(__NR_mbind)
+  // MPOL_PREFERRED from <linux/mempolicy.h>, which is not always available.
+  constexpr int kPreferredPolicy = 1;
+  unsigned long node_mask = 0;  // NOLINT(runtime/int)
+  if (node < 0 || node >= static_cast<int>(sizeof(node_mask) * CHAR_BIT)) {
+    return false;
+  }
+  node_mask = 1ul << node;
+  DCHECK_EQ(0, reinterpret_cast<uintptr_t>(address) % CommitPageSize());
+  return syscall(__NR_mbind, address, size, kPreferredPolicy, &node_mask,
+                 sizeof(node_mask) * CHAR_BIT, 0) == 0;
+#else
+  return false;
+#endif
+}
+
+bool OS::AdviseHugePages(void* address, size_t size) {
+#if V8_OS_LINUX && !V8_OS_ANDROID && defined(MADV_HUGEPAGE)
+  DCHECK_EQ(0, reinterpret_cast<uintptr_t>(address) % kHugePageSize);
+  return madvise(address, size, MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
+
+size_t OS::HugePageBackedMemory(void* address, size_t size) {
+#if V8_OS_LINUX && !V8_OS_ANDROID
+  // Every mapping in smaps starts with a "begin-end ..." line followed by
+  // per-mapping counters, among them "AnonHugePages: <n> kB". Mappings only
+  // partially overlapping the range are accounted for up to the overlap.
+  FILE* file = fopen("/proc/self/smaps", "r");
+  if (file == nullptr) return 0;
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(address);
+  const uintptr_t end = begin + size;
+  size_t overlap = 0;
+  size_t result = 0;
+  char line[512];
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    uintptr_t mapping_begin;
+    uintptr_t mapping_end;
+    size_t kilobytes;
+    if (sscanf(line, "%" V8PRIxPTR "-%" V8PRIxPTR, &mapping_begin,
+               &mapping_end) == 2) {
+      overlap = (mapping_begin < end && begin < mapping_end)
+                    ? std::min(mapping_end, end) -
+                          std::max(mapping_begin, begin)
+                    : 0;
+    } else if (overlap > 0 &&
+               sscanf(line, "AnonHugePages: %zu kB", &kilobytes) == 1) {
+      result += std::min(kilobytes * 1024, overlap);
+    }
+  }
+  fclose(file);
+  return result;
+#else
+  return 0;
+#endif
+}
+
 void OS::ExitProcess(int exit_code) {
   // Use _exit instead of exit to avoid races between isolate
   // threads and static destructors.
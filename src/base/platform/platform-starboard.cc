@@ -272,6 +272,18 @@ int OS::GetCurrentProcessId() {
 
 int OS::GetCurrentThreadId() { return SbThreadGetId(); }
 
+int OS::NumberOfNumaNodes() { return 1; }
+
+int OS::GetCurrentNumaNode() { return 0; }
+
+bool OS::SetPreferredNumaNode(void* address, size_t size, int node) {
+  return false;
+}
+
+bool OS::AdviseHugePages(void* address, size_t size) { return false; }
+
+size_t OS::HugePageBackedMemory(void* address, size_t size) { return 0; }
+
 int OS::GetLastError() { return SbSystemGetLastError(); }
 
 // ----------------------------------------------------------------------------
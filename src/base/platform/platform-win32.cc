@@ -528,6 +528,20 @@ int OS::GetCurrentThreadId() {
   return static_cast<int>(::GetCurrentThreadId());
 }
 
+// Windows only supports choosing the NUMA node when memory is reserved, which
+// does not fit page pools that are reused across threads.
+int OS::NumberOfNumaNodes() { return 1; }
+
+int OS::GetCurrentNumaNode() { return 0; }
+
+bool OS::SetPreferredNumaNode(void* address, size_t size, int node) {
+  return false;
+}
+
+bool OS::AdviseHugePages(void* address, size_t size) { return false; }
+
+size_t OS::HugePageBackedMemory(void* address, size_t size) { return 0; }
+
 void OS::ExitProcess(int exit_code) {
   // Use TerminateProcess to avoid races between isolate threads and
   // static destructors.
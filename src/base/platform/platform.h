@@ -274,6 +274,27 @@ class V8_BASE_EXPORT OS {
 
   static void AdjustSchedulingParams();
 
+  // NUMA topology. Platforms without NUMA support report a single node.
+  static int NumberOfNumaNodes();
+  static int GetCurrentNumaNode();
+
+  // Makes |node| the preferred NUMA node of the pages in [address,
+  // address + size) that are faulted in from now on. Returns false if this is
+  // not supported.
+  static bool SetPreferredNumaNode(void* address, size_t size, int node);
+
+  // Transparent huge pages.
+  static constexpr size_t kHugePageSize = size_t{2} * 1024 * 1024;
+
+  // Asks the OS to back [address, address + size) with huge pages when it
+  // is touched. The range should be kHugePageSize aligned. Returns false if
+  // this is not supported.
+  static bool AdviseHugePages(void* address, size_t size);
+
+  // Returns the number of bytes in [address, address + size) that are
+  // currently backed by huge pages, or 0 if this cannot be determined.
+  static size_t HugePageBackedMemory(void* address, size_t size);
+
   using Address = uintptr_t;
 
   struct MemoryRange {
@@ -9,6 +9,7 @@
 #include <unordered_map>
 
 #include "src/base/lazy-instance.h"
+#include "src/base/once.h"
 #include "src/flags/flags.h"
 #include "src/utils/utils.h"
 
@@ -38,17 +39,12 @@ class ProfileDataFromFileInternal : public ProfileDataFromFile {
   bool hash_has_value_ = false;
 };
 
-const std::unordered_map<std::string, ProfileDataFromFileInternal>&
-EnsureInitProfileData() {
-  static base::LeakyObject<
-      std::unordered_map<std::string, ProfileDataFromFileInternal>>
-      data;
-  static bool initialized = false;
+using ProfileDataMap =
+    std::unordered_map<std::string, ProfileDataFromFileInternal>;
 
-  if (initialized) return *data.get();
-  initialized = true;
+void ReadProfileData(ProfileDataMap* data) {
   const char* filename = FLAG_turbo_profiling_log_file;
-  if (filename == nullptr) return *data.get();
+  if (filename == nullptr) return;
   std::ifstream file(filename);
   CHECK_WITH_MSG(file.good(), "Can't read log file");
   for (std::string line; std::getline(file, line);) {
@@ -69,8 +65,7 @@ EnsureInitProfileData() {
       CHECK(line_stream.eof());
       double count = strtod(token.c_str(), &end);
       CHECK(errno == 0 && end != token.c_str());
-      ProfileDataFromFileInternal& counters_and_hash =
-          (*data.get())[builtin_name];
+      ProfileDataFromFileInternal& counters_and_hash = (*data)[builtin_name];
       // We allow concatenating data from several Isolates, so we might see the
       // same block multiple times. Just sum them all.
       counters_and_hash.AddCountToBlock(id, count);
@@ -85,8 +80,7 @@ EnsureInitProfileData() {
       char* end = nullptr;
       int hash = static_cast<int>(strtol(token.c_str(), &end, 0));
       CHECK(errno == 0 && end != token.c_str());
-      ProfileDataFromFileInternal& counters_and_hash =
-          (*data.get())[builtin_name];
+      ProfileDataFromFileInternal& counters_and_hash = (*data)[builtin_name];
       // We allow concatenating data from several Isolates, but expect them all
       // to be running the same build. Any file with mismatched hashes for a
       // function is considered ill-formed.
@@ -95,17 +89,24 @@ EnsureInitProfileData() {
       counters_and_hash.set_hash(hash);
     }
   }
-  for (const auto& pair : *data.get()) {
+  for (const auto& pair : *data) {
     // Every function is required to have a hash in the log.
     CHECK(pair.second.hash_has_value());
   }
-  if (data.get()->size() == 0) {
+  if (data->size() == 0) {
     PrintF(
         "No basic block counters were found in log file.\n"
         "Did you build with v8_enable_builtins_profiling=true\n"
         "and run with --turbo-profiling-log-builtins?\n");
   }
+}
 
+const ProfileDataMap& EnsureInitProfileData() {
+  static base::LeakyObject<ProfileDataMap> data;
+  // Optimized JavaScript functions look up their profile on background
+  // threads.
+  static base::OnceType init_once = V8_ONCE_INIT;
+  base::CallOnce(&init_once, [] { ReadProfileData(data.get()); });
   return *data.get();
 }
 
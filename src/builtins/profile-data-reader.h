@@ -54,6 +54,11 @@ static constexpr char kBlockCounterMarker[] = "block";
 // function Graph for a builtin.
 static constexpr char kBuiltinHashMarker[] = "builtin_hash";
 
+// Prefix of the names under which optimized JavaScript functions are logged
+// with --turbo-profiling-log-js. The rest of the name is derived from the
+// function's source text and graph, see JSProfileName() in pipeline.cc.
+static constexpr char kJSFunctionPrefix[] = "js_";
+
 }  // namespace ProfileDataFromFileConstants
 
 }  // namespace internal
@@ -19,6 +19,7 @@
 #include "src/execution/frame-constants.h"
 #include "src/execution/frames-inl.h"
 #include "src/heap/memory-chunk.h"
+#include "src/heap/third-party/heap-api.h"
 #include "src/init/bootstrapper.h"
 #include "src/logging/counters.h"
 #include "src/runtime/runtime.h"
@@ -3239,6 +3240,24 @@ void MacroAssembler::RecordWrite(Register object, Operand offset,
     Check(eq, AbortReason::kWrongAddressOrValuePassedToRecordWrite);
   }
 
+  if (V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL &&
+      remembered_set_action == RememberedSetAction::kEmit) {
+    // Unconditionally mark the card of the slot.
+    UseScratchRegisterScope temps(this);
+    Register card = temps.AcquireX();
+    Register card_table = temps.AcquireX();
+    Add(card, object, offset);
+    Lsr(card, card, third_party_heap::Heap::kCardSizeLog2);
+    Mov(card_table,
+        ExternalReference::third_party_heap_card_table_base_address(
+            isolate()));
+    Ldr(card_table, MemOperand(card_table));
+    Add(card_table, card_table, card);
+    Mov(card, third_party_heap::Heap::kDirtyCard);
+    Strb(card.W(), MemOperand(card_table));
+    return;
+  }
+
   if ((remembered_set_action == RememberedSetAction::kOmit &&
        !FLAG_incremental_marking) ||
       FLAG_disable_write_barriers) {
@@ -4811,6 +4811,17 @@ void CodeStubAssembler::FillFixedDoubleArrayWithZero(
 void CodeStubAssembler::JumpIfPointersFromHereAreInteresting(
     TNode<Object> object, Label* interesting) {
   Label finished(this);
+  if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) {
+    // Third-party heaps have no page flags. Only the generational one needs a
+    // barrier, and it marks the card of every store.
+    if (V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL) {
+      Branch(Int32TrueConstant(), interesting, &finished);
+    } else {
+      Goto(&finished);
+    }
+    BIND(&finished);
+    return;
+  }
   TNode<IntPtrT> object_word = BitcastTaggedToWord(object);
   TNode<IntPtrT> object_page = PageFromAddress(object_word);
   TNode<IntPtrT> page_flags = UncheckedCast<IntPtrT>(Load(
@@ -4831,11 +4842,12 @@ void CodeStubAssembler::MoveElements(ElementsKind kind,
                                      TNode<IntPtrT> length) {
   Label finished(this);
   Label needs_barrier(this);
-#ifdef V8_DISABLE_WRITE_BARRIERS
+#if defined(V8_DISABLE_WRITE_BARRIERS) && \
+    !defined(V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL)
   const bool needs_barrier_check = false;
 #else
   const bool needs_barrier_check = !IsDoubleElementsKind(kind);
-#endif  // V8_DISABLE_WRITE_BARRIERS
+#endif
 
   DCHECK(IsFastElementsKind(kind));
   CSA_DCHECK(this, IsFixedArrayWithKind(elements, kind));
@@ -4920,11 +4932,12 @@ void CodeStubAssembler::CopyElements(ElementsKind kind,
                                      WriteBarrierMode write_barrier) {
   Label finished(this);
   Label needs_barrier(this);
-#ifdef V8_DISABLE_WRITE_BARRIERS
+#if defined(V8_DISABLE_WRITE_BARRIERS) && \
+    !defined(V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL)
   const bool needs_barrier_check = false;
 #else
   const bool needs_barrier_check = !IsDoubleElementsKind(kind);
-#endif  // V8_DISABLE_WRITE_BARRIERS
+#endif
 
   DCHECK(IsFastElementsKind(kind));
   CSA_DCHECK(this, IsFixedArrayWithKind(dst_elements, kind));
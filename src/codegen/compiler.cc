@@ -17,6 +17,7 @@
 #include "src/baseline/baseline.h"
 #include "src/codegen/assembler-inl.h"
 #include "src/codegen/compilation-cache.h"
+#include "src/codegen/optimization-hints.h"
 #include "src/codegen/optimized-compilation-info.h"
 #include "src/codegen/pending-optimization-table.h"
 #include "src/codegen/script-details.h"
@@ -944,6 +945,13 @@ void InsertCodeIntoOptimizedCodeCache(
   }
 }
 
+void RecordOptimizationHint(OptimizedCompilationInfo* compilation_info) {
+  if (V8_LIKELY(FLAG_optimization_hints_file == nullptr)) return;
+  if (compilation_info->code_kind() != CodeKind::TURBOFAN) return;
+  if (!compilation_info->osr_offset().IsNone()) return;
+  OptimizationHints::RecordOptimizedFunction(*compilation_info->closure());
+}
+
 // Runs PrepareJob in the proper compilation & canonical scopes. Handles will be
 // allocated in a persistent handle scope that is detached and handed off to the
 // {compilation_info} after PrepareJob.
@@ -987,6 +995,7 @@ bool GetOptimizedCodeNow(OptimizedCompilationJob* job, Isolate* isolate,
   job->RecordCompilationStats(OptimizedCompilationJob::kSynchronous, isolate);
   DCHECK(!isolate->has_pending_exception());
   InsertCodeIntoOptimizedCodeCache(compilation_info);
+  RecordOptimizationHint(compilation_info);
   job->RecordFunctionCompilation(CodeEventListener::LAZY_COMPILE_TAG, isolate);
   return true;
 }
@@ -994,8 +1003,15 @@ bool GetOptimizedCodeNow(OptimizedCompilationJob* job, Isolate* isolate,
 bool GetOptimizedCodeLater(std::unique_ptr<OptimizedCompilationJob> job,
                            Isolate* isolate,
                            OptimizedCompilationInfo* compilation_info,
-                           CodeKind code_kind, Handle<JSFunction> function) {
-  if (!isolate->optimizing_compile_dispatcher()->IsQueueAvailable()) {
+                           CodeKind code_kind, Handle<JSFunction> function,
+                           int profiler_ticks) {
+  OptimizingCompileDispatcher* dispatcher =
+      isolate->optimizing_compile_dispatcher();
+  OptimizingCompileDispatcher::Priority priority =
+      OptimizingCompileDispatcher::PriorityFor(*function, profiler_ticks);
+  dispatcher->CancelStaleJobs();
+  if (!dispatcher->IsQueueAvailable(priority)) {
+    isolate->counters()->concurrent_recompilation_dropped_jobs()->Increment();
     if (FLAG_trace_concurrent_recompilation) {
       PrintF("  ** Compilation queue full, will retry optimizing ");
       compilation_info->closure()->ShortPrint();
@@ -1023,7 +1039,7 @@ bool GetOptimizedCodeLater(std::unique_ptr<OptimizedCompilationJob> job,
   }
 
   // The background recompile will own this job.
-  isolate->optimizing_compile_dispatcher()->QueueForOptimization(job.get());
+  dispatcher->QueueForOptimization(job.get(), priority);
   job.release();
 
   if (FLAG_trace_concurrent_recompilation) {
@@ -1127,8 +1143,10 @@ MaybeHandle<Code> GetOptimizedCode(
     }
   }
 
-  // Reset profiler ticks, function is no longer considered hot.
+  // Reset profiler ticks, function is no longer considered hot. The ticks
+  // it had determine the priority of a concurrent job.
   DCHECK(shared->is_compiled());
+  const int profiler_ticks = function->feedback_vector().profiler_ticks();
   function->feedback_vector().set_profiler_ticks(0);
 
   VMState<COMPILER> state(isolate);
@@ -1154,7 +1172,7 @@ MaybeHandle<Code> GetOptimizedCode(
   // Prepare the job and launch concurrent compilation, or compile now.
   if (mode == ConcurrencyMode::kConcurrent) {
     if (GetOptimizedCodeLater(std::move(job), isolate, compilation_info,
-                              code_kind, function)) {
+                              code_kind, function, profiler_ticks)) {
       return ContinuationForConcurrentOptimization(isolate, function);
     }
   } else {
@@ -3362,6 +3380,7 @@ bool Compiler::FinalizeOptimizedCompilationJob(OptimizedCompilationJob* job,
                                      isolate);
       if (V8_LIKELY(use_result)) {
         InsertCodeIntoOptimizedCodeCache(compilation_info);
+        RecordOptimizationHint(compilation_info);
         CompilerTracer::TraceCompletedJob(isolate, compilation_info);
         compilation_info->closure()->set_code(*compilation_info->code(),
                                               kReleaseStore);
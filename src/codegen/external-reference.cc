@@ -462,6 +462,12 @@ ExternalReference ExternalReference::heap_is_marking_flag_address(
   return ExternalReference(isolate->heap()->IsMarkingFlagAddress());
 }
 
+ExternalReference ExternalReference::third_party_heap_card_table_base_address(
+    Isolate* isolate) {
+  return ExternalReference(
+      isolate->heap()->ThirdPartyHeapCardTableBaseAddress());
+}
+
 ExternalReference ExternalReference::new_space_allocation_top_address(
     Isolate* isolate) {
   return ExternalReference(isolate->heap()->NewSpaceAllocationTopAddress());
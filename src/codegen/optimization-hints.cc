@@ -0,0 +1,191 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/codegen/optimization-hints.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "src/base/functional.h"
+#include "src/base/lazy-instance.h"
+#include "src/base/platform/mutex.h"
+#include "src/flags/flags.h"
+#include "src/objects/feedback-vector-inl.h"
+#include "src/objects/js-function-inl.h"
+#include "src/objects/script-inl.h"
+#include "src/objects/shared-function-info-inl.h"
+#include "src/objects/string-inl.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Bounds the growth of the file for functions whose feedback differs between
+// runs.
+constexpr size_t kMaxDigestsPerFunction = 4;
+
+struct HintTable {
+  base::Mutex mutex;
+  bool loaded = false;
+  bool dirty = false;
+  std::unordered_map<uint64_t, std::vector<uint32_t>> digests;
+};
+
+DEFINE_LAZY_LEAKY_OBJECT_GETTER(HintTable, GetHintTable)
+
+bool AddDigest(HintTable* table, uint64_t key, uint32_t digest) {
+  std::vector<uint32_t>& digests = table->digests[key];
+  if (digests.size() >= kMaxDigestsPerFunction) return false;
+  if (std::find(digests.begin(), digests.end(), digest) != digests.end()) {
+    return false;
+  }
+  digests.push_back(digest);
+  return true;
+}
+
+// The file has one hint per line, as two hexadecimal numbers:
+//   function_key , feedback_digest
+void EnsureLoaded(HintTable* table) {
+  if (table->loaded) return;
+  table->loaded = true;
+  std::ifstream file(FLAG_optimization_hints_file);
+  // A missing file is expected on the first run.
+  if (!file.good()) return;
+  for (std::string line; std::getline(file, line);) {
+    std::istringstream line_stream(line);
+    uint64_t key = 0;
+    uint32_t digest = 0;
+    char separator = 0;
+    line_stream >> std::hex >> key >> separator >> digest;
+    if (line_stream.fail() || separator != ',' || key == 0) continue;
+    AddDigest(table, key, digest);
+  }
+}
+
+bool IsPropertyAccessICKind(FeedbackSlotKind kind) {
+  return IsLoadICKind(kind) || IsKeyedLoadICKind(kind) ||
+         IsKeyedHasICKind(kind) || IsStoreICKind(kind) ||
+         IsStoreOwnICKind(kind) || IsDefineOwnICKind(kind) ||
+         IsKeyedStoreICKind(kind) || IsStoreInArrayLiteralICKind(kind);
+}
+
+}  // namespace
+
+// static
+uint64_t OptimizationHints::FunctionKey(SharedFunctionInfo shared) {
+  DisallowGarbageCollection no_gc;
+  if (!shared.script().IsScript()) return 0;
+  Object source = Script::cast(shared.script()).source();
+  if (!source.IsString()) return 0;
+  String::FlatContent content = String::cast(source).GetFlatContent(no_gc);
+  if (!content.IsFlat()) return 0;
+  const int start = shared.StartPosition();
+  const int end = shared.EndPosition();
+  if (start < 0 || end > content.length() || start >= end) return 0;
+  // base::hash_range is not seeded, so the key survives process restarts.
+  size_t hash;
+  if (content.IsOneByte()) {
+    const uint8_t* chars = content.ToOneByteVector().begin();
+    hash = base::hash_range(chars + start, chars + end);
+  } else {
+    const base::uc16* chars = content.ToUC16Vector().begin();
+    hash = base::hash_range(chars + start, chars + end);
+  }
+  uint64_t key = static_cast<uint64_t>(base::hash_combine(hash, end - start));
+  return key == 0 ? 1 : key;
+}
+
+// static
+uint32_t OptimizationHints::FeedbackDigest(FeedbackVector vector) {
+  DisallowGarbageCollection no_gc;
+  size_t digest = 0;
+  FeedbackMetadataIterator iter(vector.metadata());
+  while (iter.HasNext()) {
+    FeedbackSlot slot = iter.Next();
+    FeedbackSlotKind kind = iter.kind();
+    FeedbackNexus nexus(vector, slot);
+    InlineCacheState state = nexus.ic_state();
+    digest = base::hash_combine(digest, static_cast<int>(kind),
+                                static_cast<int>(state));
+    // Maps themselves differ between processes, but the properties that
+    // TurboFan specializes on most do not.
+    if (state == MONOMORPHIC && IsPropertyAccessICKind(kind)) {
+      Map map = nexus.GetFirstMap();
+      if (!map.is_null()) {
+        digest = base::hash_combine(digest,
+                                    static_cast<int>(map.instance_type()),
+                                    static_cast<int>(map.elements_kind()));
+      }
+    }
+  }
+  return static_cast<uint32_t>(digest);
+}
+
+// static
+void OptimizationHints::RecordOptimizedFunction(JSFunction function) {
+  DCHECK_NOT_NULL(FLAG_optimization_hints_file);
+  if (!function.has_feedback_vector()) return;
+  uint64_t key = FunctionKey(function.shared());
+  if (key == 0) return;
+  uint32_t digest = FeedbackDigest(function.feedback_vector());
+  HintTable* table = GetHintTable();
+  base::MutexGuard guard(&table->mutex);
+  EnsureLoaded(table);
+  if (AddDigest(table, key, digest)) table->dirty = true;
+}
+
+// static
+bool OptimizationHints::ShouldOptimizeEarly(JSFunction function,
+                                            uint64_t function_key) {
+  DCHECK_NOT_NULL(FLAG_optimization_hints_file);
+  if (!function.has_feedback_vector() || function_key == 0) return false;
+  HintTable* table = GetHintTable();
+  base::MutexGuard guard(&table->mutex);
+  EnsureLoaded(table);
+  auto it = table->digests.find(function_key);
+  if (it == table->digests.end()) return false;
+  uint32_t digest = FeedbackDigest(function.feedback_vector());
+  return std::find(it->second.begin(), it->second.end(), digest) !=
+         it->second.end();
+}
+
+// static
+bool OptimizationHints::ShouldOptimizeEarly(JSFunction function) {
+  return ShouldOptimizeEarly(function, FunctionKey(function.shared()));
+}
+
+// static
+void OptimizationHints::Flush() {
+  DCHECK_NOT_NULL(FLAG_optimization_hints_file);
+  HintTable* table = GetHintTable();
+  base::MutexGuard guard(&table->mutex);
+  if (!table->dirty) return;
+  // The table includes the hints loaded from the file, so it is rewritten as
+  // a whole.
+  std::ofstream file(FLAG_optimization_hints_file, std::ios_base::trunc);
+  if (!file.good()) return;
+  file << std::hex;
+  for (const auto& entry : table->digests) {
+    for (uint32_t digest : entry.second) {
+      file << entry.first << ',' << digest << '\n';
+    }
+  }
+  table->dirty = false;
+}
+
+// static
+void OptimizationHints::ResetForTesting() {
+  HintTable* table = GetHintTable();
+  base::MutexGuard guard(&table->mutex);
+  table->loaded = false;
+  table->dirty = false;
+  table->digests.clear();
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,58 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_CODEGEN_OPTIMIZATION_HINTS_H_
+#define V8_CODEGEN_OPTIMIZATION_HINTS_H_
+
+#include "src/common/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class FeedbackVector;
+class JSFunction;
+class SharedFunctionInfo;
+
+// Process-wide record of the functions that TurboFan optimized, persisted in
+// --optimization-hints-file across processes. A hint is keyed by a hash of
+// the function's source text, which unlike SharedFunctionInfo::Hash() does
+// not depend on script ids, and a digest of the shape of its feedback: the
+// IC state of every slot and the instance type and elements kind of
+// monomorphic receivers.
+//
+// When a function reaches the feedback shape it was optimized with in a
+// previous run, the RuntimeProfiler marks it for optimization right away
+// instead of waiting for enough profiler ticks. Only these hints are stored;
+// no code is reused. Optimized code embeds process-specific objects and
+// depends on maps of the current heap, so it is always regenerated and its
+// dependencies are installed as usual.
+class OptimizationHints final : public AllStatic {
+ public:
+  // Returns a key that is stable across processes for the same source text,
+  // or 0 if the function's source is not available.
+  static uint64_t FunctionKey(SharedFunctionInfo shared);
+  static uint32_t FeedbackDigest(FeedbackVector vector);
+
+  // Called on the main thread once TurboFan code was installed for
+  // |function|.
+  static void RecordOptimizedFunction(JSFunction function);
+
+  // Whether |function| was optimized with its current feedback shape in a
+  // previous run. |function_key| is FunctionKey() of its SharedFunctionInfo,
+  // which callers that check a function repeatedly should compute once.
+  static bool ShouldOptimizeEarly(JSFunction function, uint64_t function_key);
+  static bool ShouldOptimizeEarly(JSFunction function);
+
+  // Writes new hints to --optimization-hints-file. Called on isolate
+  // teardown.
+  static void Flush();
+
+  // Drops all hints, so that the next lookup loads the file again.
+  V8_EXPORT_PRIVATE static void ResetForTesting();
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_CODEGEN_OPTIMIZATION_HINTS_H_
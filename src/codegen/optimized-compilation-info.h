@@ -233,6 +233,11 @@ class V8_EXPORT_PRIVATE OptimizedCompilationInfo final {
     profiler_data_ = profiler_data;
   }
 
+  // Source-based key of the function for profile-guided optimization, see
+  // --turbo-profiling-log-js. 0 if not used.
+  uint64_t profile_key() const { return profile_key_; }
+  void set_profile_key(uint64_t profile_key) { profile_key_ = profile_key; }
+
   std::unique_ptr<PersistentHandles> DetachPersistentHandles() {
     DCHECK_NOT_NULL(ph_);
     return std::move(ph_);
@@ -268,6 +273,7 @@ class V8_EXPORT_PRIVATE OptimizedCompilationInfo final {
 
   // Basic block profiling support.
   BasicBlockProfilerData* profiler_data_ = nullptr;
+  uint64_t profile_key_ = 0;
 
 #if V8_ENABLE_WEBASSEMBLY
   // The WebAssembly compilation result, not published in the NativeModule yet.
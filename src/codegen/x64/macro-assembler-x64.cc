@@ -23,6 +23,7 @@
 #include "src/deoptimizer/deoptimizer.h"
 #include "src/execution/frames-inl.h"
 #include "src/heap/memory-chunk.h"
+#include "src/heap/third-party/heap-api.h"
 #include "src/init/bootstrapper.h"
 #include "src/logging/counters.h"
 #include "src/objects/objects-inl.h"
@@ -590,6 +591,20 @@ void MacroAssembler::RecordWrite(Register object, Register slot_address,
   DCHECK(!AreAliased(object, slot_address, value));
   AssertNotSmi(object);
 
+  if (V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL &&
+      remembered_set_action == RememberedSetAction::kEmit) {
+    // Unconditionally mark the card of the slot. Both slot_address and value
+    // are clobbered.
+    LoadAddress(value,
+                ExternalReference::third_party_heap_card_table_base_address(
+                    isolate()));
+    movq(value, Operand(value, 0));
+    shrq(slot_address, Immediate(third_party_heap::Heap::kCardSizeLog2));
+    movb(Operand(value, slot_address, times_1, 0),
+         Immediate(third_party_heap::Heap::kDirtyCard));
+    return;
+  }
+
   if ((remembered_set_action == RememberedSetAction::kOmit &&
        !FLAG_incremental_marking) ||
       FLAG_disable_write_barriers) {
@@ -6,6 +6,7 @@
 
 #include "src/base/atomicops.h"
 #include "src/codegen/compiler.h"
+#include "src/codegen/optimization-hints.h"
 #include "src/codegen/optimized-compilation-info.h"
 #include "src/execution/isolate.h"
 #include "src/execution/local-isolate.h"
@@ -15,6 +16,7 @@
 #include "src/logging/counters.h"
 #include "src/logging/log.h"
 #include "src/logging/runtime-call-stats-scope.h"
+#include "src/objects/js-function-inl.h"
 #include "src/objects/objects-inl.h"
 #include "src/tasks/cancelable-task.h"
 #include "src/tracing/trace-event.h"
@@ -36,6 +38,13 @@ void DisposeCompilationJob(OptimizedCompilationJob* job,
   delete job;
 }
 
+void TraceDisposedJob(OptimizedCompilationJob* job, const char* reason) {
+  if (!FLAG_trace_concurrent_recompilation) return;
+  PrintF("  ** Dropping queued job for ");
+  job->compilation_info()->closure()->ShortPrint();
+  PrintF(" as %s.\n", reason);
+}
+
 }  // namespace
 
 class OptimizingCompileDispatcher::CompileTask : public CancelableTask {
@@ -99,18 +108,39 @@ class OptimizingCompileDispatcher::CompileTask : public CancelableTask {
 
 OptimizingCompileDispatcher::~OptimizingCompileDispatcher() {
   DCHECK_EQ(0, ref_count_);
-  DCHECK_EQ(0, input_queue_length_);
-  DeleteArray(input_queue_);
+  DCHECK(input_queue_.empty());
+}
+
+OptimizingCompileDispatcher::InputQueue::iterator
+OptimizingCompileDispatcher::HighestPriorityInput() {
+  DCHECK(!input_queue_.empty());
+  auto highest = input_queue_.begin();
+  for (auto it = highest + 1; it != input_queue_.end(); ++it) {
+    if (it->priority > highest->priority) highest = it;
+  }
+  return highest;
+}
+
+OptimizingCompileDispatcher::InputQueue::iterator
+OptimizingCompileDispatcher::LowestPriorityInput() {
+  DCHECK(!input_queue_.empty());
+  auto lowest = input_queue_.begin();
+  for (auto it = lowest + 1; it != input_queue_.end(); ++it) {
+    if (it->priority <= lowest->priority) lowest = it;
+  }
+  return lowest;
 }
 
 OptimizedCompilationJob* OptimizingCompileDispatcher::NextInput(
     LocalIsolate* local_isolate) {
   base::MutexGuard access_input_queue_(&input_queue_mutex_);
-  if (input_queue_length_ == 0) return nullptr;
-  OptimizedCompilationJob* job = input_queue_[InputQueueIndex(0)];
+  if (input_queue_.empty()) return nullptr;
+  auto next = HighestPriorityInput();
+  OptimizedCompilationJob* job = next->job;
   DCHECK_NOT_NULL(job);
-  input_queue_shift_ = InputQueueIndex(1);
-  input_queue_length_--;
+  isolate_->counters()->turbofan_optimize_queue_latency()->AddTimedSample(
+      base::TimeTicks::Now() - next->queued_at);
+  input_queue_.erase(next);
   return job;
 }
 
@@ -150,11 +180,35 @@ void OptimizingCompileDispatcher::FlushOutputQueue(bool restore_function_code) {
 
 void OptimizingCompileDispatcher::FlushInputQueue() {
   base::MutexGuard access_input_queue_(&input_queue_mutex_);
-  while (input_queue_length_ > 0) {
-    OptimizedCompilationJob* job = input_queue_[InputQueueIndex(0)];
-    DCHECK_NOT_NULL(job);
-    input_queue_shift_ = InputQueueIndex(1);
-    input_queue_length_--;
+  for (const InputQueueEntry& entry : input_queue_) {
+    DCHECK_NOT_NULL(entry.job);
+    DisposeCompilationJob(entry.job, true);
+  }
+  input_queue_.clear();
+}
+
+void OptimizingCompileDispatcher::CancelStaleJobs() {
+  DCHECK_EQ(ThreadId::Current(), isolate_->thread_id());
+  if (FLAG_concurrent_inlining) return;
+  std::vector<OptimizedCompilationJob*> stale_jobs;
+  {
+    base::MutexGuard access_input_queue(&input_queue_mutex_);
+    auto it = input_queue_.begin();
+    while (it != input_queue_.end()) {
+      JSFunction function = *it->job->compilation_info()->closure();
+      if (function.has_feedback_vector() &&
+          OptimizationHints::FeedbackDigest(function.feedback_vector()) !=
+              it->feedback_digest) {
+        stale_jobs.push_back(it->job);
+        it = input_queue_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (OptimizedCompilationJob* job : stale_jobs) {
+    TraceDisposedJob(job, "its feedback changed");
+    isolate_->counters()->concurrent_recompilation_stale_jobs()->Increment();
     DisposeCompilationJob(job, true);
   }
 }
@@ -167,7 +221,7 @@ void OptimizingCompileDispatcher::AwaitCompileTasks() {
 
 #ifdef DEBUG
   base::MutexGuard access_input_queue(&input_queue_mutex_);
-  CHECK_EQ(input_queue_length_, 0);
+  CHECK(input_queue_.empty());
 #endif  // DEBUG
 }
 
@@ -195,8 +249,8 @@ void OptimizingCompileDispatcher::Stop() {
   HandleScope handle_scope(isolate_);
   FlushQueues(BlockingBehavior::kBlock, false);
   // At this point the optimizing compiler thread's event loop has stopped.
-  // There is no need for a mutex when reading input_queue_length_.
-  DCHECK_EQ(input_queue_length_, 0);
+  // There is no need for a mutex when reading input_queue_.
+  DCHECK(input_queue_.empty());
 }
 
 void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
@@ -233,15 +287,66 @@ bool OptimizingCompileDispatcher::HasJobs() {
   return ref_count_ != 0 || !output_queue_.empty();
 }
 
+bool OptimizingCompileDispatcher::IsQueueAvailable(Priority priority) {
+  base::MutexGuard access_input_queue(&input_queue_mutex_);
+  if (input_queue_.size() < input_queue_capacity_) return true;
+  return LowestPriorityInput()->priority < priority;
+}
+
+void OptimizingCompileDispatcher::Prioritize(JSFunction function) {
+  DCHECK_EQ(ThreadId::Current(), isolate_->thread_id());
+  base::MutexGuard access_input_queue(&input_queue_mutex_);
+  for (InputQueueEntry& entry : input_queue_) {
+    if (*entry.job->compilation_info()->closure() == function) {
+      entry.priority |= kPrioritizedBit;
+    }
+  }
+}
+
+// static
+OptimizingCompileDispatcher::Priority OptimizingCompileDispatcher::PriorityFor(
+    JSFunction function, int profiler_ticks) {
+  DCHECK_GE(profiler_ticks, 0);
+  uint32_t invocation_count = 0;
+  if (function.has_feedback_vector()) {
+    invocation_count = static_cast<uint32_t>(
+        function.feedback_vector().invocation_count(kRelaxedLoad));
+  }
+  // Profiler ticks are a Smi, which leaves kPrioritizedBit unused.
+  Priority priority = (static_cast<Priority>(profiler_ticks) << 32) |
+                      static_cast<Priority>(invocation_count);
+  DCHECK_EQ(0, priority & kPrioritizedBit);
+  return priority;
+}
+
 void OptimizingCompileDispatcher::QueueForOptimization(
-    OptimizedCompilationJob* job) {
-  DCHECK(IsQueueAvailable());
+    OptimizedCompilationJob* job, Priority priority) {
+  DCHECK_EQ(ThreadId::Current(), isolate_->thread_id());
+  JSFunction function = *job->compilation_info()->closure();
+  uint32_t feedback_digest =
+      function.has_feedback_vector()
+          ? OptimizationHints::FeedbackDigest(function.feedback_vector())
+          : 0;
+  OptimizedCompilationJob* evicted_job = nullptr;
   {
-    // Add job to the back of the input queue.
     base::MutexGuard access_input_queue(&input_queue_mutex_);
-    DCHECK_LT(input_queue_length_, input_queue_capacity_);
-    input_queue_[InputQueueIndex(input_queue_length_)] = job;
-    input_queue_length_++;
+    if (input_queue_.size() == input_queue_capacity_) {
+      // Background threads only ever remove jobs, so the job found by
+      // IsQueueAvailable(priority) may have been taken, but a job with
+      // lower priority than |priority| still exists if the queue is full.
+      auto lowest = LowestPriorityInput();
+      DCHECK_LT(lowest->priority, priority);
+      evicted_job = lowest->job;
+      input_queue_.erase(lowest);
+    }
+    DCHECK_LT(input_queue_.size(), input_queue_capacity_);
+    input_queue_.push_back(
+        {job, priority, feedback_digest, base::TimeTicks::Now()});
+  }
+  if (evicted_job != nullptr) {
+    TraceDisposedJob(evicted_job, "a hotter function was queued");
+    isolate_->counters()->concurrent_recompilation_dropped_jobs()->Increment();
+    DisposeCompilationJob(evicted_job, true);
   }
   V8::GetCurrentPlatform()->CallOnWorkerThread(
       std::make_unique<CompileTask>(isolate_, this));
@@ -7,17 +7,21 @@
 
 #include <atomic>
 #include <queue>
+#include <vector>
 
 #include "src/base/platform/condition-variable.h"
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
+#include "src/base/platform/time.h"
 #include "src/common/globals.h"
 #include "src/flags/flags.h"
 #include "src/utils/allocation.h"
+#include "testing/gtest/include/gtest/gtest_prod.h"  // nogncheck
 
 namespace v8 {
 namespace internal {
 
+class JSFunction;
 class LocalHeap;
 class OptimizedCompilationJob;
 class RuntimeCallStats;
@@ -25,30 +29,59 @@ class SharedFunctionInfo;
 
 class V8_EXPORT_PRIVATE OptimizingCompileDispatcher {
  public:
+  // Queued jobs are compiled in order of decreasing priority, and in the order
+  // they were queued for equal priorities. See PriorityFor().
+  using Priority = uint64_t;
+
   explicit OptimizingCompileDispatcher(Isolate* isolate)
       : isolate_(isolate),
-        input_queue_capacity_(FLAG_concurrent_recompilation_queue_length),
-        input_queue_length_(0),
-        input_queue_shift_(0),
+        input_queue_capacity_(static_cast<size_t>(
+            FLAG_concurrent_recompilation_queue_length)),
         ref_count_(0),
         recompilation_delay_(FLAG_concurrent_recompilation_delay) {
-    input_queue_ = NewArray<OptimizedCompilationJob*>(input_queue_capacity_);
+    input_queue_.reserve(input_queue_capacity_);
   }
 
   ~OptimizingCompileDispatcher();
 
   void Stop();
   void Flush(BlockingBehavior blocking_behavior);
-  // Takes ownership of |job|.
-  void QueueForOptimization(OptimizedCompilationJob* job);
+  // Takes ownership of |job|. If the queue is full, the job with the lowest
+  // priority is evicted, which must be lower than |priority|.
+  void QueueForOptimization(OptimizedCompilationJob* job,
+                            Priority priority = 0);
   void AwaitCompileTasks();
   void InstallOptimizedFunctions();
 
   inline bool IsQueueAvailable() {
     base::MutexGuard access_input_queue(&input_queue_mutex_);
-    return input_queue_length_ < input_queue_capacity_;
+    return input_queue_.size() < input_queue_capacity_;
   }
 
+  // Whether a job with |priority| can be queued, either into a free slot or
+  // in place of a job with a lower priority.
+  bool IsQueueAvailable(Priority priority);
+
+  // Without --concurrent-inlining, the inlining decisions of a queued job are
+  // based on the feedback at the time it was prepared. Cancels queued jobs of
+  // functions whose feedback changed since, so that they are retried with the
+  // new feedback. With --concurrent-inlining, the job reads the feedback on
+  // the background thread and nothing is cancelled. This method must be
+  // called on the main thread.
+  void CancelStaleJobs();
+
+  // Moves the queued job of |function|, if any, ahead of all jobs that were
+  // not prioritized. Called for functions that keep running in unoptimized
+  // frames while they wait, e.g. in long-running loops, which would request
+  // on-stack replacement otherwise. This method must be called on the main
+  // thread.
+  void Prioritize(JSFunction function);
+
+  // Returns the priority of a job for |function|, which had |profiler_ticks|
+  // when it was marked for optimization. Profiler ticks measure the time
+  // spent in the function; the invocation count breaks ties.
+  static Priority PriorityFor(JSFunction function, int profiler_ticks);
+
   static bool Enabled() { return FLAG_concurrent_recompilation; }
 
   // This method must be called on the main thread.
@@ -68,6 +101,19 @@ class V8_EXPORT_PRIVATE OptimizingCompileDispatcher {
 
   enum ModeFlag { COMPILE, FLUSH };
 
+  // Set in the priority of jobs passed to Prioritize().
+  static constexpr Priority kPrioritizedBit = Priority{1} << 63;
+
+  struct InputQueueEntry {
+    OptimizedCompilationJob* job;
+    Priority priority;
+    // Digest of the function's feedback when the job was queued, see
+    // OptimizationHints::FeedbackDigest().
+    uint32_t feedback_digest;
+    base::TimeTicks queued_at;
+  };
+  using InputQueue = std::vector<InputQueueEntry>;
+
   void FlushQueues(BlockingBehavior blocking_behavior,
                    bool restore_function_code);
   void FlushInputQueue();
@@ -75,20 +121,18 @@ class V8_EXPORT_PRIVATE OptimizingCompileDispatcher {
   void CompileNext(OptimizedCompilationJob* job, LocalIsolate* local_isolate);
   OptimizedCompilationJob* NextInput(LocalIsolate* local_isolate);
 
-  inline int InputQueueIndex(int i) {
-    int result = (i + input_queue_shift_) % input_queue_capacity_;
-    DCHECK_LE(0, result);
-    DCHECK_LT(result, input_queue_capacity_);
-    return result;
-  }
+  // Both must be called with |input_queue_mutex_| held on a non-empty queue.
+  // The highest priority job is the earliest queued one among equals, the
+  // lowest priority job the latest queued one.
+  InputQueue::iterator HighestPriorityInput();
+  InputQueue::iterator LowestPriorityInput();
 
   Isolate* isolate_;
 
-  // Circular queue of incoming recompilation tasks (including OSR).
-  OptimizedCompilationJob** input_queue_;
-  int input_queue_capacity_;
-  int input_queue_length_;
-  int input_queue_shift_;
+  // Incoming recompilation jobs (including OSR). The queue is short, so jobs
+  // are kept in the order they were queued and the next one is looked up.
+  InputQueue input_queue_;
+  size_t input_queue_capacity_;
   base::Mutex input_queue_mutex_;
 
   // Queue of recompilation tasks ready to be installed (excluding OSR).
@@ -109,6 +153,13 @@ class V8_EXPORT_PRIVATE OptimizingCompileDispatcher {
   int recompilation_delay_;
 
   bool finalize_ = true;
+
+  FRIEND_TEST(OptimizingCompileDispatcherTest, HighestPriorityFirst);
+  FRIEND_TEST(OptimizingCompileDispatcherTest, EvictLowestPriority);
+  FRIEND_TEST(OptimizingCompileDispatcherTest, CancelStaleJobs);
+  FRIEND_TEST(OptimizingCompileDispatcherTest,
+              KeepChangedJobsWithConcurrentInlining);
+  FRIEND_TEST(OptimizingCompileDispatcherTest, Prioritize);
 };
 }  // namespace internal
 }  // namespace v8
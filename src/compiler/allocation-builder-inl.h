@@ -26,12 +26,13 @@ void AllocationBuilder::Allocate(int size, AllocationType allocation,
   effect_ = allocation_;
 }
 
-void AllocationBuilder::AllocateContext(int variadic_part_length, MapRef map) {
+void AllocationBuilder::AllocateContext(int variadic_part_length, MapRef map,
+                                        AllocationType allocation) {
   DCHECK(base::IsInRange(map.instance_type(), FIRST_CONTEXT_TYPE,
                          LAST_CONTEXT_TYPE));
   DCHECK_NE(NATIVE_CONTEXT_TYPE, map.instance_type());
   int size = Context::SizeFor(variadic_part_length);
-  Allocate(size, AllocationType::kYoung, Type::OtherInternal());
+  Allocate(size, allocation, Type::OtherInternal());
   Store(AccessBuilder::ForMap(), map);
   STATIC_ASSERT(static_cast<int>(Context::kLengthOffset) ==
                 static_cast<int>(FixedArray::kLengthOffset));
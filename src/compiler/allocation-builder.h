@@ -42,7 +42,9 @@ class AllocationBuilder final {
   }
 
   // Compound allocation of a context.
-  inline void AllocateContext(int variadic_part_length, MapRef map);
+  inline void AllocateContext(
+      int variadic_part_length, MapRef map,
+      AllocationType allocation = AllocationType::kYoung);
 
   // Compound allocation of a FixedArray.
   inline bool CanAllocateArray(
@@ -385,6 +385,10 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
   return 1;
 }
 
+int InstructionScheduler::GetInstructionOccupancy(const Instruction* instr) {
+  return 0;
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
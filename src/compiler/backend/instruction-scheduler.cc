@@ -4,9 +4,12 @@
 
 #include "src/compiler/backend/instruction-scheduler.h"
 
+#include <algorithm>
+
 #include "src/base/iterator.h"
 #include "src/base/optional.h"
 #include "src/base/utils/random-number-generator.h"
+#include "src/codegen/register-configuration.h"
 
 namespace v8 {
 namespace internal {
@@ -29,11 +32,19 @@ InstructionScheduler::CriticalPathFirstQueue::PopBestCandidate(int cycle) {
   DCHECK(!IsEmpty());
   auto candidate = nodes_.end();
   for (auto iterator = nodes_.begin(); iterator != nodes_.end(); ++iterator) {
-    // We only consider instructions that have all their operands ready.
-    if (cycle >= (*iterator)->start_cycle()) {
+    // We only consider instructions that have all their operands ready and
+    // whose execution unit is available.
+    if (cycle < (*iterator)->start_cycle() ||
+        !scheduler_->IsExecutionUnitAvailable(*iterator, cycle)) {
+      continue;
+    }
+    // Fall back to the instruction on the critical path if all ready
+    // instructions need a new register.
+    if (!scheduler_->IncreasesRegisterPressure(*iterator)) {
       candidate = iterator;
       break;
     }
+    if (candidate == nodes_.end()) candidate = iterator;
   }
 
   if (candidate != nodes_.end()) {
@@ -61,8 +72,12 @@ InstructionScheduler::ScheduleGraphNode::ScheduleGraphNode(Zone* zone,
                                                            Instruction* instr)
     : instr_(instr),
       successors_(zone),
+      operand_predecessors_(zone),
       unscheduled_predecessors_count_(0),
+      unscheduled_uses_count_(0),
+      defines_fp_value_(false),
       latency_(GetInstructionLatency(instr)),
+      occupancy_(GetInstructionOccupancy(instr)),
       total_latency_(-1),
       start_cycle_(-1) {}
 
@@ -72,6 +87,16 @@ void InstructionScheduler::ScheduleGraphNode::AddSuccessor(
   node->unscheduled_predecessors_count_++;
 }
 
+void InstructionScheduler::ScheduleGraphNode::AddOperandPredecessor(
+    ScheduleGraphNode* node) {
+  if (std::find(operand_predecessors_.begin(), operand_predecessors_.end(),
+                node) != operand_predecessors_.end()) {
+    return;
+  }
+  operand_predecessors_.push_back(node);
+  node->unscheduled_uses_count_++;
+}
+
 InstructionScheduler::InstructionScheduler(Zone* zone,
                                            InstructionSequence* sequence)
     : zone_(zone),
@@ -81,7 +106,13 @@ InstructionScheduler::InstructionScheduler(Zone* zone,
       pending_loads_(zone),
       last_live_in_reg_marker_(nullptr),
       last_deopt_or_trap_(nullptr),
-      operands_map_(zone) {
+      operands_map_(zone),
+      live_values_count_{0, 0},
+      execution_unit_available_cycle_(0),
+      schedule_current_block_(true) {
+  const RegisterConfiguration* config = RegisterConfiguration::Default();
+  allocatable_registers_count_[0] = config->num_allocatable_general_registers();
+  allocatable_registers_count_[1] = config->num_allocatable_double_registers();
   if (FLAG_turbo_stress_instruction_scheduling) {
     random_number_generator_ =
         base::Optional<base::RandomNumberGenerator>(FLAG_random_seed);
@@ -95,11 +126,19 @@ void InstructionScheduler::StartBlock(RpoNumber rpo) {
   DCHECK_NULL(last_live_in_reg_marker_);
   DCHECK_NULL(last_deopt_or_trap_);
   DCHECK(operands_map_.empty());
+  if (FLAG_turbo_instruction_scheduling_loops_only) {
+    // Scheduling pays off in loops, while it costs compile time everywhere.
+    const InstructionBlock* block = sequence()->InstructionBlockAt(rpo);
+    schedule_current_block_ =
+        block->IsLoopHeader() || block->loop_header().IsValid();
+  }
   sequence()->StartBlock(rpo);
 }
 
 void InstructionScheduler::EndBlock(RpoNumber rpo) {
-  if (FLAG_turbo_stress_instruction_scheduling) {
+  if (!schedule_current_block_) {
+    DCHECK(graph_.empty());
+  } else if (FLAG_turbo_stress_instruction_scheduling) {
     Schedule<StressSchedulerQueue>();
   } else {
     Schedule<CriticalPathFirstQueue>();
@@ -108,16 +147,36 @@ void InstructionScheduler::EndBlock(RpoNumber rpo) {
 }
 
 void InstructionScheduler::AddTerminator(Instruction* instr) {
+  if (!schedule_current_block_) {
+    sequence()->AddInstruction(instr);
+    return;
+  }
   ScheduleGraphNode* new_node = zone()->New<ScheduleGraphNode>(zone(), instr);
   // Make sure that basic block terminators are not moved by adding them
   // as successor of every instruction.
   for (ScheduleGraphNode* node : graph_) {
     node->AddSuccessor(new_node);
   }
+  // Values used by the terminator stay live until the end of the block.
+  for (size_t i = 0; i < instr->InputCount(); ++i) {
+    const InstructionOperand* input = instr->InputAt(i);
+    if (input->IsUnallocated()) {
+      auto it = operands_map_.find(
+          UnallocatedOperand::cast(input)->virtual_register());
+      if (it != operands_map_.end()) {
+        new_node->AddOperandPredecessor(it->second);
+      }
+    }
+  }
   graph_.push_back(new_node);
 }
 
 void InstructionScheduler::AddInstruction(Instruction* instr) {
+  if (!schedule_current_block_) {
+    sequence()->AddInstruction(instr);
+    return;
+  }
+
   if (IsBarrier(instr)) {
     if (FLAG_turbo_stress_instruction_scheduling) {
       Schedule<StressSchedulerQueue>();
@@ -188,6 +247,7 @@ void InstructionScheduler::AddInstruction(Instruction* instr) {
         auto it = operands_map_.find(vreg);
         if (it != operands_map_.end()) {
           it->second->AddSuccessor(new_node);
+          new_node->AddOperandPredecessor(it->second);
         }
       }
     }
@@ -196,8 +256,9 @@ void InstructionScheduler::AddInstruction(Instruction* instr) {
     for (size_t i = 0; i < instr->OutputCount(); ++i) {
       const InstructionOperand* output = instr->OutputAt(i);
       if (output->IsUnallocated()) {
-        operands_map_[UnallocatedOperand::cast(output)->virtual_register()] =
-            new_node;
+        int32_t vreg = UnallocatedOperand::cast(output)->virtual_register();
+        operands_map_[vreg] = new_node;
+        if (sequence()->IsFP(vreg)) new_node->set_defines_fp_value();
       } else if (output->IsConstant()) {
         operands_map_[ConstantOperand::cast(output)->virtual_register()] =
             new_node;
@@ -229,6 +290,10 @@ void InstructionScheduler::Schedule() {
 
     if (candidate != nullptr) {
       sequence()->AddInstruction(candidate->instruction());
+      UpdateRegisterPressure(candidate);
+      if (candidate->occupancy() > 0) {
+        execution_unit_available_cycle_ = cycle + candidate->occupancy();
+      }
 
       for (ScheduleGraphNode* successor : candidate->successors()) {
         successor->DropUnscheduledPredecessor();
@@ -251,6 +316,36 @@ void InstructionScheduler::Schedule() {
   last_deopt_or_trap_ = nullptr;
   last_live_in_reg_marker_ = nullptr;
   last_side_effect_instr_ = nullptr;
+  live_values_count_[0] = live_values_count_[1] = 0;
+  execution_unit_available_cycle_ = 0;
+}
+
+bool InstructionScheduler::IncreasesRegisterPressure(
+    ScheduleGraphNode* node) const {
+  if (!node->HasUnscheduledUses()) return false;
+  const bool fp = node->defines_fp_value();
+  if (live_values_count_[fp] < allocatable_registers_count_[fp]) return false;
+  // The register of an input can be reused if this is its last use.
+  for (ScheduleGraphNode* input : node->operand_predecessors()) {
+    if (input->defines_fp_value() == fp &&
+        input->unscheduled_uses_count() == 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void InstructionScheduler::UpdateRegisterPressure(ScheduleGraphNode* node) {
+  for (ScheduleGraphNode* input : node->operand_predecessors()) {
+    input->DropUnscheduledUse();
+    if (!input->HasUnscheduledUses()) {
+      live_values_count_[input->defines_fp_value()]--;
+      DCHECK_LE(0, live_values_count_[input->defines_fp_value()]);
+    }
+  }
+  if (node->HasUnscheduledUses()) {
+    live_values_count_[node->defines_fp_value()]++;
+  }
 }
 
 int InstructionScheduler::GetInstructionFlags(const Instruction* instr) const {
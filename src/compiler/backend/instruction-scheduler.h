@@ -70,6 +70,29 @@ class InstructionScheduler final : public ZoneObject {
     Instruction* instruction() { return instr_; }
     ZoneDeque<ScheduleGraphNode*>& successors() { return successors_; }
     int latency() const { return latency_; }
+    int occupancy() const { return occupancy_; }
+
+    // Record that 'node' defines one of the inputs of this instruction. Each
+    // node is recorded once, even if it defines several of the inputs.
+    void AddOperandPredecessor(ScheduleGraphNode* node);
+    ZoneDeque<ScheduleGraphNode*>& operand_predecessors() {
+      return operand_predecessors_;
+    }
+
+    // Check if some instructions using the values defined by this one have not
+    // been scheduled yet, i.e. whether the values are live.
+    bool HasUnscheduledUses() const { return unscheduled_uses_count_ != 0; }
+    int unscheduled_uses_count() const { return unscheduled_uses_count_; }
+
+    // Record that we have scheduled one of the instructions using the values
+    // defined by this node.
+    void DropUnscheduledUse() {
+      DCHECK_LT(0, unscheduled_uses_count_);
+      unscheduled_uses_count_--;
+    }
+
+    bool defines_fp_value() const { return defines_fp_value_; }
+    void set_defines_fp_value() { defines_fp_value_ = true; }
 
     int total_latency() const { return total_latency_; }
     void set_total_latency(int latency) { total_latency_ = latency; }
@@ -80,14 +103,26 @@ class InstructionScheduler final : public ZoneObject {
    private:
     Instruction* instr_;
     ZoneDeque<ScheduleGraphNode*> successors_;
+    ZoneDeque<ScheduleGraphNode*> operand_predecessors_;
 
     // Number of unscheduled predecessors for this node.
     int unscheduled_predecessors_count_;
 
+    // Number of unscheduled nodes which have this node as operand predecessor.
+    int unscheduled_uses_count_;
+
+    // Whether the values defined by this node live in floating-point
+    // registers.
+    bool defines_fp_value_;
+
     // Estimate of the instruction latency (the number of cycles it takes for
     // instruction to complete).
     int latency_;
 
+    // Number of cycles during which the instruction keeps an execution unit
+    // that is not pipelined (e.g. a divider) busy.
+    int occupancy_;
+
     // The sum of all the latencies on the path from this node to the end of
     // the graph (i.e. a node with no successor).
     int total_latency_;
@@ -119,7 +154,9 @@ class InstructionScheduler final : public ZoneObject {
 
   // A scheduling queue which prioritize nodes on the critical path (we look
   // for the instruction with the highest latency on the path to reach the end
-  // of the graph).
+  // of the graph). When all allocatable registers hold live values, nodes
+  // which don't need a new register are preferred, so that the critical path
+  // is not followed at the cost of spilling.
   class CriticalPathFirstQueue : public SchedulingQueueBase {
    public:
     explicit CriticalPathFirstQueue(InstructionScheduler* scheduler)
@@ -207,6 +244,22 @@ class InstructionScheduler final : public ZoneObject {
   void ComputeTotalLatencies();
 
   static int GetInstructionLatency(const Instruction* instr);
+  // Number of cycles for which 'instr' blocks an execution unit that is not
+  // pipelined. Architectures that do not model such units return 0.
+  static int GetInstructionOccupancy(const Instruction* instr);
+
+  // Check whether 'node' can start at 'cycle' without waiting for an
+  // execution unit that is not pipelined.
+  bool IsExecutionUnitAvailable(ScheduleGraphNode* node, int cycle) const {
+    return node->occupancy() == 0 || cycle >= execution_unit_available_cycle_;
+  }
+
+  // Check whether scheduling 'node' would need one more register of a kind
+  // for which all allocatable registers already hold live values.
+  bool IncreasesRegisterPressure(ScheduleGraphNode* node) const;
+
+  // Update the number of live values once 'node' is scheduled.
+  void UpdateRegisterPressure(ScheduleGraphNode* node);
 
   Zone* zone() { return zone_; }
   InstructionSequence* sequence() { return sequence_; }
@@ -243,6 +296,20 @@ class InstructionScheduler final : public ZoneObject {
   // record operand dependencies in the scheduling graph.
   ZoneMap<int32_t, ScheduleGraphNode*> operands_map_;
 
+  // Number of values defined in the current scheduling region which have
+  // unscheduled uses, and the number of allocatable registers, for general
+  // and floating-point registers respectively.
+  int live_values_count_[2];
+  int allocatable_registers_count_[2];
+
+  // The cycle at which the execution units that are not pipelined can start
+  // a new instruction.
+  int execution_unit_available_cycle_;
+
+  // Whether the current block is scheduled, see
+  // --turbo-instruction-scheduling-loops-only.
+  bool schedule_current_block_;
+
   base::Optional<base::RandomNumberGenerator> random_number_generator_;
 };
 
@@ -21,6 +21,10 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
   UNREACHABLE();
 }
 
+int InstructionScheduler::GetInstructionOccupancy(const Instruction* instr) {
+  UNREACHABLE();
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -1750,6 +1750,10 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
   }
 }
 
+int InstructionScheduler::GetInstructionOccupancy(const Instruction* instr) {
+  return 0;
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
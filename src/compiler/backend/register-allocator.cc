@@ -1316,8 +1316,6 @@ TopTierRegisterAllocationData::TopTierRegisterAllocationData(
       assigned_double_registers_(nullptr),
       virtual_register_count_(code->VirtualRegisterCount()),
       preassigned_slot_ranges_(zone),
-      spill_state_(code->InstructionBlockCount(), ZoneVector<LiveRange*>(zone),
-                   zone),
       flags_(flags),
       tick_counter_(tick_counter),
       slot_for_const_range_(zone) {
@@ -1456,13 +1454,13 @@ bool TopTierRegisterAllocationData::RangesDefinedInDeferredStayInDeferred() {
 }
 
 SpillRange* TopTierRegisterAllocationData::AssignSpillRangeToLiveRange(
-    TopLevelLiveRange* range, SpillMode spill_mode) {
+    TopLevelLiveRange* range, SpillMode spill_mode, Zone* zone) {
   using SpillType = TopLevelLiveRange::SpillType;
   DCHECK(!range->HasSpillOperand());
 
   SpillRange* spill_range = range->GetAllocatedSpillRange();
   if (spill_range == nullptr) {
-    spill_range = allocation_zone()->New<SpillRange>(range, allocation_zone());
+    spill_range = zone->New<SpillRange>(range, zone);
   }
   if (spill_mode == SpillMode::kSpillDeferred &&
       (range->spill_type() != SpillType::kSpillRange)) {
@@ -2456,7 +2454,8 @@ void LiveRangeBuilder::BuildLiveRanges() {
                   TopLevelLiveRange::SlotUseKind::kDeferredSlotUse
               ? SpillMode::kSpillDeferred
               : SpillMode::kSpillAtDefinition;
-      data()->AssignSpillRangeToLiveRange(range, spill_mode);
+      data()->AssignSpillRangeToLiveRange(range, spill_mode,
+                                          allocation_zone());
     }
     // TODO(bmeurer): This is a horrible hack to make sure that for constant
     // live ranges, every use requires the constant to be in a register.
@@ -2485,7 +2484,8 @@ void LiveRangeBuilder::BuildLiveRanges() {
     SpillRange* spill = range->HasSpillRange()
                             ? range->GetSpillRange()
                             : data()->AssignSpillRangeToLiveRange(
-                                  range, SpillMode::kSpillAtDefinition);
+                                  range, SpillMode::kSpillAtDefinition,
+                                  allocation_zone());
     spill->set_assigned_slot(slot_id);
   }
 #ifdef DEBUG
@@ -2715,8 +2715,11 @@ void LiveRangeBundle::MergeSpillRangesAndClear() {
 }
 
 RegisterAllocator::RegisterAllocator(TopTierRegisterAllocationData* data,
-                                     RegisterKind kind)
+                                     RegisterKind kind, Zone* allocation_zone,
+                                     TickCounter* tick_counter)
     : data_(data),
+      allocation_zone_(allocation_zone),
+      tick_counter_(tick_counter),
       mode_(kind),
       num_registers_(GetRegisterCount(data->config(), kind)),
       num_allocatable_registers_(
@@ -2916,7 +2919,7 @@ void RegisterAllocator::Spill(LiveRange* range, SpillMode spill_mode) {
   TRACE("Starting spill type is %d\n", static_cast<int>(first->spill_type()));
   if (first->HasNoSpillType()) {
     TRACE("New spill range needed");
-    data()->AssignSpillRangeToLiveRange(first, spill_mode);
+    data()->AssignSpillRangeToLiveRange(first, spill_mode, allocation_zone());
   }
   // Upgrade the spillmode, in case this was only spilled in deferred code so
   // far.
@@ -2939,11 +2942,20 @@ const char* RegisterAllocator::RegisterName(int register_code) const {
 
 LinearScanAllocator::LinearScanAllocator(TopTierRegisterAllocationData* data,
                                          RegisterKind kind, Zone* local_zone)
-    : RegisterAllocator(data, kind),
+    : LinearScanAllocator(data, kind, local_zone, data->allocation_zone(),
+                          data->tick_counter()) {}
+
+LinearScanAllocator::LinearScanAllocator(TopTierRegisterAllocationData* data,
+                                         RegisterKind kind, Zone* local_zone,
+                                         Zone* allocation_zone,
+                                         TickCounter* tick_counter)
+    : RegisterAllocator(data, kind, allocation_zone, tick_counter),
       unhandled_live_ranges_(local_zone),
       active_live_ranges_(local_zone),
       inactive_live_ranges_(num_registers(), InactiveLiveRangeQueue(local_zone),
                             local_zone),
+      spill_state_(data->code()->InstructionBlockCount(),
+                   ZoneVector<LiveRange*>(local_zone), local_zone),
       next_active_ranges_change_(LifetimePosition::Invalid()),
       next_inactive_ranges_change_(LifetimePosition::Invalid()) {
   active_live_ranges().reserve(8);
@@ -3195,8 +3207,8 @@ RpoNumber LinearScanAllocator::ChooseOneOfTwoPredecessorStates(
   // Compute vectors of ranges with imminent use for both sides.
   // As GetChildCovers is cached, it is cheaper to repeatedly
   // call is rather than compute a shared set first.
-  auto& left = data()->GetSpillState(current_block->predecessors()[0]);
-  auto& right = data()->GetSpillState(current_block->predecessors()[1]);
+  auto& left = GetSpillState(current_block->predecessors()[0]);
+  auto& right = GetSpillState(current_block->predecessors()[1]);
   SmallRangeVector left_used;
   for (const auto item : left) {
     LiveRange* at_next_block = item->TopLevel()->GetChildCovers(boundary);
@@ -3268,7 +3280,7 @@ void LinearScanAllocator::ComputeStateFromManyPredecessors(
     }
   };
   ZoneMap<TopLevelLiveRange*, Vote, TopLevelLiveRangeComparator> counts(
-      data()->allocation_zone());
+      allocation_zone());
   int deferred_blocks = 0;
   for (RpoNumber pred : current_block->predecessors()) {
     if (!ConsiderBlockForControlFlow(current_block, pred)) {
@@ -3276,7 +3288,7 @@ void LinearScanAllocator::ComputeStateFromManyPredecessors(
       deferred_blocks++;
       continue;
     }
-    const auto& pred_state = data()->GetSpillState(pred);
+    const auto& pred_state = GetSpillState(pred);
     for (LiveRange* range : pred_state) {
       // We might have spilled the register backwards, so the range we
       // stored might have lost its register. Ignore those.
@@ -3402,7 +3414,7 @@ void LinearScanAllocator::UpdateDeferredFixedRanges(SpillMode spill_mode,
               other->TopLevel()->vreg(),
               RegisterName(other->assigned_register()));
         LiveRange* split_off =
-            other->SplitAt(next_start, data()->allocation_zone());
+            other->SplitAt(next_start, allocation_zone());
         // Try to get the same register after the deferred block.
         split_off->set_controlflow_hint(other->assigned_register());
         DCHECK_NE(split_off, other);
@@ -3511,7 +3523,7 @@ void LinearScanAllocator::AllocateRegisters() {
   }
 
   SplitAndSpillRangesDefinedByMemoryOperand();
-  data()->ResetSpillState();
+  ResetSpillState();
 
   if (data()->is_trace_alloc()) {
     PrintRangeOverview();
@@ -3579,7 +3591,7 @@ void LinearScanAllocator::AllocateRegisters() {
   // breaks with the invariant that we undo spills that happen in deferred code
   // when crossing a deferred/non-deferred boundary.
   while (!unhandled_live_ranges().empty() || last_block < max_blocks) {
-    data()->tick_counter()->TickAndMaybeEnterSafepoint();
+    tick_counter()->TickAndMaybeEnterSafepoint();
     LiveRange* current = unhandled_live_ranges().empty()
                              ? nullptr
                              : *unhandled_live_ranges().begin();
@@ -3605,7 +3617,7 @@ void LinearScanAllocator::AllocateRegisters() {
       // Store current spill state (as the state at end of block). For
       // simplicity, we store the active ranges, e.g., the live ranges that
       // are not spilled.
-      data()->RememberSpillState(last_block, active_live_ranges());
+      RememberSpillState(last_block, active_live_ranges());
 
       // Only reset the state if this was not a direct fallthrough. Otherwise
       // control flow resolution will get confused (it does not expect changes
@@ -3649,7 +3661,7 @@ void LinearScanAllocator::AllocateRegisters() {
         // allocation if they were not live at the predecessors.
         ForwardStateTo(next_block_boundary);
 
-        RangeWithRegisterSet to_be_live(data()->allocation_zone());
+        RangeWithRegisterSet to_be_live(allocation_zone());
 
         // If we end up deciding to use the state of the immediate
         // predecessor, it is better not to perform a change. It would lead to
@@ -3667,7 +3679,7 @@ void LinearScanAllocator::AllocateRegisters() {
           // boundary, there is nothing to do.
           bool is_noop = pred.IsNext(current_block->rpo_number());
           if (!is_noop) {
-            auto& spill_state = data()->GetSpillState(pred);
+            auto& spill_state = GetSpillState(pred);
             TRACE("Not a fallthrough. Adding %zu elements...\n",
                   spill_state.size());
             LifetimePosition pred_end =
@@ -3863,7 +3875,7 @@ void LinearScanAllocator::ForwardStateTo(LifetimePosition position) {
   if (position >= next_inactive_ranges_change_) {
     next_inactive_ranges_change_ = LifetimePosition::MaxPosition();
     for (int reg = 0; reg < num_registers(); ++reg) {
-      ZoneVector<LiveRange*> reorder(data()->allocation_zone());
+      ZoneVector<LiveRange*> reorder(allocation_zone());
       for (auto it = inactive_live_ranges(reg).begin();
            it != inactive_live_ranges(reg).end();) {
         LiveRange* cur_inactive = *it;
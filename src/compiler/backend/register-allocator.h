@@ -306,8 +306,9 @@ class TopTierRegisterAllocationData final : public RegisterAllocationData {
   // Creates a new live range.
   TopLevelLiveRange* NewLiveRange(int index, MachineRepresentation rep);
 
+  // The spill range is allocated in |zone| if it does not exist yet.
   SpillRange* AssignSpillRangeToLiveRange(TopLevelLiveRange* range,
-                                          SpillMode spill_mode);
+                                          SpillMode spill_mode, Zone* zone);
   SpillRange* CreateSpillRangeForLiveRange(TopLevelLiveRange* range);
 
   MoveOperands* AddGapMove(int index, Instruction::GapPosition position,
@@ -332,22 +333,6 @@ class TopTierRegisterAllocationData final : public RegisterAllocationData {
     return preassigned_slot_ranges_;
   }
 
-  void RememberSpillState(RpoNumber block,
-                          const ZoneVector<LiveRange*>& state) {
-    spill_state_[block.ToSize()] = state;
-  }
-
-  ZoneVector<LiveRange*>& GetSpillState(RpoNumber block) {
-    auto& result = spill_state_[block.ToSize()];
-    return result;
-  }
-
-  void ResetSpillState() {
-    for (auto& state : spill_state_) {
-      state.clear();
-    }
-  }
-
   TickCounter* tick_counter() { return tick_counter_; }
 
   ZoneMap<TopLevelLiveRange*, AllocatedOperand*>& slot_for_const_range() {
@@ -376,7 +361,6 @@ class TopTierRegisterAllocationData final : public RegisterAllocationData {
   BitVector* fixed_fp_register_use_;
   int virtual_register_count_;
   RangesWithPreassignedSlots preassigned_slot_ranges_;
-  ZoneVector<ZoneVector<LiveRange*>> spill_state_;
   RegisterAllocationFlags flags_;
   TickCounter* const tick_counter_;
   ZoneMap<TopLevelLiveRange*, AllocatedOperand*> slot_for_const_range_;
@@ -1294,7 +1278,8 @@ class BundleBuilder final : public ZoneObject {
 
 class RegisterAllocator : public ZoneObject {
  public:
-  RegisterAllocator(TopTierRegisterAllocationData* data, RegisterKind kind);
+  RegisterAllocator(TopTierRegisterAllocationData* data, RegisterKind kind,
+                    Zone* allocation_zone, TickCounter* tick_counter);
   RegisterAllocator(const RegisterAllocator&) = delete;
   RegisterAllocator& operator=(const RegisterAllocator&) = delete;
 
@@ -1315,7 +1300,11 @@ class RegisterAllocator : public ZoneObject {
   LifetimePosition GetSplitPositionForInstruction(const LiveRange* range,
                                                   int instruction_index);
 
-  Zone* allocation_zone() const { return data()->allocation_zone(); }
+  // Zone for the live ranges and spill ranges created by this allocator. This
+  // is the allocation zone of |data()| unless the allocator runs concurrently
+  // with the allocator of the other register kind.
+  Zone* allocation_zone() const { return allocation_zone_; }
+  TickCounter* tick_counter() const { return tick_counter_; }
 
   // Find the optimal split for ranges defined by a memory operand, e.g.
   // constants or function parameters passed on the stack.
@@ -1330,7 +1319,9 @@ class RegisterAllocator : public ZoneObject {
   LiveRange* SplitRangeAt(LiveRange* range, LifetimePosition pos);
 
   bool CanProcessRange(LiveRange* range) const {
-    return range != nullptr && !range->IsEmpty() && range->kind() == mode();
+    // The kind is checked first, as ranges of the other kind may be modified
+    // concurrently.
+    return range != nullptr && range->kind() == mode() && !range->IsEmpty();
   }
 
   // Split the given range in a position from the interval [start, end].
@@ -1357,6 +1348,8 @@ class RegisterAllocator : public ZoneObject {
 
  private:
   TopTierRegisterAllocationData* const data_;
+  Zone* const allocation_zone_;
+  TickCounter* const tick_counter_;
   const RegisterKind mode_;
   const int num_registers_;
   int num_allocatable_registers_;
@@ -1371,6 +1364,14 @@ class LinearScanAllocator final : public RegisterAllocator {
  public:
   LinearScanAllocator(TopTierRegisterAllocationData* data, RegisterKind kind,
                       Zone* local_zone);
+  // Allows allocating registers of one kind on another thread while the
+  // other kind is allocated with the constructor above. Live ranges split
+  // by this allocator are then allocated in |allocation_zone| rather than in
+  // the shared allocation zone of |data|, and |tick_counter| must not enter
+  // safepoints on behalf of the compilation thread.
+  LinearScanAllocator(TopTierRegisterAllocationData* data, RegisterKind kind,
+                      Zone* local_zone, Zone* allocation_zone,
+                      TickCounter* tick_counter);
   LinearScanAllocator(const LinearScanAllocator&) = delete;
   LinearScanAllocator& operator=(const LinearScanAllocator&) = delete;
 
@@ -1414,6 +1415,22 @@ class LinearScanAllocator final : public RegisterAllocator {
   void ReloadLiveRanges(RangeWithRegisterSet const& to_be_live,
                         LifetimePosition position);
 
+  void RememberSpillState(RpoNumber block,
+                          const ZoneVector<LiveRange*>& state) {
+    spill_state_[block.ToSize()] = state;
+  }
+
+  ZoneVector<LiveRange*>& GetSpillState(RpoNumber block) {
+    auto& result = spill_state_[block.ToSize()];
+    return result;
+  }
+
+  void ResetSpillState() {
+    for (auto& state : spill_state_) {
+      state.clear();
+    }
+  }
+
   void UpdateDeferredFixedRanges(SpillMode spill_mode, InstructionBlock* block);
   bool BlockIsDeferredOrImmediatePredecessorIsNotDeferred(
       const InstructionBlock* block);
@@ -1510,6 +1527,8 @@ class LinearScanAllocator final : public RegisterAllocator {
   UnhandledLiveRangeQueue unhandled_live_ranges_;
   ZoneVector<LiveRange*> active_live_ranges_;
   ZoneVector<InactiveLiveRangeQueue> inactive_live_ranges_;
+  // The active live ranges at the end of every block, indexed by RPO number.
+  ZoneVector<ZoneVector<LiveRange*>> spill_state_;
 
   // Approximate at what position the set of ranges will change next.
   // Used to avoid scanning for updates even if none are present.
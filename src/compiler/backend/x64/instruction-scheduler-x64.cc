@@ -4,6 +4,10 @@
 
 #include "src/compiler/backend/instruction-scheduler.h"
 
+#include <cstring>
+
+#include "src/base/cpu.h"
+
 namespace v8 {
 namespace internal {
 namespace compiler {
@@ -439,16 +443,230 @@ int InstructionScheduler::GetTargetInstructionFlags(
   UNREACHABLE();
 }
 
-int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // Basic latency modeling for x64 instructions. They have been determined
-  // in an empirical way.
+namespace {
+
+struct OperationCost {
+  // Cycles until the result is available to dependent instructions.
+  int latency;
+  // Cycles during which the operation blocks the divider, which is not
+  // pipelined. 0 for operations that don't use it.
+  int occupancy;
+};
+
+// Costs of the operations whose latency differs noticeably between
+// microarchitectures. All other operations are modeled as taking a single
+// cycle. Division latencies are for typical operand values, as the actual
+// latency depends on them.
+struct CostModel {
+  // Added to the latency of instructions with a memory input, assuming an L1
+  // cache hit.
+  int load_latency;
+  OperationCost int_mul32;
+  OperationCost int_mul64;
+  OperationCost int_div32;
+  OperationCost int_div64;
+  OperationCost uint_div32;
+  OperationCost uint_div64;
+  OperationCost float_add;
+  OperationCost float32_mul;
+  OperationCost float64_mul;
+  OperationCost float_convert;
+  OperationCost float_to_int64;
+  OperationCost float32_div;
+  OperationCost float64_div;
+  OperationCost float32_sqrt;
+  OperationCost float64_sqrt;
+  OperationCost float64_mod;
+  OperationCost truncate_double_to_i;
+};
+
+// Used for CPUs that are not recognized. The latencies have been determined
+// in an empirical way, the divider occupancy is the one of Haswell.
+constexpr CostModel kGenericCostModel = {
+    4,         // load_latency
+    {3, 0},    // int_mul32
+    {3, 0},    // int_mul64
+    {35, 9},   // int_div32
+    {49, 24},  // int_div64
+    {26, 9},   // uint_div32
+    {38, 21},  // uint_div64
+    {3, 0},    // float_add
+    {4, 0},    // float32_mul
+    {5, 0},    // float64_mul
+    {4, 0},    // float_convert
+    {10, 0},   // float_to_int64
+    {13, 7},   // float32_div
+    {13, 8},   // float64_div
+    {13, 7},   // float32_sqrt
+    {13, 8},   // float64_sqrt
+    {50, 0},   // float64_mod
+    {6, 0},    // truncate_double_to_i
+};
+
+// Intel Skylake up to Comet Lake.
+constexpr CostModel kSkylakeCostModel = {
+    4,         // load_latency
+    {3, 0},    // int_mul32
+    {3, 0},    // int_mul64
+    {26, 6},   // int_div32
+    {42, 24},  // int_div64
+    {26, 6},   // uint_div32
+    {35, 21},  // uint_div64
+    {4, 0},    // float_add
+    {4, 0},    // float32_mul
+    {4, 0},    // float64_mul
+    {5, 0},    // float_convert
+    {10, 0},   // float_to_int64
+    {11, 3},   // float32_div
+    {14, 4},   // float64_div
+    {12, 3},   // float32_sqrt
+    {18, 6},   // float64_sqrt
+    {50, 0},   // float64_mod
+    {6, 0},    // truncate_double_to_i
+};
+
+// Intel Ice Lake and later, which have a much faster integer divider.
+constexpr CostModel kIceLakeCostModel = {
+    5,         // load_latency
+    {3, 0},    // int_mul32
+    {3, 0},    // int_mul64
+    {12, 6},   // int_div32
+    {15, 10},  // int_div64
+    {12, 6},   // uint_div32
+    {15, 10},  // uint_div64
+    {4, 0},    // float_add
+    {4, 0},    // float32_mul
+    {4, 0},    // float64_mul
+    {5, 0},    // float_convert
+    {10, 0},   // float_to_int64
+    {11, 3},   // float32_div
+    {14, 4},   // float64_div
+    {12, 3},   // float32_sqrt
+    {18, 6},   // float64_sqrt
+    {50, 0},   // float64_mod
+    {6, 0},    // truncate_double_to_i
+};
+
+// AMD family 17h (Zen to Zen 2).
+constexpr CostModel kZenCostModel = {
+    4,         // load_latency
+    {3, 0},    // int_mul32
+    {3, 0},    // int_mul64
+    {25, 25},  // int_div32
+    {41, 41},  // int_div64
+    {25, 25},  // uint_div32
+    {40, 40},  // uint_div64
+    {3, 0},    // float_add
+    {3, 0},    // float32_mul
+    {4, 0},    // float64_mul
+    {4, 0},    // float_convert
+    {10, 0},   // float_to_int64
+    {10, 3},   // float32_div
+    {13, 4},   // float64_div
+    {14, 5},   // float32_sqrt
+    {20, 9},   // float64_sqrt
+    {50, 0},   // float64_mod
+    {6, 0},    // truncate_double_to_i
+};
+
+// AMD family 19h and later (Zen 3 onwards).
+constexpr CostModel kZen3CostModel = {
+    4,         // load_latency
+    {3, 0},    // int_mul32
+    {3, 0},    // int_mul64
+    {10, 6},   // int_div32
+    {14, 10},  // int_div64
+    {10, 6},   // uint_div32
+    {14, 10},  // uint_div64
+    {3, 0},    // float_add
+    {3, 0},    // float32_mul
+    {3, 0},    // float64_mul
+    {4, 0},    // float_convert
+    {10, 0},   // float_to_int64
+    {10, 3},   // float32_div
+    {13, 5},   // float64_div
+    {14, 5},   // float32_sqrt
+    {20, 9},   // float64_sqrt
+    {50, 0},   // float64_mod
+    {6, 0},    // truncate_double_to_i
+};
+
+// Intel Atom (Silvermont and Goldmont), whose dividers are not pipelined.
+constexpr CostModel kAtomCostModel = {
+    3,         // load_latency
+    {3, 0},    // int_mul32
+    {5, 0},    // int_mul64
+    {29, 29},  // int_div32
+    {70, 70},  // int_div64
+    {29, 29},  // uint_div32
+    {70, 70},  // uint_div64
+    {3, 0},    // float_add
+    {4, 0},    // float32_mul
+    {5, 0},    // float64_mul
+    {4, 0},    // float_convert
+    {10, 0},   // float_to_int64
+    {19, 17},  // float32_div
+    {34, 32},  // float64_div
+    {20, 18},  // float32_sqrt
+    {35, 33},  // float64_sqrt
+    {60, 0},   // float64_mod
+    {7, 0},    // truncate_double_to_i
+};
+
+const CostModel* SelectCostModel() {
+  base::CPU cpu;
+  if (cpu.is_atom()) return &kAtomCostModel;
+  if (strcmp(cpu.vendor(), "GenuineIntel") == 0 && cpu.family() == 0x6) {
+    switch (cpu.model()) {
+      case 0x4E:  // Skylake mobile.
+      case 0x5E:  // Skylake desktop.
+      case 0x55:  // Skylake server, Cascade Lake.
+      case 0x8E:  // Kaby Lake mobile, Comet Lake mobile.
+      case 0x9E:  // Kaby Lake desktop, Coffee Lake.
+      case 0xA5:  // Comet Lake desktop.
+      case 0xA6:  // Comet Lake mobile.
+        return &kSkylakeCostModel;
+      case 0x6A:  // Ice Lake server.
+      case 0x6C:  // Ice Lake server.
+      case 0x7D:  // Ice Lake desktop.
+      case 0x7E:  // Ice Lake mobile.
+      case 0x8C:  // Tiger Lake mobile.
+      case 0x8D:  // Tiger Lake desktop.
+      case 0x8F:  // Sapphire Rapids.
+      case 0x97:  // Alder Lake desktop.
+      case 0x9A:  // Alder Lake mobile.
+      case 0xA7:  // Rocket Lake.
+      case 0xB7:  // Raptor Lake.
+      case 0xBA:  // Raptor Lake mobile.
+      case 0xBF:  // Raptor Lake desktop.
+        return &kIceLakeCostModel;
+      default:
+        break;
+    }
+  } else if (strcmp(cpu.vendor(), "AuthenticAMD") == 0 &&
+             cpu.family() == 0xF) {
+    if (cpu.ext_family() == 0x8) return &kZenCostModel;
+    if (cpu.ext_family() >= 0xA) return &kZen3CostModel;
+  }
+  return &kGenericCostModel;
+}
+
+// The cost model of the CPU we are running on, selected once per process.
+const CostModel& GetCostModel() {
+  static const CostModel* const cost_model = SelectCostModel();
+  return *cost_model;
+}
+
+// Returns nullptr for operations that take a single cycle.
+const OperationCost* GetOperationCost(const CostModel& model,
+                                      const Instruction* instr) {
   switch (instr->arch_opcode()) {
-    case kSSEFloat64Mul:
-      return 5;
-    case kX64Imul:
     case kX64Imul32:
     case kX64ImulHigh32:
     case kX64UmulHigh32:
+      return &model.int_mul32;
+    case kX64Imul:
+      return &model.int_mul64;
     case kX64Float32Abs:
     case kX64Float32Neg:
     case kX64Float64Abs:
@@ -461,8 +679,11 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kSSEFloat64Sub:
     case kSSEFloat64Max:
     case kSSEFloat64Min:
-      return 3;
+      return &model.float_add;
     case kSSEFloat32Mul:
+      return &model.float32_mul;
+    case kSSEFloat64Mul:
+      return &model.float64_mul;
     case kSSEFloat32ToFloat64:
     case kSSEFloat64ToFloat32:
     case kSSEFloat32Round:
@@ -471,34 +692,64 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kSSEFloat32ToUint32:
     case kSSEFloat64ToInt32:
     case kSSEFloat64ToUint32:
-      return 4;
+      return &model.float_convert;
     case kX64Idiv:
-      return 49;
+      return &model.int_div64;
     case kX64Idiv32:
-      return 35;
+      return &model.int_div32;
     case kX64Udiv:
-      return 38;
+      return &model.uint_div64;
     case kX64Udiv32:
-      return 26;
+      return &model.uint_div32;
     case kSSEFloat32Div:
+      return &model.float32_div;
     case kSSEFloat64Div:
+      return &model.float64_div;
     case kSSEFloat32Sqrt:
+      return &model.float32_sqrt;
     case kSSEFloat64Sqrt:
-      return 13;
+      return &model.float64_sqrt;
     case kSSEFloat32ToInt64:
     case kSSEFloat64ToInt64:
     case kSSEFloat32ToUint64:
     case kSSEFloat64ToUint64:
-      return 10;
+      return &model.float_to_int64;
     case kSSEFloat64Mod:
-      return 50;
+      return &model.float64_mod;
     case kArchTruncateDoubleToI:
-      return 6;
+      return &model.truncate_double_to_i;
     default:
-      return 1;
+      return nullptr;
   }
 }
 
+// Whether the instruction reads one of its inputs from memory.
+bool HasMemoryInput(const Instruction* instr) {
+  switch (instr->arch_opcode()) {
+    case kX64Lea32:
+    case kX64Lea:
+      // Only computes an address.
+      return false;
+    default:
+      return instr->HasOutput() && instr->addressing_mode() != kMode_None;
+  }
+}
+
+}  // namespace
+
+int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
+  const CostModel& model = GetCostModel();
+  const OperationCost* cost = GetOperationCost(model, instr);
+  int latency = cost != nullptr ? cost->latency : 1;
+  if (HasMemoryInput(instr)) latency += model.load_latency;
+  return latency;
+}
+
+int InstructionScheduler::GetInstructionOccupancy(const Instruction* instr) {
+  const OperationCost* cost = GetOperationCost(GetCostModel(), instr);
+  return cost != nullptr ? cost->occupancy : 0;
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -20,6 +20,7 @@
 #include "src/compiler/operator-properties.h"
 #include "src/compiler/simplified-operator.h"
 #include "src/compiler/state-values-utils.h"
+#include "src/heap/pretenuring-sampler.h"
 #include "src/interpreter/bytecode-array-iterator.h"
 #include "src/interpreter/bytecode-flags.h"
 #include "src/interpreter/bytecodes.h"
@@ -106,6 +107,11 @@ class BytecodeGraphBuilder {
 
   Node* BuildLoadFeedbackCell(int index);
 
+  // Allocation type for objects created by the current bytecode. The
+  // --sampling-pretenuring feedback can only upgrade |allocation| to old
+  // space, never downgrade it.
+  AllocationType SampledAllocationType(AllocationType allocation) const;
+
   // Checks the optimization marker and potentially triggers compilation or
   // installs the finished code object.
   // Only relevant for specific code kinds (see CodeKindCanTierUp).
@@ -1139,6 +1145,21 @@ Node* BytecodeGraphBuilder::BuildLoadFeedbackCell(int index) {
   return jsgraph()->Constant(feedback_vector().GetClosureFeedbackCell(index));
 }
 
+AllocationType BytecodeGraphBuilder::SampledAllocationType(
+    AllocationType allocation) const {
+  if (allocation != AllocationType::kYoung) return allocation;
+  PretenuringSampler* sampler =
+      jsgraph()->isolate()->heap()->pretenuring_sampler();
+  if (sampler == nullptr) return allocation;
+  if (sampler->GetAllocationType(PretenuringSampler::SiteKey(
+          shared_info().Hash(), bytecode_iterator().current_offset())) !=
+      AllocationType::kOld) {
+    return allocation;
+  }
+  sampler->RecordRedirectedAllocation();
+  return AllocationType::kOld;
+}
+
 void BytecodeGraphBuilder::CreateNativeContextNode() {
   DCHECK_NULL(native_context_node_);
   native_context_node_ = jsgraph()->Constant(native_context());
@@ -2220,11 +2241,16 @@ void BytecodeGraphBuilder::VisitPopContext() {
 void BytecodeGraphBuilder::VisitCreateClosure() {
   SharedFunctionInfoRef shared_info =
       MakeRefForConstantForIndexOperand<SharedFunctionInfo>(0);
+  // With --sampling-pretenuring, closures are only allocated in old space if
+  // the sampler decided so. The pretenuring bit of the bytecode is ignored, as
+  // JSCreateLowering does without the sampler (see crbug.com/810132).
   AllocationType allocation =
-      interpreter::CreateClosureFlags::PretenuredBit::decode(
-          bytecode_iterator().GetFlagOperand(2))
-          ? AllocationType::kOld
-          : AllocationType::kYoung;
+      FLAG_sampling_pretenuring
+          ? SampledAllocationType(AllocationType::kYoung)
+          : interpreter::CreateClosureFlags::PretenuredBit::decode(
+                bytecode_iterator().GetFlagOperand(2))
+                ? AllocationType::kOld
+                : AllocationType::kYoung;
   CodeTRef compile_lazy = MakeRef(
       broker(), ToCodeT(*BUILTIN_CODE(jsgraph()->isolate(), CompileLazy)));
   const Operator* op =
@@ -2244,8 +2270,9 @@ void BytecodeGraphBuilder::VisitCreateBlockContext() {
 void BytecodeGraphBuilder::VisitCreateFunctionContext() {
   ScopeInfoRef scope_info = MakeRefForConstantForIndexOperand<ScopeInfo>(0);
   uint32_t slots = bytecode_iterator().GetUnsignedImmediateOperand(1);
-  const Operator* op =
-      javascript()->CreateFunctionContext(scope_info, slots, FUNCTION_SCOPE);
+  const Operator* op = javascript()->CreateFunctionContext(
+      scope_info, slots, FUNCTION_SCOPE,
+      SampledAllocationType(AllocationType::kYoung));
   Node* context = NewNode(op);
   environment()->BindAccumulator(context);
 }
@@ -2253,8 +2280,9 @@ void BytecodeGraphBuilder::VisitCreateFunctionContext() {
 void BytecodeGraphBuilder::VisitCreateEvalContext() {
   ScopeInfoRef scope_info = MakeRefForConstantForIndexOperand<ScopeInfo>(0);
   uint32_t slots = bytecode_iterator().GetUnsignedImmediateOperand(1);
-  const Operator* op =
-      javascript()->CreateFunctionContext(scope_info, slots, EVAL_SCOPE);
+  const Operator* op = javascript()->CreateFunctionContext(
+      scope_info, slots, EVAL_SCOPE,
+      SampledAllocationType(AllocationType::kYoung));
   Node* context = NewNode(op);
   environment()->BindAccumulator(context);
 }
@@ -953,7 +953,11 @@ Reduction JSCreateLowering::ReduceJSCreateClosure(Node* node) {
   // for old-space allocation, which doesn't always make sense. For
   // example in case of the bluebird-parallel benchmark, where this
   // is a core part of the *promisify* logic (see crbug.com/810132).
-  AllocationType allocation = AllocationType::kYoung;
+  // With --sampling-pretenuring, the bytecode graph builder ignores that
+  // marking, and the flag only requests old-space allocation for closures
+  // whose sampled survival rate is high.
+  AllocationType allocation =
+      FLAG_sampling_pretenuring ? p.allocation() : AllocationType::kYoung;
 
   // Emit code to allocate the JSFunction instance.
   STATIC_ASSERT(JSFunction::kSizeWithoutPrototype == 7 * kTaggedSize);
@@ -1211,6 +1215,7 @@ Reduction JSCreateLowering::ReduceJSCreateFunctionContext(Node* node) {
   ScopeInfoRef scope_info = parameters.scope_info(broker());
   int slot_count = parameters.slot_count();
   ScopeType scope_type = parameters.scope_type();
+  AllocationType allocation = parameters.allocation();
 
   // Use inline allocation for function contexts up to a size limit.
   if (slot_count < kFunctionContextAllocationLimit) {
@@ -1223,11 +1228,12 @@ Reduction JSCreateLowering::ReduceJSCreateFunctionContext(Node* node) {
     int context_length = slot_count + Context::MIN_CONTEXT_SLOTS;
     switch (scope_type) {
       case EVAL_SCOPE:
-        a.AllocateContext(context_length, native_context().eval_context_map());
+        a.AllocateContext(context_length, native_context().eval_context_map(),
+                          allocation);
         break;
       case FUNCTION_SCOPE:
         a.AllocateContext(context_length,
-                          native_context().function_context_map());
+                          native_context().function_context_map(), allocation);
         break;
       default:
         UNREACHABLE();
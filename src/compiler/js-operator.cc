@@ -188,7 +188,8 @@ bool operator==(CreateFunctionContextParameters const& lhs,
   return lhs.scope_info_.object().location() ==
              rhs.scope_info_.object().location() &&
          lhs.slot_count() == rhs.slot_count() &&
-         lhs.scope_type() == rhs.scope_type();
+         lhs.scope_type() == rhs.scope_type() &&
+         lhs.allocation() == rhs.allocation();
 }
 
 bool operator!=(CreateFunctionContextParameters const& lhs,
@@ -199,12 +200,14 @@ bool operator!=(CreateFunctionContextParameters const& lhs,
 size_t hash_value(CreateFunctionContextParameters const& parameters) {
   return base::hash_combine(parameters.scope_info_.object().location(),
                             parameters.slot_count(),
-                            static_cast<int>(parameters.scope_type()));
+                            static_cast<int>(parameters.scope_type()),
+                            parameters.allocation());
 }
 
 std::ostream& operator<<(std::ostream& os,
                          CreateFunctionContextParameters const& parameters) {
-  return os << parameters.slot_count() << ", " << parameters.scope_type();
+  return os << parameters.slot_count() << ", " << parameters.scope_type()
+            << ", " << parameters.allocation();
 }
 
 CreateFunctionContextParameters const& CreateFunctionContextParametersOf(
@@ -1421,9 +1424,10 @@ const Operator* JSOperatorBuilder::CreateLiteralRegExp(
 }
 
 const Operator* JSOperatorBuilder::CreateFunctionContext(
-    const ScopeInfoRef& scope_info, int slot_count, ScopeType scope_type) {
+    const ScopeInfoRef& scope_info, int slot_count, ScopeType scope_type,
+    AllocationType allocation) {
   CreateFunctionContextParameters parameters(scope_info, slot_count,
-                                             scope_type);
+                                             scope_type, allocation);
   return zone()->New<Operator1<CreateFunctionContextParameters>>(   // --
       IrOpcode::kJSCreateFunctionContext, Operator::kNoProperties,  // opcode
       "JSCreateFunctionContext",                                    // name
@@ -364,21 +364,25 @@ V8_EXPORT_PRIVATE ContextAccess const& ContextAccessOf(Operator const*);
 class CreateFunctionContextParameters final {
  public:
   CreateFunctionContextParameters(const ScopeInfoRef& scope_info,
-                                  int slot_count, ScopeType scope_type)
+                                  int slot_count, ScopeType scope_type,
+                                  AllocationType allocation)
       : scope_info_(scope_info),
         slot_count_(slot_count),
-        scope_type_(scope_type) {}
+        scope_type_(scope_type),
+        allocation_(allocation) {}
 
   ScopeInfoRef scope_info(JSHeapBroker* broker) const {
     return scope_info_.AsRef(broker);
   }
   int slot_count() const { return slot_count_; }
   ScopeType scope_type() const { return scope_type_; }
+  AllocationType allocation() const { return allocation_; }
 
  private:
   const ScopeInfoTinyRef scope_info_;
   int const slot_count_;
   ScopeType const scope_type_;
+  AllocationType const allocation_;
 
   friend bool operator==(CreateFunctionContextParameters const& lhs,
                          CreateFunctionContextParameters const& rhs);
@@ -1090,8 +1094,9 @@ class V8_EXPORT_PRIVATE JSOperatorBuilder final
   const Operator* RejectPromise();
   const Operator* ResolvePromise();
 
-  const Operator* CreateFunctionContext(const ScopeInfoRef& scope_info,
-                                        int slot_count, ScopeType scope_type);
+  const Operator* CreateFunctionContext(
+      const ScopeInfoRef& scope_info, int slot_count, ScopeType scope_type,
+      AllocationType allocation = AllocationType::kYoung);
   const Operator* CreateCatchContext(const ScopeInfoRef& scope_info);
   const Operator* CreateWithContext(const ScopeInfoRef& scope_info);
   const Operator* CreateBlockContext(const ScopeInfoRef& scpope_info);
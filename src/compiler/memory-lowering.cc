@@ -12,6 +12,7 @@
 #include "src/compiler/node-properties.h"
 #include "src/compiler/node.h"
 #include "src/compiler/simplified-operator.h"
+#include "src/heap/third-party/heap-api.h"
 #include "src/roots/roots-inl.h"
 #include "src/security/external-pointer.h"
 
@@ -499,6 +500,8 @@ Reduction MemoryLowering::ReduceStoreToObject(Node* node,
 
   WriteBarrierKind write_barrier_kind = ComputeWriteBarrierKind(
       node, object, value, state, access.write_barrier_kind);
+  write_barrier_kind = LowerCardMarkingBarrier(node, object, node->InputAt(1),
+                                               write_barrier_kind);
   DCHECK(!access.machine_type.IsMapWord());
   MachineRepresentation rep = access.machine_type.representation();
   StoreRepresentation store_rep(rep, write_barrier_kind);
@@ -517,9 +520,12 @@ Reduction MemoryLowering::ReduceStoreElement(Node* node,
   Node* object = node->InputAt(0);
   Node* index = node->InputAt(1);
   Node* value = node->InputAt(2);
-  node->ReplaceInput(1, ComputeIndex(access, index));
+  index = ComputeIndex(access, index);
+  node->ReplaceInput(1, index);
   WriteBarrierKind write_barrier_kind = ComputeWriteBarrierKind(
       node, object, value, state, access.write_barrier_kind);
+  write_barrier_kind =
+      LowerCardMarkingBarrier(node, object, index, write_barrier_kind);
   NodeProperties::ChangeOp(
       node, machine()->Store(StoreRepresentation(
                 access.machine_type.representation(), write_barrier_kind)));
@@ -545,6 +551,10 @@ Reduction MemoryLowering::ReduceStoreField(Node* node,
   WriteBarrierKind write_barrier_kind = ComputeWriteBarrierKind(
       node, object, value, state, access.write_barrier_kind);
   Node* offset = __ IntPtrConstant(access.offset - access.tag());
+  // Mark the card while {node} is still a StoreField, whose effect and
+  // control inputs follow its two value inputs.
+  write_barrier_kind =
+      LowerCardMarkingBarrier(node, object, offset, write_barrier_kind);
   node->InsertInput(graph_zone(), 1, offset);
 
   if (machine_type.IsMapWord()) {
@@ -568,6 +578,8 @@ Reduction MemoryLowering::ReduceStore(Node* node,
   Node* value = node->InputAt(2);
   WriteBarrierKind write_barrier_kind = ComputeWriteBarrierKind(
       node, object, value, state, representation.write_barrier_kind());
+  write_barrier_kind = LowerCardMarkingBarrier(node, object, node->InputAt(1),
+                                               write_barrier_kind);
   if (write_barrier_kind != representation.write_barrier_kind()) {
     NodeProperties::ChangeOp(
         node, machine()->Store(StoreRepresentation(
@@ -590,6 +602,36 @@ Node* MemoryLowering::ComputeIndex(ElementAccess const& access, Node* index) {
   return index;
 }
 
+WriteBarrierKind MemoryLowering::LowerCardMarkingBarrier(
+    Node* store, Node* object, Node* offset,
+    WriteBarrierKind write_barrier_kind) {
+  if (!V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL) return write_barrier_kind;
+  if (write_barrier_kind == kNoWriteBarrier ||
+      write_barrier_kind == kAssertNoWriteBarrier) {
+    return write_barrier_kind;
+  }
+  // Wasm is not supported by the generational third-party heap.
+  DCHECK_NOT_NULL(isolate());
+  __ InitializeEffectControl(NodeProperties::GetEffectInput(store),
+                             NodeProperties::GetControlInput(store));
+  Node* card_table = __ Load(
+      MachineType::Pointer(),
+      __ ExternalConstant(
+          ExternalReference::third_party_heap_card_table_base_address(
+              isolate())),
+      0);
+  Node* slot = __ IntAdd(__ BitcastTaggedToWord(object), offset);
+  Node* card = __ WordShr(
+      slot, __ IntPtrConstant(third_party_heap::Heap::kCardSizeLog2));
+  __ Store(StoreRepresentation(MachineRepresentation::kWord8, kNoWriteBarrier),
+           card_table, card,
+           __ Int32Constant(third_party_heap::Heap::kDirtyCard));
+  // The card is marked right before the store. There is no safepoint in
+  // between, so a collection never observes one without the other.
+  NodeProperties::ReplaceEffectInput(store, __ effect());
+  return kNoWriteBarrier;
+}
+
 #undef __
 
 namespace {
@@ -634,7 +676,8 @@ WriteBarrierKind MemoryLowering::ComputeWriteBarrierKind(
   if (!ValueNeedsWriteBarrier(value, isolate())) {
     write_barrier_kind = kNoWriteBarrier;
   }
-  if (FLAG_disable_write_barriers) {
+  if (FLAG_disable_write_barriers &&
+      !V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL) {
     write_barrier_kind = kNoWriteBarrier;
   }
   if (write_barrier_kind == WriteBarrierKind::kAssertNoWriteBarrier) {
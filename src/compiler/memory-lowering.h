@@ -108,6 +108,13 @@ class MemoryLowering final : public Reducer {
                                            Node* value,
                                            AllocationState const* state,
                                            WriteBarrierKind);
+  // Emits the card-marking barrier of the generational third-party heap for
+  // the slot at {object} + {offset} into the effect chain in front of
+  // {store}, whose effect and control inputs must match its operator. Returns
+  // the write barrier kind that is left for the instruction selector.
+  WriteBarrierKind LowerCardMarkingBarrier(Node* store, Node* object,
+                                           Node* offset,
+                                           WriteBarrierKind write_barrier_kind);
   Node* DecodeExternalPointer(Node* encoded_pointer, ExternalPointerTag tag);
   Reduction ReduceLoadMap(Node* encoded_pointer);
   Node* ComputeIndex(ElementAccess const& access, Node* node);
@@ -4,18 +4,24 @@
 
 #include "src/compiler/pipeline.h"
 
+#include <inttypes.h>
+
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <sstream>
 
+#include "include/v8-platform.h"
 #include "src/base/optional.h"
 #include "src/base/platform/elapsed-timer.h"
 #include "src/builtins/profile-data-reader.h"
 #include "src/codegen/assembler-inl.h"
 #include "src/codegen/compiler.h"
+#include "src/codegen/optimization-hints.h"
 #include "src/codegen/optimized-compilation-info.h"
 #include "src/codegen/register-configuration.h"
+#include "src/codegen/tick-counter.h"
 #include "src/compiler/add-type-assertions-reducer.h"
 #include "src/compiler/backend/code-generator.h"
 #include "src/compiler/backend/frame-elider.h"
@@ -84,6 +90,7 @@
 #include "src/execution/isolate-inl.h"
 #include "src/heap/local-heap.h"
 #include "src/init/bootstrapper.h"
+#include "src/init/v8.h"
 #include "src/logging/code-events.h"
 #include "src/logging/counters.h"
 #include "src/logging/runtime-call-stats-scope.h"
@@ -118,6 +125,8 @@ static constexpr char kRegisterAllocationZoneName[] =
     "register-allocation-zone";
 static constexpr char kRegisterAllocatorVerifierZoneName[] =
     "register-allocator-verifier-zone";
+static constexpr char kFPRegisterAllocationZoneName[] =
+    "fp-register-allocation-zone";
 namespace {
 
 Maybe<OuterContext> GetModuleContext(Handle<JSFunction> closure) {
@@ -1185,6 +1194,11 @@ PipelineCompilationJob::Status PipelineCompilationJob::PrepareJobImpl(
   data_.set_start_source_position(
       compilation_info()->shared_info()->StartPosition());
 
+  if (FLAG_turbo_profiling_log_js || FLAG_turbo_profiling_log_file) {
+    compilation_info()->set_profile_key(OptimizationHints::FunctionKey(
+        *compilation_info()->shared_info()));
+  }
+
   linkage_ = compilation_info()->zone()->New<Linkage>(
       Linkage::ComputeIncoming(compilation_info()->zone(), compilation_info()));
 
@@ -2281,6 +2295,52 @@ struct AllocateFPRegistersPhase {
   }
 };
 
+// Allocates floating-point registers on a worker thread. Live ranges of the
+// two register kinds are disjoint, and everything the allocator creates goes
+// into |zone|, so this can run concurrently with the allocation of general
+// registers on the compilation thread.
+class AllocateFPRegistersJob final : public JobTask {
+ public:
+  AllocateFPRegistersJob(TopTierRegisterAllocationData* data, Zone* zone)
+      : data_(data), zone_(zone) {}
+
+  void Run(JobDelegate* delegate) override {
+    if (started_.exchange(true, std::memory_order_relaxed)) return;
+    // Register allocation does not access the heap, and only the compilation
+    // thread may enter safepoints of its LocalHeap.
+    TickCounter tick_counter;
+    LinearScanAllocator allocator(data_, RegisterKind::kDouble, zone_, zone_,
+                                  &tick_counter);
+    allocator.AllocateRegisters();
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const override {
+    return started_.load(std::memory_order_relaxed) ? 0 : 1;
+  }
+
+ private:
+  TopTierRegisterAllocationData* const data_;
+  Zone* const zone_;
+  std::atomic<bool> started_{false};
+};
+
+struct AllocateRegistersInParallelPhase {
+  DECL_PIPELINE_PHASE_CONSTANTS(AllocateRegistersInParallel)
+
+  void Run(PipelineData* data, Zone* temp_zone, Zone* fp_zone) {
+    TopTierRegisterAllocationData* allocation_data =
+        data->top_tier_register_allocation_data();
+    std::unique_ptr<JobHandle> fp_job = V8::GetCurrentPlatform()->PostJob(
+        TaskPriority::kUserVisible,
+        std::make_unique<AllocateFPRegistersJob>(allocation_data, fp_zone));
+    LinearScanAllocator allocator(allocation_data, RegisterKind::kGeneral,
+                                  temp_zone);
+    allocator.AllocateRegisters();
+    // Runs the job on this thread if no worker picked it up yet.
+    fp_job->Join();
+  }
+};
+
 struct DecideSpillingModePhase {
   DECL_PIPELINE_PHASE_CONSTANTS(DecideSpillingMode)
 
@@ -2694,6 +2754,88 @@ bool PipelineImpl::CreateGraph() {
   return true;
 }
 
+namespace {
+
+// Compute a hash of the given graph, in a way that should provide the same
+// result in multiple runs of mksnapshot, meaning the hash cannot depend on any
+// external pointer values or uncompressed heap constants. This hash can be used
+// to reject profiling data if the builtin's current code doesn't match the
+// version that was profiled. Hash collisions are not catastrophic; in the worst
+// case, we just defer some blocks that ideally shouldn't be deferred. The
+// result value is in the valid Smi range.
+int HashGraphForPGO(Graph* graph) {
+  AccountingAllocator allocator;
+  Zone local_zone(&allocator, ZONE_NAME);
+
+  constexpr NodeId kUnassigned = static_cast<NodeId>(-1);
+
+  constexpr byte kUnvisited = 0;
+  constexpr byte kOnStack = 1;
+  constexpr byte kVisited = 2;
+
+  // Do a depth-first post-order traversal of the graph. For every node, hash:
+  //
+  //   - the node's traversal number
+  //   - the opcode
+  //   - the number of inputs
+  //   - each input node's traversal number
+  //
+  // What's a traversal number? We can't use node IDs because they're not stable
+  // build-to-build, so we assign a new number for each node as it is visited.
+
+  ZoneVector<byte> state(graph->NodeCount(), kUnvisited, &local_zone);
+  ZoneVector<NodeId> traversal_numbers(graph->NodeCount(), kUnassigned,
+                                       &local_zone);
+  ZoneStack<Node*> stack(&local_zone);
+
+  NodeId visited_count = 0;
+  size_t hash = 0;
+
+  stack.push(graph->end());
+  state[graph->end()->id()] = kOnStack;
+  traversal_numbers[graph->end()->id()] = visited_count++;
+  while (!stack.empty()) {
+    Node* n = stack.top();
+    bool pop = true;
+    for (Node* const i : n->inputs()) {
+      if (state[i->id()] == kUnvisited) {
+        state[i->id()] = kOnStack;
+        traversal_numbers[i->id()] = visited_count++;
+        stack.push(i);
+        pop = false;
+        break;
+      }
+    }
+    if (pop) {
+      state[n->id()] = kVisited;
+      stack.pop();
+      hash = base::hash_combine(hash, traversal_numbers[n->id()], n->opcode(),
+                                n->InputCount());
+      for (Node* const i : n->inputs()) {
+        DCHECK(traversal_numbers[i->id()] != kUnassigned);
+        hash = base::hash_combine(hash, traversal_numbers[i->id()]);
+      }
+    }
+  }
+  return Smi(IntToSmi(static_cast<int>(hash))).value();
+}
+
+// Returns the name under which the block counts of an optimized JavaScript
+// function are logged with --turbo-profiling-log-js and looked up in
+// --turbo-profiling-log-file. The graph hash is part of the name rather than
+// only checked against the logged hash, so that profiles of differently
+// specialized graphs of the same function can coexist in one log.
+std::unique_ptr<char[]> JSProfileName(uint64_t function_key, int graph_hash) {
+  constexpr size_t kMaxLength = 48;
+  std::unique_ptr<char[]> name(new char[kMaxLength]);
+  SNPrintF(base::Vector<char>(name.get(), kMaxLength), "%s%016" PRIx64 "_%x",
+           ProfileDataFromFileConstants::kJSFunctionPrefix, function_key,
+           graph_hash);
+  return name;
+}
+
+}  // namespace
+
 bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
   PipelineData* data = this->data_;
 
@@ -2814,9 +2956,30 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
     data->node_origins()->RemoveDecorator();
   }
 
+  // Block counts of JavaScript functions are keyed by the graph right before
+  // scheduling, which is where the scheduler uses them to derive branch hints
+  // and deferred blocks.
+  const uint64_t profile_key = data->info()->profile_key();
+  int graph_hash_before_scheduling = 0;
+  if (profile_key != 0) {
+    graph_hash_before_scheduling = HashGraphForPGO(data->graph());
+    if (FLAG_turbo_profiling_log_file != nullptr) {
+      data->set_profile_data(ProfileDataFromFile::TryRead(
+          JSProfileName(profile_key, graph_hash_before_scheduling).get()));
+    }
+  }
+
   ComputeScheduledGraph();
 
-  return SelectInstructions(linkage);
+  if (!SelectInstructions(linkage)) return false;
+
+  if (FLAG_turbo_profiling_log_js && profile_key != 0) {
+    BasicBlockProfilerData* profiler_data = data->info()->profiler_data();
+    profiler_data->SetFunctionName(
+        JSProfileName(profile_key, graph_hash_before_scheduling));
+    profiler_data->SetHash(graph_hash_before_scheduling);
+  }
+  return true;
 }
 
 bool PipelineImpl::OptimizeGraphForMidTier(Linkage* linkage) {
@@ -2898,74 +3061,6 @@ bool PipelineImpl::OptimizeGraphForMidTier(Linkage* linkage) {
   return SelectInstructions(linkage);
 }
 
-namespace {
-
-// Compute a hash of the given graph, in a way that should provide the same
-// result in multiple runs of mksnapshot, meaning the hash cannot depend on any
-// external pointer values or uncompressed heap constants. This hash can be used
-// to reject profiling data if the builtin's current code doesn't match the
-// version that was profiled. Hash collisions are not catastrophic; in the worst
-// case, we just defer some blocks that ideally shouldn't be deferred. The
-// result value is in the valid Smi range.
-int HashGraphForPGO(Graph* graph) {
-  AccountingAllocator allocator;
-  Zone local_zone(&allocator, ZONE_NAME);
-
-  constexpr NodeId kUnassigned = static_cast<NodeId>(-1);
-
-  constexpr byte kUnvisited = 0;
-  constexpr byte kOnStack = 1;
-  constexpr byte kVisited = 2;
-
-  // Do a depth-first post-order traversal of the graph. For every node, hash:
-  //
-  //   - the node's traversal number
-  //   - the opcode
-  //   - the number of inputs
-  //   - each input node's traversal number
-  //
-  // What's a traversal number? We can't use node IDs because they're not stable
-  // build-to-build, so we assign a new number for each node as it is visited.
-
-  ZoneVector<byte> state(graph->NodeCount(), kUnvisited, &local_zone);
-  ZoneVector<NodeId> traversal_numbers(graph->NodeCount(), kUnassigned,
-                                       &local_zone);
-  ZoneStack<Node*> stack(&local_zone);
-
-  NodeId visited_count = 0;
-  size_t hash = 0;
-
-  stack.push(graph->end());
-  state[graph->end()->id()] = kOnStack;
-  traversal_numbers[graph->end()->id()] = visited_count++;
-  while (!stack.empty()) {
-    Node* n = stack.top();
-    bool pop = true;
-    for (Node* const i : n->inputs()) {
-      if (state[i->id()] == kUnvisited) {
-        state[i->id()] = kOnStack;
-        traversal_numbers[i->id()] = visited_count++;
-        stack.push(i);
-        pop = false;
-        break;
-      }
-    }
-    if (pop) {
-      state[n->id()] = kVisited;
-      stack.pop();
-      hash = base::hash_combine(hash, traversal_numbers[n->id()], n->opcode(),
-                                n->InputCount());
-      for (Node* const i : n->inputs()) {
-        DCHECK(traversal_numbers[i->id()] != kUnassigned);
-        hash = base::hash_combine(hash, traversal_numbers[i->id()]);
-      }
-    }
-  }
-  return Smi(IntToSmi(static_cast<int>(hash))).value();
-}
-
-}  // namespace
-
 MaybeHandle<Code> Pipeline::GenerateCodeForCodeStub(
     Isolate* isolate, CallDescriptor* call_descriptor, Graph* graph,
     JSGraph* jsgraph, SourcePositionTable* source_positions, CodeKind kind,
@@ -3806,6 +3901,12 @@ void PipelineImpl::AllocateRegistersForTopTier(
     verifier = verifier_zone->New<RegisterAllocatorVerifier>(
         verifier_zone.get(), config, data->sequence(), data->frame());
   }
+  // Holds the live ranges split by the concurrent floating-point register
+  // allocator, so it has to outlive the register allocation zone. The zone
+  // is created and returned on this thread, and ZoneStats only reads its
+  // size outside of the phase that the worker thread allocates in.
+  ZoneStats::Scope fp_allocation_zone_scope(data->zone_stats(),
+                                            kFPRegisterAllocationZoneName);
 
 #ifdef DEBUG
   data_->sequence()->ValidateEdgeSplitForm();
@@ -3838,10 +3939,21 @@ void PipelineImpl::AllocateRegistersForTopTier(
         "PreAllocation", data->top_tier_register_allocation_data());
   }
 
-  Run<AllocateGeneralRegistersPhase<LinearScanAllocator>>();
+  // Posting a job only pays off for large functions. Tracing is not
+  // thread-safe.
+  static constexpr size_t kMinInstructionsForParallelAllocation = 2000;
+  if (FLAG_turbo_parallel_register_allocation &&
+      data->sequence()->HasFPVirtualRegisters() &&
+      data->sequence()->instructions().size() >=
+          kMinInstructionsForParallelAllocation &&
+      !info()->trace_turbo_allocation()) {
+    Run<AllocateRegistersInParallelPhase>(fp_allocation_zone_scope.zone());
+  } else {
+    Run<AllocateGeneralRegistersPhase<LinearScanAllocator>>();
 
-  if (data->sequence()->HasFPVirtualRegisters()) {
-    Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
+    if (data->sequence()->HasFPVirtualRegisters()) {
+      Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
+    }
   }
 
   Run<DecideSpillingModePhase>();
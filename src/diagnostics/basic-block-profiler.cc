@@ -9,6 +9,8 @@
 #include <sstream>
 
 #include "src/base/lazy-instance.h"
+#include "src/builtins/profile-data-reader.h"
+#include "src/flags/flags.h"
 #include "src/heap/heap-inl.h"
 #include "src/objects/shared-function-info-inl.h"
 
@@ -146,6 +148,13 @@ void BasicBlockProfiler::Print(std::ostream& os, Isolate* isolate) {
   os << "---- Start Profiling Data ----" << std::endl;
   for (const auto& data : data_list_) {
     os << *data;
+    // Optimized JavaScript functions are logged for profile-guided
+    // optimization in later runs.
+    if (FLAG_turbo_profiling_log_js &&
+        data->function_name_.rfind(
+            ProfileDataFromFileConstants::kJSFunctionPrefix, 0) == 0) {
+      data->Log(isolate);
+    }
   }
   HandleScope scope(isolate);
   Handle<ArrayList> list(isolate->heap()->basic_block_profiling_data(),
@@ -31,6 +31,7 @@
 #include "src/codegen/assembler-inl.h"
 #include "src/codegen/compilation-cache.h"
 #include "src/codegen/flush-instruction-cache.h"
+#include "src/codegen/optimization-hints.h"
 #include "src/common/assert-scope.h"
 #include "src/common/ptr-compr-inl.h"
 #include "src/compiler-dispatcher/lazy-compile-dispatcher.h"
@@ -3150,6 +3151,8 @@ void Isolate::Deinit() {
 
   FutexEmulation::IsolateDeinit(this);
 
+  if (FLAG_optimization_hints_file != nullptr) OptimizationHints::Flush();
+
   debug()->Unload();
 
 #if V8_ENABLE_WEBASSEMBLY
@@ -8,13 +8,16 @@
 #include "src/codegen/assembler.h"
 #include "src/codegen/compilation-cache.h"
 #include "src/codegen/compiler.h"
+#include "src/codegen/optimization-hints.h"
 #include "src/codegen/pending-optimization-table.h"
+#include "src/compiler-dispatcher/optimizing-compile-dispatcher.h"
 #include "src/diagnostics/code-tracer.h"
 #include "src/execution/execution.h"
 #include "src/execution/frames-inl.h"
 #include "src/handles/global-handles.h"
 #include "src/init/bootstrapper.h"
 #include "src/interpreter/interpreter.h"
+#include "src/objects/script-inl.h"
 #include "src/tracing/trace-event.h"
 
 namespace v8 {
@@ -25,9 +28,10 @@ static const int kOSRBytecodeSizeAllowanceBase = 119;
 
 static const int kOSRBytecodeSizeAllowancePerTick = 44;
 
-#define OPTIMIZATION_REASON_LIST(V)   \
-  V(DoNotOptimize, "do not optimize") \
-  V(HotAndStable, "hot and stable")   \
+#define OPTIMIZATION_REASON_LIST(V)        \
+  V(DoNotOptimize, "do not optimize")      \
+  V(HotAndStable, "hot and stable")        \
+  V(OptimizationHint, "optimization hint") \
   V(SmallFunction, "small function")
 
 enum class OptimizationReason : uint8_t {
@@ -127,6 +131,12 @@ void RuntimeProfiler::MaybeOptimizeFrame(JSFunction function,
                                          CodeKind code_kind) {
   if (function.IsInOptimizationQueue()) {
     TraceInOptimizationQueue(function);
+    // The function is still hot while its job waits in the queue, so move the
+    // job ahead of jobs for functions that are no longer running.
+    if (frame->is_unoptimized() &&
+        isolate_->concurrent_recompilation_enabled()) {
+      isolate_->optimizing_compile_dispatcher()->Prioritize(function);
+    }
     return;
   }
 
@@ -194,6 +204,12 @@ OptimizationReason RuntimeProfiler::ShouldOptimize(JSFunction function,
     return OptimizationReason::kDoNotOptimize;
   }
   int ticks = function.feedback_vector().profiler_ticks();
+  // Profiler ticks are reset whenever an IC of the function changes, so hints
+  // only need to be checked on the first tick with new feedback.
+  if (V8_UNLIKELY(FLAG_optimization_hints_file != nullptr) && ticks == 1 &&
+      HasOptimizationHint(function)) {
+    return OptimizationReason::kOptimizationHint;
+  }
   bool active_tier_is_turboprop = function.ActiveTierIsMidtierTurboprop();
   int ticks_for_optimization =
       FLAG_ticks_before_optimization +
@@ -220,6 +236,21 @@ OptimizationReason RuntimeProfiler::ShouldOptimize(JSFunction function,
   return OptimizationReason::kDoNotOptimize;
 }
 
+bool RuntimeProfiler::HasOptimizationHint(JSFunction function) {
+  SharedFunctionInfo shared = function.shared();
+  if (!shared.script().IsScript()) return false;
+  uint64_t id = (static_cast<uint64_t>(Script::cast(shared.script()).id())
+                 << 32) |
+                static_cast<uint32_t>(shared.StartPosition());
+  auto it = optimization_hint_keys_.find(id);
+  if (it == optimization_hint_keys_.end()) {
+    it = optimization_hint_keys_
+             .emplace(id, OptimizationHints::FunctionKey(shared))
+             .first;
+  }
+  return OptimizationHints::ShouldOptimizeEarly(function, it->second);
+}
+
 RuntimeProfiler::MarkCandidatesForOptimizationScope::
     MarkCandidatesForOptimizationScope(RuntimeProfiler* profiler)
     : handle_scope_(profiler->isolate_), profiler_(profiler) {
@@ -5,6 +5,8 @@
 #ifndef V8_EXECUTION_RUNTIME_PROFILER_H_
 #define V8_EXECUTION_RUNTIME_PROFILER_H_
 
+#include <unordered_map>
+
 #include "src/common/assert-scope.h"
 #include "src/handles/handles.h"
 #include "src/utils/allocation.h"
@@ -48,6 +50,9 @@ class RuntimeProfiler {
   bool MaybeOSR(JSFunction function, UnoptimizedFrame* frame);
   OptimizationReason ShouldOptimize(JSFunction function,
                                     BytecodeArray bytecode_array);
+  // Whether --optimization-hints-file has a hint for the current feedback of
+  // |function|.
+  bool HasOptimizationHint(JSFunction function);
   void Optimize(JSFunction function, OptimizationReason reason,
                 CodeKind code_kind);
   void Baseline(JSFunction function, OptimizationReason reason);
@@ -65,6 +70,11 @@ class RuntimeProfiler {
 
   Isolate* isolate_;
   bool any_ic_changed_;
+
+  // OptimizationHints::FunctionKey() hashes the function's source, so it is
+  // computed once per function. Keyed by script id and start position, which
+  // identify a SharedFunctionInfo within this isolate.
+  std::unordered_map<uint64_t, uint64_t> optimization_hint_keys_;
 };
 
 }  // namespace internal
@@ -448,6 +448,20 @@ DEFINE_NEG_IMPLICATION(enable_third_party_heap, concurrent_marking)
 DEFINE_BOOL_READONLY(enable_third_party_heap, V8_ENABLE_THIRD_PARTY_HEAP_BOOL,
                      "Use third-party heap")
 
+#ifdef V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL
+#define V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL true
+#else
+#define V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL false
+#endif
+
+DEFINE_BOOL_READONLY(third_party_heap_generational,
+                     V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL,
+                     "Use the card-marking barrier of the third-party heap")
+#if V8_ENABLE_WEBASSEMBLY
+// Wasm code does not emit the card-marking barrier.
+DEFINE_NEG_IMPLICATION(third_party_heap_generational, expose_wasm)
+#endif  // V8_ENABLE_WEBASSEMBLY
+
 #ifdef V8_ALLOCATION_FOLDING
 #define V8_ALLOCATION_FOLDING_BOOL true
 #else
@@ -573,6 +587,13 @@ DEFINE_BOOL_READONLY(always_promote_young_mc, true,
                      "always promote young objects during mark-compact")
 DEFINE_INT(page_promotion_threshold, 70,
            "min percentage of live bytes on a page to enable fast evacuation")
+DEFINE_BOOL(sampling_pretenuring, false,
+            "pretenure allocations without allocation sites based on the "
+            "sampled survival of their bytecode sites")
+DEFINE_NEG_IMPLICATION(enable_third_party_heap, sampling_pretenuring)
+DEFINE_INT(sampling_pretenuring_interval, 64 * KB,
+           "average number of young generation bytes between two samples of "
+           "--sampling-pretenuring")
 DEFINE_BOOL(trace_pretenuring, false,
             "trace pretenuring decisions of HAllocate instructions")
 DEFINE_BOOL(trace_pretenuring_statistics, false,
@@ -609,6 +630,10 @@ DEFINE_INT(interrupt_budget, 132 * KB,
 DEFINE_INT(
     max_bytecode_size_for_early_opt, 81,
     "Maximum bytecode length for a function to be optimized on the first tick")
+DEFINE_STRING(optimization_hints_file, nullptr,
+              "file that records which functions got optimized, with which "
+              "feedback shape, to optimize them as soon as the same feedback "
+              "shape is reached in later runs")
 
 // Flags for inline caching and feedback vectors.
 DEFINE_BOOL(use_ic, true, "use inline caching")
@@ -889,8 +914,15 @@ DEFINE_IMPLICATION(turbo_profiling_verbose, turbo_profiling)
 DEFINE_BOOL(turbo_profiling_log_builtins, false,
             "emit data about basic block usage in builtins to v8.log (requires "
             "that V8 was built with v8_enable_builtins_profiling=true)")
+DEFINE_BOOL(turbo_profiling_log_js, false,
+            "emit data about basic block usage in optimized JavaScript "
+            "functions to v8.log, for use with --turbo-profiling-log-file")
+DEFINE_IMPLICATION(turbo_profiling_log_js, turbo_profiling)
 DEFINE_BOOL(turbo_verify_allocation, DEBUG_BOOL,
             "verify register allocation in TurboFan")
+DEFINE_BOOL(turbo_parallel_register_allocation, false,
+            "allocate floating-point registers on a worker thread while "
+            "general registers are allocated in large TurboFan functions")
 DEFINE_BOOL(turbo_move_optimization, true, "optimize gap moves in TurboFan")
 DEFINE_BOOL(turbo_jt, true, "enable jump threading in TurboFan")
 DEFINE_BOOL(turbo_loop_peeling, true, "TurboFan loop peeling")
@@ -901,6 +933,10 @@ DEFINE_BOOL(turbo_escape, true, "enable escape analysis")
 DEFINE_BOOL(turbo_allocation_folding, true, "TurboFan allocation folding")
 DEFINE_BOOL(turbo_instruction_scheduling, false,
             "enable instruction scheduling in TurboFan")
+DEFINE_BOOL(turbo_instruction_scheduling_loops_only, false,
+            "restrict instruction scheduling to basic blocks that are part of "
+            "a loop (instructions are still only reordered within a single "
+            "basic block)")
 DEFINE_BOOL(turbo_stress_instruction_scheduling, false,
             "randomly schedule instructions to stress dependency tracking")
 DEFINE_IMPLICATION(turbo_stress_instruction_scheduling,
@@ -1158,6 +1194,10 @@ DEFINE_SIZE_T(max_semi_space_size, 0,
               "max size of a semi-space (in MBytes), the new space consists of "
               "two semi-spaces")
 DEFINE_INT(semi_space_growth_factor, 2, "factor by which to grow the new space")
+DEFINE_BOOL(uncommit_from_space, false,
+            "uncommit the inactive semi-space after every GC, which halves the "
+            "committed (not the reserved) memory of the young generation "
+            "between GCs at the cost of recommitting it for the next GC")
 DEFINE_SIZE_T(max_old_space_size, 0, "max size of the old space (in Mbytes)")
 DEFINE_SIZE_T(
     max_heap_size, 0,
@@ -1169,6 +1209,9 @@ DEFINE_BOOL(huge_max_old_generation_size, true,
             "Increase max size of the old space to 4 GB for x64 systems with"
             "the physical memory bigger than 16 GB")
 DEFINE_SIZE_T(initial_old_space_size, 0, "initial old space size (in Mbytes)")
+DEFINE_FLOAT(gc_pause_target, 0.0,
+             "target for the duration of GC pauses in ms, favoring short "
+             "pauses over throughput (0 means no target)")
 DEFINE_BOOL(global_gc_scheduling, true,
             "enable GC scheduling based on global memory")
 DEFINE_BOOL(gc_global, false, "always perform global GCs")
@@ -1199,6 +1242,10 @@ DEFINE_BOOL(trace_gc_freelists_verbose, false,
             "prints details of freelists of each page before and after "
             "each major garbage collection")
 DEFINE_IMPLICATION(trace_gc_freelists_verbose, trace_gc_freelists)
+DEFINE_INT(gc_freelist_strategy, 0,
+           "free list strategy of the paged spaces: 0:FreeListManyCachedOrigin "
+           "1:FreeListManyCachedFastPath 2:FreeListManyCached 3:FreeListMany "
+           "4:FreeListSizeClasses")
 DEFINE_BOOL(trace_evacuation_candidates, false,
             "Show statistics about the pages evacuation by the compaction")
 DEFINE_BOOL(
@@ -1239,6 +1286,13 @@ DEFINE_INT(scavenge_task_trigger, 80,
 DEFINE_BOOL(scavenge_separate_stack_scanning, false,
             "use a separate phase for stack scanning in scavenge")
 DEFINE_BOOL(trace_parallel_scavenge, false, "trace parallel scavenge")
+DEFINE_BOOL(numa_aware_heap, false,
+            "prefer the NUMA node of the allocating thread for new pages and "
+            "let scavenger tasks start with pages of their own node")
+DEFINE_BOOL(huge_page_heap, false,
+            "advise the OS to back the pointer compression cage and the code "
+            "range with transparent huge pages and keep pooled pages "
+            "committed so that their huge pages stay intact")
 #if MUST_WRITE_PROTECT_CODE_MEMORY
 DEFINE_BOOL_READONLY(write_protect_code_memory, true,
                      "write protect code memory")
@@ -1263,6 +1317,9 @@ DEFINE_INT(ephemeron_fixpoint_iterations, 10,
            "ephemeron algorithm")
 DEFINE_BOOL(trace_concurrent_marking, false, "trace concurrent marking")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
+DEFINE_INT(max_sweeper_tasks, 0,
+           "maximum number of concurrent sweeper tasks "
+           "(0 means the number of worker threads)")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
 DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
@@ -1276,6 +1333,9 @@ DEFINE_BOOL(track_gc_object_stats, false,
             "track object counts and memory usage")
 DEFINE_BOOL(trace_gc_object_stats, false,
             "trace object counts and memory usage")
+DEFINE_INT(gc_object_stats_sampling_interval, 0,
+           "collect live object counts and memory usage on every n-th full "
+           "GC for Isolate::GetHeapObjectStatisticsDelta (0 disables)")
 DEFINE_BOOL(trace_zone_stats, false, "trace zone memory usage")
 DEFINE_GENERIC_IMPLICATION(
     trace_zone_stats,
@@ -1327,6 +1387,15 @@ DEFINE_BOOL(always_compact, false, "Perform compaction on every full GC")
 DEFINE_BOOL(never_compact, false,
             "Never perform compaction on full GC - testing only")
 DEFINE_BOOL(compact_code_space, true, "Compact code space on full collections")
+DEFINE_BOOL(incremental_compaction, false,
+            "spread the compaction of fragmented pages over several full GCs, "
+            "evacuating one address range of a space at a time")
+DEFINE_FLOAT(compaction_pause_budget, 1.0,
+             "time in ms a full GC may spend on evacuating pages with "
+             "--incremental-compaction")
+DEFINE_BOOL(cppheap_parallel_compaction, false,
+            "plan the compaction of C++ heap spaces up front and evacuate the "
+            "spaces in parallel")
 DEFINE_BOOL(flush_baseline_code, false,
             "flush of baseline code when it has not been executed recently")
 DEFINE_BOOL(flush_bytecode, true,
@@ -1572,6 +1641,8 @@ DEFINE_BOOL(trace_compiler_dispatcher, false,
 // cpu-profiler.cc
 DEFINE_INT(cpu_profiler_sampling_interval, 1000,
            "CPU profiler sampling interval in microseconds")
+DEFINE_BOOL(cpu_profiler_parallel_symbolization, false,
+            "symbolize large batches of CPU profiler ticks on worker threads")
 
 // debugger
 DEFINE_BOOL(
@@ -1611,6 +1682,9 @@ DEFINE_BOOL(heap_profiler_trace_objects, false,
             "Dump heap object allocations/movements/size_updates")
 DEFINE_BOOL(heap_profiler_use_embedder_graph, true,
             "Use the new EmbedderGraph API to get embedder nodes")
+DEFINE_BOOL(heap_snapshot_parallel_extraction, true,
+            "walk the fields of heap objects on worker threads when taking "
+            "a heap snapshot")
 DEFINE_INT(heap_snapshot_string_limit, 1024,
            "truncate strings to this length in the heap snapshot")
 DEFINE_BOOL(heap_profiler_show_hidden_objects, false,
@@ -1845,7 +1919,7 @@ DEFINE_BOOL(target_is_simulator, false,
             "(mksnapshot only)")
 DEFINE_STRING(turbo_profiling_log_file, nullptr,
               "Path of the input file containing basic block counters for "
-              "builtins. (mksnapshot only)")
+              "builtins (mksnapshot) or optimized JavaScript functions")
 
 // On some platforms, the .text section only has execute permissions.
 DEFINE_BOOL(text_is_readable, true,
@@ -2184,6 +2258,8 @@ DEFINE_BOOL(single_threaded, false, "disable the use of background tasks")
 DEFINE_IMPLICATION(single_threaded, single_threaded_gc)
 DEFINE_NEG_IMPLICATION(single_threaded, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(single_threaded, lazy_compile_dispatcher)
+DEFINE_NEG_IMPLICATION(single_threaded, cpu_profiler_parallel_symbolization)
+DEFINE_NEG_IMPLICATION(single_threaded, heap_snapshot_parallel_extraction)
 DEFINE_NEG_IMPLICATION(single_threaded, stress_concurrent_inlining)
 
 //
@@ -2193,6 +2269,7 @@ DEFINE_BOOL(single_threaded_gc, false, "disable the use of background gc tasks")
 DEFINE_NEG_IMPLICATION(single_threaded_gc, concurrent_marking)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, concurrent_sweeping)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, parallel_compaction)
+DEFINE_NEG_IMPLICATION(single_threaded_gc, cppheap_parallel_compaction)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, parallel_marking)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, parallel_pointer_update)
 DEFINE_NEG_IMPLICATION(single_threaded_gc, parallel_scavenge)
@@ -1737,6 +1737,19 @@ void GlobalHandles::Print() {
 
 #endif
 
+PhantomGlobalHandle::PhantomGlobalHandle(Isolate* isolate, Object object)
+    : location_(isolate->global_handles()->Create(object).location()) {
+  GlobalHandles::MakeWeak(&location_);
+}
+
+PhantomGlobalHandle::~PhantomGlobalHandle() { Reset(); }
+
+void PhantomGlobalHandle::Reset() {
+  if (location_ == nullptr) return;
+  GlobalHandles::Destroy(location_);
+  location_ = nullptr;
+}
+
 EternalHandles::~EternalHandles() {
   for (Address* block : blocks_) delete[] block;
 }
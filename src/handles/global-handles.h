@@ -279,6 +279,28 @@ class GlobalHandles::PendingPhantomCallback final {
   void* embedder_fields_[v8::kEmbedderFieldsInWeakCallback];
 };
 
+// Owns a phantom global handle, which the GC resets once the object dies.
+// The object is not kept alive, and no callback is invoked. The handle refers
+// to |this|, so instances can be neither copied nor moved. Must be destroyed
+// before the GlobalHandles of the isolate.
+class V8_EXPORT_PRIVATE PhantomGlobalHandle final {
+ public:
+  PhantomGlobalHandle(Isolate* isolate, Object object);
+  ~PhantomGlobalHandle();
+  PhantomGlobalHandle(const PhantomGlobalHandle&) = delete;
+  PhantomGlobalHandle& operator=(const PhantomGlobalHandle&) = delete;
+
+  bool IsAlive() const { return location_ != nullptr; }
+  Address address() const {
+    DCHECK(IsAlive());
+    return *location_;
+  }
+  void Reset();
+
+ private:
+  Address* location_;
+};
+
 class EternalHandles final {
  public:
   EternalHandles() = default;
@@ -4,14 +4,15 @@
 
 #include "src/heap/array-buffer-sweeper.h"
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 
+#include "src/base/platform/mutex.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
+#include "src/init/v8.h"
 #include "src/objects/js-array-buffer.h"
-#include "src/tasks/cancelable-task.h"
-#include "src/tasks/task-utils.h"
 
 namespace v8 {
 namespace internal {
@@ -28,6 +29,7 @@ void ArrayBufferList::Append(ArrayBufferExtension* extension) {
   const size_t accounting_length = extension->accounting_length();
   DCHECK_GE(bytes_ + accounting_length, bytes_);
   bytes_ += accounting_length;
+  length_++;
   extension->set_next(nullptr);
 }
 
@@ -45,6 +47,7 @@ void ArrayBufferList::Append(ArrayBufferList* list) {
   }
 
   bytes_ += list->ApproximateBytes();
+  length_ += list->length_;
   *list = ArrayBufferList();
 }
 
@@ -70,32 +73,106 @@ size_t ArrayBufferList::BytesSlow() const {
 bool ArrayBufferList::IsEmpty() const {
   DCHECK_IMPLIES(head_, tail_);
   DCHECK_IMPLIES(!head_, bytes_ == 0);
+  DCHECK_EQ(!head_, length_ == 0);
   return head_ == nullptr;
 }
 
 struct ArrayBufferSweeper::SweepingJob final {
-  SweepingJob(ArrayBufferList young, ArrayBufferList old, SweepingType type)
-      : state_(SweepingState::kInProgress),
-        young_(std::move(young)),
-        old_(std::move(old)),
-        type_(type) {}
+  SweepingJob(ArrayBufferSweeper* sweeper, ArrayBufferList young,
+              ArrayBufferList old, SweepingType type)
+      : sweeper_(sweeper),
+        state_(SweepingState::kInProgress),
+        type_(type),
+        unswept_young_(young.head_),
+        unswept_young_length_(young.length_),
+        unswept_old_(old.head_),
+        unswept_old_length_(old.length_),
+        unclaimed_chunks_(NumberOfChunks(young.length_) +
+                          NumberOfChunks(old.length_)),
+        unfinished_chunks_(unclaimed_chunks_.load()) {
+    DCHECK_GT(unclaimed_chunks_.load(), 0);
+    DCHECK_IMPLIES(type_ == SweepingType::kYoung, old.IsEmpty());
+  }
 
-  void Sweep();
-  void SweepYoung();
-  void SweepFull();
-  ArrayBufferList SweepListFull(ArrayBufferList* list);
+  // Sweeps chunks until none are left to claim. Can be invoked from several
+  // threads at once.
+  void Sweep(JobDelegate* delegate);
+  SweepingType type() const { return type_; }
+  size_t UnclaimedChunks() const {
+    return unclaimed_chunks_.load(std::memory_order_relaxed);
+  }
 
  private:
-  CancelableTaskManager::Id id_ = CancelableTaskManager::kInvalidTaskId;
+  // A run of consecutive extensions of the young or the old list.
+  struct Chunk {
+    ArrayBufferExtension* head;
+    size_t length;
+  };
+
+  // Number of extensions that a worker claims at once.
+  static const size_t kChunkLength = 1024;
+  // Freed bytes are credited to the external memory counters in chunks of
+  // this size during sweeping.
+  static const size_t kFreedBytesFlushThreshold = 1 * MB;
+
+  static size_t NumberOfChunks(size_t length) {
+    return (length + kChunkLength - 1) / kChunkLength;
+  }
+
+  bool ClaimChunk(Chunk* chunk);
+  void SweepChunk(const Chunk& chunk);
+  void AccountFreedBytes(size_t bytes, size_t* pending_bytes);
+  void FlushFreedBytes(size_t* pending_bytes);
+
+  ArrayBufferSweeper* const sweeper_;
   std::atomic<SweepingState> state_;
+  const SweepingType type_;
+
+  // Guards the heads of the lists that are not claimed yet.
+  base::Mutex claim_mutex_;
+  ArrayBufferExtension* unswept_young_;
+  size_t unswept_young_length_;
+  ArrayBufferExtension* unswept_old_;
+  size_t unswept_old_length_;
+  std::atomic<size_t> unclaimed_chunks_;
+  std::atomic<size_t> unfinished_chunks_;
+
+  // Surviving extensions, including the ones promoted out of the young list
+  // into |old_|.
+  base::Mutex result_mutex_;
   ArrayBufferList young_;
   ArrayBufferList old_;
-  const SweepingType type_;
-  std::atomic<size_t> freed_bytes_{0};
 
   friend class ArrayBufferSweeper;
 };
 
+class ArrayBufferSweeper::SweepingJobTask final : public JobTask {
+ public:
+  SweepingJobTask(Heap* heap, SweepingJob* job) : heap_(heap), job_(job) {}
+
+  void Run(JobDelegate* delegate) final {
+    if (delegate->IsJoiningThread()) {
+      // The main thread is accounted in MC_COMPLETE_SWEEP_ARRAY_BUFFERS.
+      job_->Sweep(delegate);
+      return;
+    }
+    GCTracer::Scope::ScopeId scope_id =
+        job_->type() == SweepingType::kYoung
+            ? GCTracer::Scope::BACKGROUND_YOUNG_ARRAY_BUFFER_SWEEP
+            : GCTracer::Scope::BACKGROUND_FULL_ARRAY_BUFFER_SWEEP;
+    TRACE_GC_EPOCH(heap_->tracer(), scope_id, ThreadKind::kBackground);
+    job_->Sweep(delegate);
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const final {
+    return job_->UnclaimedChunks();
+  }
+
+ private:
+  Heap* const heap_;
+  SweepingJob* const job_;
+};
+
 ArrayBufferSweeper::ArrayBufferSweeper(Heap* heap) : heap_(heap) {}
 
 ArrayBufferSweeper::~ArrayBufferSweeper() {
@@ -108,28 +185,13 @@ void ArrayBufferSweeper::EnsureFinished() {
   if (!sweeping_in_progress()) return;
 
   TRACE_GC(heap_->tracer(), GCTracer::Scope::MC_COMPLETE_SWEEP_ARRAY_BUFFERS);
-  TryAbortResult abort_result =
-      heap_->isolate()->cancelable_task_manager()->TryAbort(job_->id_);
-
-  switch (abort_result) {
-    case TryAbortResult::kTaskAborted:
-      // Task has not run, so we need to run it synchronously here.
-      job_->Sweep();
-      break;
-    case TryAbortResult::kTaskRemoved:
-      // Task was removed, but did actually run, just ensure we are in the right
-      // state.
-      CHECK_EQ(SweepingState::kDone, job_->state_);
-      break;
-    case TryAbortResult::kTaskRunning: {
-      // Task is running. Wait until task is finished with its work.
-      base::MutexGuard guard(&sweeping_mutex_);
-      while (job_->state_ != SweepingState::kDone) {
-        job_finished_.Wait(&sweeping_mutex_);
-      }
-      break;
-    }
+  if (job_handle_) {
+    // Lets the main thread sweep the chunks that no worker has claimed yet and
+    // waits for the workers.
+    job_handle_->Join();
+    job_handle_.reset();
   }
+  CHECK_EQ(SweepingState::kDone, job_->state_);
 
   Finalize();
   DCHECK_LE(heap_->backing_store_bytes(), SIZE_MAX);
@@ -140,6 +202,11 @@ void ArrayBufferSweeper::FinishIfDone() {
   if (sweeping_in_progress()) {
     DCHECK(job_);
     if (job_->state_ == SweepingState::kDone) {
+      // All chunks are swept; joining only waits for workers to return.
+      if (job_handle_) {
+        job_handle_->Join();
+        job_handle_.reset();
+      }
       Finalize();
     }
   }
@@ -154,20 +221,11 @@ void ArrayBufferSweeper::RequestSweep(SweepingType type) {
   Prepare(type);
   if (!heap_->IsTearingDown() && !heap_->ShouldReduceMemory() &&
       FLAG_concurrent_array_buffer_sweeping) {
-    auto task = MakeCancelableTask(heap_->isolate(), [this, type] {
-      GCTracer::Scope::ScopeId scope_id =
-          type == SweepingType::kYoung
-              ? GCTracer::Scope::BACKGROUND_YOUNG_ARRAY_BUFFER_SWEEP
-              : GCTracer::Scope::BACKGROUND_FULL_ARRAY_BUFFER_SWEEP;
-      TRACE_GC_EPOCH(heap_->tracer(), scope_id, ThreadKind::kBackground);
-      base::MutexGuard guard(&sweeping_mutex_);
-      job_->Sweep();
-      job_finished_.NotifyAll();
-    });
-    job_->id_ = task->id();
-    V8::GetCurrentPlatform()->CallOnWorkerThread(std::move(task));
+    job_handle_ = V8::GetCurrentPlatform()->PostJob(
+        TaskPriority::kUserVisible,
+        std::make_unique<SweepingJobTask>(heap_, job_.get()));
   } else {
-    job_->Sweep();
+    job_->Sweep(nullptr);
     Finalize();
   }
 }
@@ -176,13 +234,13 @@ void ArrayBufferSweeper::Prepare(SweepingType type) {
   DCHECK(!sweeping_in_progress());
   switch (type) {
     case SweepingType::kYoung: {
-      job_ = std::make_unique<SweepingJob>(std::move(young_), ArrayBufferList(),
-                                           type);
+      job_ = std::make_unique<SweepingJob>(this, std::move(young_),
+                                           ArrayBufferList(), type);
       young_ = ArrayBufferList();
     } break;
     case SweepingType::kFull: {
-      job_ = std::make_unique<SweepingJob>(std::move(young_), std::move(old_),
-                                           type);
+      job_ = std::make_unique<SweepingJob>(this, std::move(young_),
+                                           std::move(old_), type);
       young_ = ArrayBufferList();
       old_ = ArrayBufferList();
     } break;
@@ -193,11 +251,9 @@ void ArrayBufferSweeper::Prepare(SweepingType type) {
 void ArrayBufferSweeper::Finalize() {
   DCHECK(sweeping_in_progress());
   CHECK_EQ(job_->state_, SweepingState::kDone);
+  DCHECK_NULL(job_handle_);
   young_.Append(&job_->young_);
   old_.Append(&job_->old_);
-  const size_t freed_bytes =
-      job_->freed_bytes_.exchange(0, std::memory_order_relaxed);
-  DecrementExternalMemoryCounters(freed_bytes);
   job_.reset();
   DCHECK(!sweeping_in_progress());
 }
@@ -269,79 +325,85 @@ void ArrayBufferSweeper::DecrementExternalMemoryCounters(size_t bytes) {
   heap_->update_external_memory(-static_cast<int64_t>(bytes));
 }
 
-void ArrayBufferSweeper::SweepingJob::Sweep() {
-  CHECK_EQ(state_, SweepingState::kInProgress);
-  switch (type_) {
-    case SweepingType::kYoung:
-      SweepYoung();
-      break;
-    case SweepingType::kFull:
-      SweepFull();
-      break;
+void ArrayBufferSweeper::SweepingJob::Sweep(JobDelegate* delegate) {
+  while (!delegate || !delegate->ShouldYield()) {
+    Chunk chunk;
+    if (!ClaimChunk(&chunk)) return;
+    SweepChunk(chunk);
+    if (unfinished_chunks_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      state_ = SweepingState::kDone;
+      return;
+    }
   }
-  state_ = SweepingState::kDone;
 }
 
-void ArrayBufferSweeper::SweepingJob::SweepFull() {
-  DCHECK_EQ(SweepingType::kFull, type_);
-  ArrayBufferList promoted = SweepListFull(&young_);
-  ArrayBufferList survived = SweepListFull(&old_);
-
-  old_ = std::move(promoted);
-  old_.Append(&survived);
+bool ArrayBufferSweeper::SweepingJob::ClaimChunk(Chunk* chunk) {
+  base::MutexGuard guard(&claim_mutex_);
+  const bool young = unswept_young_ != nullptr;
+  ArrayBufferExtension** head = young ? &unswept_young_ : &unswept_old_;
+  size_t* length = young ? &unswept_young_length_ : &unswept_old_length_;
+  if (*head == nullptr) return false;
+  chunk->head = *head;
+  chunk->length = std::min(*length, kChunkLength);
+  // Unclaimed extensions are not touched by other threads, so their links can
+  // be followed to the start of the next chunk.
+  ArrayBufferExtension* next = *head;
+  for (size_t i = 0; i < chunk->length; i++) next = next->next();
+  *head = next;
+  *length -= chunk->length;
+  DCHECK_EQ(*head == nullptr, *length == 0);
+  unclaimed_chunks_.fetch_sub(1, std::memory_order_relaxed);
+  return true;
 }
 
-ArrayBufferList ArrayBufferSweeper::SweepingJob::SweepListFull(
-    ArrayBufferList* list) {
-  ArrayBufferExtension* current = list->head_;
-  ArrayBufferList survivor_list;
-
-  while (current) {
+void ArrayBufferSweeper::SweepingJob::SweepChunk(const Chunk& chunk) {
+  CHECK_EQ(state_, SweepingState::kInProgress);
+  // Survivors of a full sweep all end up in the old list.
+  const bool full = type_ == SweepingType::kFull;
+  ArrayBufferList young;
+  ArrayBufferList old;
+  size_t pending_bytes = 0;
+
+  ArrayBufferExtension* current = chunk.head;
+  for (size_t i = 0; i < chunk.length; i++) {
     ArrayBufferExtension* next = current->next();
 
-    if (!current->IsMarked()) {
+    if (full ? !current->IsMarked() : !current->IsYoungMarked()) {
       const size_t bytes = current->accounting_length();
       delete current;
-      if (bytes) freed_bytes_.fetch_add(bytes, std::memory_order_relaxed);
-    } else {
+      AccountFreedBytes(bytes, &pending_bytes);
+    } else if (full) {
       current->Unmark();
-      survivor_list.Append(current);
-    }
-
-    current = next;
-  }
-
-  *list = ArrayBufferList();
-  return survivor_list;
-}
-
-void ArrayBufferSweeper::SweepingJob::SweepYoung() {
-  DCHECK_EQ(SweepingType::kYoung, type_);
-  ArrayBufferExtension* current = young_.head_;
-
-  ArrayBufferList new_young;
-  ArrayBufferList new_old;
-
-  while (current) {
-    ArrayBufferExtension* next = current->next();
-
-    if (!current->IsYoungMarked()) {
-      size_t bytes = current->accounting_length();
-      delete current;
-      if (bytes) freed_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+      old.Append(current);
     } else if (current->IsYoungPromoted()) {
       current->YoungUnmark();
-      new_old.Append(current);
+      old.Append(current);
     } else {
       current->YoungUnmark();
-      new_young.Append(current);
+      young.Append(current);
     }
 
     current = next;
   }
 
-  old_ = new_old;
-  young_ = new_young;
+  FlushFreedBytes(&pending_bytes);
+  base::MutexGuard guard(&result_mutex_);
+  young_.Append(&young);
+  old_.Append(&old);
+}
+
+void ArrayBufferSweeper::SweepingJob::AccountFreedBytes(size_t bytes,
+                                                        size_t* pending_bytes) {
+  *pending_bytes += bytes;
+  if (*pending_bytes >= kFreedBytesFlushThreshold) {
+    FlushFreedBytes(pending_bytes);
+  }
+}
+
+void ArrayBufferSweeper::SweepingJob::FlushFreedBytes(size_t* pending_bytes) {
+  // The counters are atomic and may be decremented from background threads.
+  sweeper_->DecrementExternalMemoryCounters(*pending_bytes);
+  *pending_bytes = 0;
 }
 
 }  // namespace internal
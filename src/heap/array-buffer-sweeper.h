@@ -7,10 +7,9 @@
 
 #include <memory>
 
+#include "include/v8-platform.h"
 #include "src/base/logging.h"
-#include "src/base/platform/mutex.h"
 #include "src/objects/js-array-buffer.h"
-#include "src/tasks/cancelable-task.h"
 
 namespace v8 {
 namespace internal {
@@ -37,12 +36,17 @@ struct ArrayBufferList final {
   // `ArrayBufferExtension` is still in the list. The extension will only be
   // dropped on next sweep.
   size_t bytes_ = 0;
+  // Number of extensions in the list, including detached ones.
+  size_t length_ = 0;
 
   friend class ArrayBufferSweeper;
 };
 
 // The ArrayBufferSweeper iterates and deletes ArrayBufferExtensions
-// concurrently to the application.
+// concurrently to the application. The young and the old list are split into
+// chunks that are swept in parallel. Freed bytes are credited to the external
+// memory counters while sweeping progresses, so that allocations during
+// sweeping do not see inflated external memory and trigger GCs.
 class ArrayBufferSweeper final {
  public:
   enum class SweepingType { kYoung, kFull };
@@ -69,6 +73,7 @@ class ArrayBufferSweeper final {
 
  private:
   struct SweepingJob;
+  class SweepingJobTask;
 
   enum class SweepingState { kInProgress, kDone };
 
@@ -89,8 +94,7 @@ class ArrayBufferSweeper final {
 
   Heap* const heap_;
   std::unique_ptr<SweepingJob> job_;
-  base::Mutex sweeping_mutex_;
-  base::ConditionVariable job_finished_;
+  std::unique_ptr<JobHandle> job_handle_;
   ArrayBufferList young_;
   ArrayBufferList old_;
 };
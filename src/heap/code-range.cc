@@ -123,6 +123,7 @@ bool CodeRange::InitReservation(v8::PageAllocator* page_allocator,
       requested, page_allocator->AllocatePageSize());
 
   if (!VirtualMemoryCage::InitReservation(params)) return false;
+  AdviseHugePages(reservation()->region());
 
   if (V8_EXTERNAL_CODE_SPACE_BOOL) {
     // Ensure that the code range does not cross the 4Gb boundary and thus
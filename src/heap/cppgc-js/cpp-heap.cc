@@ -338,6 +338,7 @@ CppHeap::CppHeap(
   // garbage collections.
   no_gc_scope_++;
   stats_collector()->RegisterObserver(this);
+  compactor_.set_parallel_compaction(FLAG_cppheap_parallel_compaction);
 }
 
 CppHeap::~CppHeap() {
@@ -39,6 +39,8 @@ class V8_EXPORT_PRIVATE CppHeap final
     explicit MetricRecorderAdapter(CppHeap& cpp_heap) : cpp_heap_(cpp_heap) {}
 
     void AddMainThreadEvent(const FullCycle& cppgc_event) final;
+    // The unified heap only runs full cycles.
+    void AddMainThreadEvent(const YoungCycle& cppgc_event) final {}
     void AddMainThreadEvent(const MainThreadIncrementalMark& cppgc_event) final;
     void AddMainThreadEvent(
         const MainThreadIncrementalSweep& cppgc_event) final;
@@ -4,12 +4,15 @@
 
 #include "src/heap/cppgc/compactor.h"
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <numeric>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "include/cppgc/macros.h"
+#include "include/cppgc/platform.h"
 #include "src/heap/cppgc/compaction-worklists.h"
 #include "src/heap/cppgc/globals.h"
 #include "src/heap/cppgc/heap-base.h"
@@ -423,6 +426,282 @@ void CompactSpace(NormalPageSpace* space,
   // Sweeping will verify object start bitmap of compacted space.
 }
 
+// Parallel compaction follows the LISP-2 scheme: instead of updating slots
+// while objects slide down, the destination of every live object is computed
+// up front and recorded slots are updated to final locations before any object
+// moves. This leaves compactable spaces independent of each other so that
+// they can be evacuated in parallel, with only planning and slot updates
+// remaining on the mutator thread.
+class RelocationPlan final {
+ public:
+  struct Move {
+    // Header addresses in the source and destination pages.
+    Address from;
+    Address to;
+    size_t size;
+  };
+
+  // Removes the pages from |space|, finalizes dead objects, and computes the
+  // destinations of live objects. Must be called on the mutator thread.
+  explicit RelocationPlan(NormalPageSpace* space);
+
+  RelocationPlan(const RelocationPlan&) = delete;
+  RelocationPlan& operator=(const RelocationPlan&) = delete;
+
+  const std::vector<NormalPage*>& pages() const { return pages_; }
+
+  // Returns the address |value| will have after evacuation. |value| may be an
+  // inner pointer of a live object on |page|.
+  const void* Forward(const NormalPage* page, const void* value) const;
+
+  // Copies live objects to their destinations. May run concurrently with the
+  // evacuation of other spaces.
+  void Evacuate();
+
+  // Returns pages to the space and releases pages that were not compacted
+  // into. Must be called on the mutator thread.
+  void Finish();
+
+ private:
+  NormalPageSpace* space_;
+  std::vector<NormalPage*> pages_;
+  // Moves in evacuation order, i.e. grouped by source page in the order of
+  // |pages_| and sorted by address within a page.
+  std::vector<Move> moves_;
+  // Range in |moves_| for each source page.
+  std::unordered_map<const NormalPage*, std::pair<size_t, size_t>> page_moves_;
+  // Bytes compacted into each page of |pages_|.
+  std::vector<size_t> used_bytes_;
+};
+
+RelocationPlan::RelocationPlan(NormalPageSpace* space) : space_(space) {
+#ifdef V8_USE_ADDRESS_SANITIZER
+  UnmarkedObjectsPoisoner().Traverse(*space);
+#endif  // V8_USE_ADDRESS_SANITIZER
+
+  DCHECK(space->is_compactable());
+  space->free_list().Clear();
+
+  for (BasePage* page : space->RemoveAllPages()) {
+    pages_.push_back(NormalPage::From(page));
+  }
+  if (pages_.empty()) return;
+  used_bytes_.resize(pages_.size(), 0);
+
+  // Like the sliding compaction in CompactSpace(), objects only ever move to
+  // lower addresses on the same page or to earlier pages, which have been
+  // evacuated already by the time they are compacted into.
+  size_t current_page = 0;
+  size_t used_bytes_in_current_page = 0;
+  for (NormalPage* page : pages_) {
+    const size_t first_move = moves_.size();
+    for (Address header_address = page->PayloadStart();
+         header_address < page->PayloadEnd();) {
+      HeapObjectHeader* header =
+          reinterpret_cast<HeapObjectHeader*>(header_address);
+      const size_t size = header->AllocatedSize();
+      DCHECK_GT(size, 0u);
+      DCHECK_LT(size, kPageSize);
+
+      if (header->IsFree()) {
+        ASAN_UNPOISON_MEMORY_REGION(header_address, size);
+        header_address += size;
+        continue;
+      }
+
+      if (!header->IsMarked()) {
+        header->Finalize();
+#if DEBUG || defined(V8_USE_MEMORY_SANITIZER) || \
+    defined(V8_USE_ADDRESS_SANITIZER)
+        ZapMemory(header, size);
+#endif
+        header_address += size;
+        continue;
+      }
+
+      if (pages_[current_page]->PayloadStart() + used_bytes_in_current_page +
+              size >
+          pages_[current_page]->PayloadEnd()) {
+        used_bytes_[current_page] = used_bytes_in_current_page;
+        current_page++;
+        used_bytes_in_current_page = 0;
+      }
+      moves_.push_back(
+          {header_address,
+           pages_[current_page]->PayloadStart() + used_bytes_in_current_page,
+           size});
+      used_bytes_in_current_page += size;
+      header_address += size;
+    }
+    page_moves_.emplace(page, std::make_pair(first_move, moves_.size()));
+  }
+  used_bytes_[current_page] = used_bytes_in_current_page;
+}
+
+const void* RelocationPlan::Forward(const NormalPage* page,
+                                    const void* value) const {
+  // The object start bitmap still reflects the pre-compaction layout.
+  const HeapObjectHeader& header = page->ObjectHeaderFromInnerAddress(value);
+  const Address object =
+      reinterpret_cast<Address>(const_cast<HeapObjectHeader*>(&header));
+  const auto range = page_moves_.find(page);
+  DCHECK_NE(page_moves_.end(), range);
+  const auto begin = moves_.begin() + range->second.first;
+  const auto end = moves_.begin() + range->second.second;
+  const auto move = std::lower_bound(
+      begin, end, object,
+      [](const Move& candidate, Address from) {
+        return candidate.from < from;
+      });
+  DCHECK(move != end && move->from == object);
+  return move->to + (static_cast<ConstAddress>(value) - object);
+}
+
+void RelocationPlan::Evacuate() {
+  for (NormalPage* page : pages_) {
+    page->object_start_bitmap().Clear();
+  }
+  for (const Move& move : moves_) {
+    HeapObjectHeader* header = reinterpret_cast<HeapObjectHeader*>(move.from);
+#if !defined(CPPGC_YOUNG_GENERATION)
+    header->Unmark();
+#endif
+    ASAN_UNPOISON_MEMORY_REGION(header->ObjectStart(), header->ObjectSize());
+    // Source and destination may overlap when sliding within a page.
+    if (move.to != move.from) memmove(move.to, move.from, move.size);
+    NormalPage::From(BasePage::FromPayload(move.to))
+        ->object_start_bitmap()
+        .SetBit(move.to);
+  }
+}
+
+void RelocationPlan::Finish() {
+  for (size_t i = 0; i < pages_.size(); ++i) {
+    NormalPage* page = pages_[i];
+    const size_t used_bytes = used_bytes_[i];
+    if (used_bytes == 0) {
+      SetMemoryInaccessible(page->PayloadStart(), page->PayloadSize());
+      NormalPage::Destroy(page);
+      continue;
+    }
+    space_->AddPage(page);
+    if (used_bytes != page->PayloadSize()) {
+      const size_t freed_size = page->PayloadSize() - used_bytes;
+      Address free_start = page->PayloadStart() + used_bytes;
+      SetMemoryInaccessible(free_start, freed_size);
+      space_->free_list().Add({free_start, freed_size});
+      page->object_start_bitmap().SetBit(free_start);
+    }
+  }
+}
+
+class EvacuationTask final : public cppgc::JobTask {
+ public:
+  EvacuationTask(HeapBase& heap,
+                 const std::vector<std::unique_ptr<RelocationPlan>>& plans)
+      : heap_(heap), plans_(plans), remaining_plans_(plans.size()) {}
+
+  void Run(cppgc::JobDelegate* delegate) final {
+    StatsCollector::EnabledConcurrentScope stats_scope(
+        heap_.stats_collector(), StatsCollector::kConcurrentCompactEvacuate);
+    for (size_t index = next_plan_.fetch_add(1, std::memory_order_relaxed);
+         index < plans_.size();
+         index = next_plan_.fetch_add(1, std::memory_order_relaxed)) {
+      plans_[index]->Evacuate();
+      remaining_plans_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t /* active_worker_count */) const final {
+    return remaining_plans_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  HeapBase& heap_;
+  const std::vector<std::unique_ptr<RelocationPlan>>& plans_;
+  std::atomic<size_t> next_plan_{0};
+  std::atomic<size_t> remaining_plans_;
+};
+
+void CompactSpacesInParallel(
+    HeapBase& heap, const std::vector<NormalPageSpace*>& spaces,
+    CompactionWorklists::MovableReferencesWorklist* slots_worklist) {
+  using MovableReference = CompactionWorklists::MovableReference;
+  StatsCollector* stats_collector = heap.stats_collector();
+
+  // Slots are filtered before planning as planning finalizes dead objects.
+  std::vector<MovableReference*> slots;
+  {
+    StatsCollector::EnabledScope stats_scope(stats_collector,
+                                             StatsCollector::kCompactPlan);
+    std::unordered_set<MovableReference*> recorded_slots;
+    CompactionWorklists::MovableReferencesWorklist::Local local(
+        slots_worklist);
+    MovableReference* slot;
+    while (local.Pop(&slot)) {
+      if (!recorded_slots.insert(slot).second) continue;
+      const void* value = *slot;
+      if (!value) continue;
+      const BasePage* slot_page = BasePage::FromInnerAddress(&heap, slot);
+      CHECK_NOT_NULL(slot_page);
+      if (!slot_page->ObjectHeaderFromInnerAddress(slot).IsMarked()) continue;
+      const BasePage* value_page = BasePage::FromInnerAddress(&heap, value);
+      CHECK_NOT_NULL(value_page);
+      if (value_page->is_large() || !value_page->space().is_compactable()) {
+        continue;
+      }
+      CHECK(value_page->ObjectHeaderFromInnerAddress(value).IsMarked());
+      slots.push_back(slot);
+    }
+  }
+
+  std::vector<std::unique_ptr<RelocationPlan>> plans;
+  std::unordered_map<const BasePage*, const RelocationPlan*> plan_for_page;
+  {
+    StatsCollector::EnabledScope stats_scope(stats_collector,
+                                             StatsCollector::kCompactPlan);
+    for (NormalPageSpace* space : spaces) {
+      auto plan = std::make_unique<RelocationPlan>(space);
+      if (plan->pages().empty()) continue;
+      for (const NormalPage* page : plan->pages()) {
+        plan_for_page.emplace(page, plan.get());
+      }
+      plans.push_back(std::move(plan));
+    }
+  }
+  if (plans.empty()) return;
+
+  {
+    StatsCollector::EnabledScope stats_scope(
+        stats_collector, StatsCollector::kCompactUpdateSlots);
+    for (MovableReference* slot : slots) {
+      const NormalPage* value_page = NormalPage::From(
+          BasePage::FromInnerAddress(&heap, const_cast<void*>(*slot)));
+      *slot = plan_for_page[value_page]->Forward(value_page, *slot);
+    }
+  }
+
+  {
+    StatsCollector::EnabledScope stats_scope(stats_collector,
+                                             StatsCollector::kCompactEvacuate);
+    std::unique_ptr<cppgc::JobHandle> handle;
+    if (plans.size() > 1) {
+      handle = heap.platform()->PostJob(
+          cppgc::TaskPriority::kUserBlocking,
+          std::make_unique<EvacuationTask>(heap, plans));
+    }
+    if (handle) {
+      // The mutator thread contributes to evacuation while joining.
+      handle->Join();
+    } else {
+      for (auto& plan : plans) plan->Evacuate();
+    }
+  }
+
+  for (auto& plan : plans) plan->Finish();
+  // Sweeping will verify object start bitmap of compacted spaces.
+}
+
 size_t UpdateHeapResidency(const std::vector<NormalPageSpace*>& spaces) {
   return std::accumulate(spaces.cbegin(), spaces.cend(), 0u,
                          [](size_t acc, const NormalPageSpace* space) {
@@ -495,6 +774,15 @@ Compactor::CompactableSpaceHandling Compactor::CompactSpacesIfEnabled() {
   StatsCollector::EnabledScope stats_scope(heap_.heap()->stats_collector(),
                                            StatsCollector::kAtomicCompact);
 
+  if (parallel_compaction_) {
+    CompactSpacesInParallel(*heap_.heap(), compactable_spaces_,
+                            compaction_worklists_->movable_slots_worklist());
+    compaction_worklists_.reset();
+    enable_for_next_gc_for_testing_ = false;
+    is_enabled_ = false;
+    return CompactableSpaceHandling::kIgnore;
+  }
+
   MovableReferences movable_references(*heap_.heap());
 
   CompactionWorklists::MovableReferencesWorklist::Local local(
@@ -30,6 +30,13 @@ class V8_EXPORT_PRIVATE Compactor final {
                                 GarbageCollector::Config::StackState);
   CompactableSpaceHandling CompactSpacesIfEnabled();
 
+  // In parallel mode, destinations of live objects are computed before any
+  // object moves so that compactable spaces can be evacuated in parallel.
+  // Only planning and slot updates remain on the mutator thread.
+  void set_parallel_compaction(bool parallel_compaction) {
+    parallel_compaction_ = parallel_compaction;
+  }
+
   CompactionWorklists* compaction_worklists() {
     return compaction_worklists_.get();
   }
@@ -48,6 +55,7 @@ class V8_EXPORT_PRIVATE Compactor final {
   std::unique_ptr<CompactionWorklists> compaction_worklists_;
 
   bool is_enabled_ = false;
+  bool parallel_compaction_ = false;
   bool enable_for_next_gc_for_testing_ = false;
 };
 
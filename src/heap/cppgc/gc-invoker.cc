@@ -83,6 +83,19 @@ GCInvoker::GCInvokerImpl::~GCInvokerImpl() {
 
 void GCInvoker::GCInvokerImpl::CollectGarbage(GarbageCollector::Config config) {
   DCHECK_EQ(config.marking_type, cppgc::Heap::MarkingType::kAtomic);
+  if (config.collection_type ==
+      GarbageCollector::Config::CollectionType::kMinor) {
+    // Young generation GCs do not scan the stack and are thus only run from
+    // non-nestable tasks.
+    DCHECK_EQ(GarbageCollector::Config::StackState::kNoHeapPointers,
+              config.stack_state);
+    if (!gc_task_handle_ && platform_->GetForegroundTaskRunner() &&
+        platform_->GetForegroundTaskRunner()->NonNestableTasksEnabled()) {
+      gc_task_handle_ = GCTask::Post(
+          collector_, platform_->GetForegroundTaskRunner().get(), config);
+    }
+    return;
+  }
   if ((config.stack_state ==
        GarbageCollector::Config::StackState::kNoHeapPointers) ||
       (stack_support_ ==
@@ -4,6 +4,7 @@
 
 #include "src/heap/cppgc/heap-growing.h"
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 
@@ -25,6 +26,10 @@ constexpr double kMaximumLimitRatioForIncrementalGC = 0.9;
 // Minimum ratio between limit for incremental GC and limit for atomic GC
 // (to guarantee that limit is not too close to current allocated size).
 constexpr double kMinimumLimitRatioForIncrementalGC = 0.5;
+#if defined(CPPGC_YOUNG_GENERATION)
+// Maximum number of bytes allocated between two young generation GCs.
+constexpr size_t kMaximumYoungGenerationSize = 1 * kMB;
+#endif  // defined(CPPGC_YOUNG_GENERATION)
 }  // namespace
 
 class HeapGrowing::HeapGrowingImpl final
@@ -50,6 +55,9 @@ class HeapGrowing::HeapGrowingImpl final
 
  private:
   void ConfigureLimit(size_t allocated_object_size);
+#if defined(CPPGC_YOUNG_GENERATION)
+  void ConfigureYoungGenerationLimit(size_t allocated_object_size);
+#endif  // defined(CPPGC_YOUNG_GENERATION)
 
   GarbageCollector* collector_;
   StatsCollector* stats_collector_;
@@ -57,6 +65,9 @@ class HeapGrowing::HeapGrowingImpl final
   size_t initial_heap_size_ = 1 * kMB;
   size_t limit_for_atomic_gc_ = 0;       // See ConfigureLimit().
   size_t limit_for_incremental_gc_ = 0;  // See ConfigureLimit().
+#if defined(CPPGC_YOUNG_GENERATION)
+  size_t limit_for_young_gc_ = 0;  // See ConfigureYoungGenerationLimit().
+#endif  // defined(CPPGC_YOUNG_GENERATION)
 
   SingleThreadedHandle gc_task_handle_;
 
@@ -102,14 +113,45 @@ void HeapGrowing::HeapGrowingImpl::AllocatedObjectSizeIncreased(size_t) {
         {GarbageCollector::Config::CollectionType::kMajor,
          GarbageCollector::Config::StackState::kMayContainHeapPointers,
          marking_support_, sweeping_support_});
+#if defined(CPPGC_YOUNG_GENERATION)
+  } else if (allocated_object_size > limit_for_young_gc_) {
+    collector_->CollectGarbage(
+        {GarbageCollector::Config::CollectionType::kMinor,
+         GarbageCollector::Config::StackState::kNoHeapPointers,
+         GarbageCollector::Config::MarkingType::kAtomic, sweeping_support_});
+#endif  // defined(CPPGC_YOUNG_GENERATION)
   }
 }
 
 void HeapGrowing::HeapGrowingImpl::ResetAllocatedObjectSize(
     size_t allocated_object_size) {
+#if defined(CPPGC_YOUNG_GENERATION)
+  if (stats_collector_->collection_type() ==
+      GarbageCollector::Config::CollectionType::kMinor) {
+    // Young generation GCs do not reclaim old objects. The limits for full
+    // GCs stay in place as they would otherwise move up with every promotion.
+    ConfigureYoungGenerationLimit(allocated_object_size);
+    return;
+  }
+#endif  // defined(CPPGC_YOUNG_GENERATION)
   ConfigureLimit(allocated_object_size);
 }
 
+#if defined(CPPGC_YOUNG_GENERATION)
+void HeapGrowing::HeapGrowingImpl::ConfigureYoungGenerationLimit(
+    size_t allocated_object_size) {
+  // Leave room for at least one young generation GC before incremental
+  // marking of a full GC starts.
+  const size_t distance_to_incremental_gc =
+      limit_for_incremental_gc_ > allocated_object_size
+          ? limit_for_incremental_gc_ - allocated_object_size
+          : 0;
+  limit_for_young_gc_ =
+      allocated_object_size +
+      std::min(kMaximumYoungGenerationSize, distance_to_incremental_gc / 2);
+}
+#endif  // defined(CPPGC_YOUNG_GENERATION)
+
 void HeapGrowing::HeapGrowingImpl::ConfigureLimit(
     size_t allocated_object_size) {
   const size_t size = std::max(allocated_object_size, initial_heap_size_);
@@ -138,6 +180,9 @@ void HeapGrowing::HeapGrowingImpl::ConfigureLimit(
       std::max(minimum_limit_incremental_gc,
                std::min(maximum_limit_incremental_gc,
                         limit_incremental_gc_based_on_allocation_rate));
+#if defined(CPPGC_YOUNG_GENERATION)
+  ConfigureYoungGenerationLimit(allocated_object_size);
+#endif  // defined(CPPGC_YOUNG_GENERATION)
 }
 
 void HeapGrowing::HeapGrowingImpl::DisableForTesting() {
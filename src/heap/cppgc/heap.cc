@@ -52,6 +52,20 @@ void Heap::ForceGarbageCollectionSlow(const char* source, const char* reason,
        internal::GarbageCollector::Config::IsForcedGC::kForced});
 }
 
+void Heap::ForceYoungGenerationGarbageCollectionSlow(const char* source,
+                                                     const char* reason) {
+#if defined(CPPGC_YOUNG_GENERATION)
+  internal::Heap::From(this)->CollectGarbage(
+      {internal::GarbageCollector::Config::CollectionType::kMinor,
+       StackState::kNoHeapPointers, MarkingType::kAtomic,
+       SweepingType::kAtomic,
+       internal::GarbageCollector::Config::FreeMemoryHandling::kDoNotDiscard,
+       internal::GarbageCollector::Config::IsForcedGC::kForced});
+#else   // !defined(CPPGC_YOUNG_GENERATION)
+  ForceGarbageCollectionSlow(source, reason, StackState::kNoHeapPointers);
+#endif  // !defined(CPPGC_YOUNG_GENERATION)
+}
+
 AllocationHandle& Heap::GetAllocationHandle() {
   return internal::Heap::From(this)->object_allocator();
 }
@@ -103,6 +117,13 @@ void Heap::CollectGarbage(Config config) {
 
   if (in_no_gc_scope()) return;
 
+  // Young generation GCs rely on all surviving objects being marked, which
+  // does not hold while a full GC is marking.
+  if (config.collection_type == Config::CollectionType::kMinor &&
+      IsMarking()) {
+    return;
+  }
+
   config_ = config;
 
   if (!IsMarking()) {
@@ -178,9 +199,9 @@ void Heap::FinalizeGarbageCollection(Config::StackState stack_state) {
   const size_t bytes_allocated_in_prefinalizers = ExecutePreFinalizers();
 #if CPPGC_VERIFY_HEAP
   MarkingVerifier verifier(*this, config_.collection_type);
-  verifier.Run(
-      config_.stack_state, stack_end_of_current_gc(),
-      stats_collector()->marked_bytes() + bytes_allocated_in_prefinalizers);
+  verifier.Run(config_.stack_state, stack_end_of_current_gc(),
+               stats_collector()->marked_bytes_on_current_cycle() +
+                   bytes_allocated_in_prefinalizers);
 #endif  // CPPGC_VERIFY_HEAP
 #ifndef CPPGC_ALLOW_ALLOCATIONS_IN_PREFINALIZERS
   DCHECK_EQ(0u, bytes_allocated_in_prefinalizers);
@@ -46,6 +46,19 @@ class MetricRecorder {
     double main_thread_efficiency_in_bytes_per_us;
   };
 
+  struct YoungCycle {
+    struct Phases {
+      int64_t mark_duration_us = -1;
+      int64_t weak_duration_us = -1;
+      int64_t sweep_duration_us = -1;
+    };
+
+    Phases main_thread;
+    // Young objects that survived and are old from now on.
+    int64_t promoted_bytes = -1;
+    int64_t freed_bytes = -1;
+  };
+
   struct MainThreadIncrementalMark {
     int64_t duration_us = -1;
   };
@@ -57,6 +70,7 @@ class MetricRecorder {
   virtual ~MetricRecorder() = default;
 
   virtual void AddMainThreadEvent(const FullCycle& event) {}
+  virtual void AddMainThreadEvent(const YoungCycle& event) {}
   virtual void AddMainThreadEvent(const MainThreadIncrementalMark& event) {}
   virtual void AddMainThreadEvent(const MainThreadIncrementalSweep& event) {}
 };
@@ -118,6 +118,12 @@ void StatsCollector::NotifyMarkingStarted(CollectionType collection_type,
 void StatsCollector::NotifyMarkingCompleted(size_t marked_bytes) {
   DCHECK_EQ(GarbageCollectionState::kMarking, gc_state_);
   gc_state_ = GarbageCollectionState::kSweeping;
+  current_.marked_bytes_on_current_cycle = marked_bytes;
+  if (current_.collection_type == CollectionType::kMinor) {
+    // Young generation GCs only mark young objects. Everything that survived
+    // the previous GC is old and stays alive until the next full GC.
+    marked_bytes += previous_.marked_bytes;
+  }
   current_.marked_bytes = marked_bytes;
   current_.object_size_before_sweep_bytes =
       previous_.marked_bytes + allocated_bytes_since_end_of_marking_ +
@@ -215,6 +221,19 @@ MetricRecorder::FullCycle GetFullCycleEventForMetricRecorder(
   return event;
 }
 
+MetricRecorder::YoungCycle GetYoungCycleEventForMetricRecorder(
+    int64_t atomic_mark_us, int64_t atomic_weak_us, int64_t atomic_sweep_us,
+    int64_t incremental_sweep_us, int64_t promoted_bytes,
+    int64_t freed_bytes) {
+  MetricRecorder::YoungCycle event;
+  event.main_thread.mark_duration_us = atomic_mark_us;
+  event.main_thread.weak_duration_us = atomic_weak_us;
+  event.main_thread.sweep_duration_us = atomic_sweep_us + incremental_sweep_us;
+  event.promoted_bytes = promoted_bytes;
+  event.freed_bytes = freed_bytes;
+  return event;
+}
+
 }  // namespace
 
 void StatsCollector::NotifySweepingCompleted() {
@@ -222,7 +241,18 @@ void StatsCollector::NotifySweepingCompleted() {
   gc_state_ = GarbageCollectionState::kNotRunning;
   previous_ = std::move(current_);
   current_ = Event();
-  if (metric_recorder_) {
+  if (metric_recorder_ &&
+      previous_.collection_type == CollectionType::kMinor) {
+    MetricRecorder::YoungCycle event = GetYoungCycleEventForMetricRecorder(
+        previous_.scope_data[kAtomicMark].InMicroseconds(),
+        previous_.scope_data[kAtomicWeak].InMicroseconds(),
+        previous_.scope_data[kAtomicSweep].InMicroseconds(),
+        previous_.scope_data[kIncrementalSweep].InMicroseconds(),
+        previous_.marked_bytes_on_current_cycle /* promoted */,
+        previous_.object_size_before_sweep_bytes -
+            previous_.marked_bytes /* freed */);
+    metric_recorder_->AddMainThreadEvent(event);
+  } else if (metric_recorder_) {
     MetricRecorder::FullCycle event = GetFullCycleEventForMetricRecorder(
         previous_.scope_data[kAtomicMark].InMicroseconds(),
         previous_.scope_data[kAtomicWeak].InMicroseconds(),
@@ -271,6 +301,13 @@ size_t StatsCollector::marked_bytes() const {
   return event.marked_bytes;
 }
 
+size_t StatsCollector::marked_bytes_on_current_cycle() const {
+  DCHECK_NE(GarbageCollectionState::kMarking, gc_state_);
+  const Event& event =
+      gc_state_ == GarbageCollectionState::kSweeping ? current_ : previous_;
+  return event.marked_bytes_on_current_cycle;
+}
+
 v8::base::TimeDelta StatsCollector::marking_time() const {
   DCHECK_NE(GarbageCollectionState::kMarking, gc_state_);
   // During sweeping we refer to the current Event as that already holds the
@@ -56,13 +56,18 @@ namespace internal {
   V(SweepIdleStep)                          \
   V(SweepInTask)                            \
   V(SweepOnAllocation)                      \
-  V(SweepFinalize)
+  V(SweepFinalize)                          \
+  V(CompactPlan)                            \
+  V(CompactUpdateSlots)                     \
+  V(CompactEvacuate)
 
 #define CPPGC_FOR_ALL_HISTOGRAM_CONCURRENT_SCOPES(V) \
   V(ConcurrentMark)                                  \
   V(ConcurrentSweep)
 
-#define CPPGC_FOR_ALL_CONCURRENT_SCOPES(V) V(ConcurrentMarkProcessEphemerons)
+#define CPPGC_FOR_ALL_CONCURRENT_SCOPES(V) \
+  V(ConcurrentMarkProcessEphemerons)      \
+  V(ConcurrentCompactEvacuate)
 
 // Sink for various time and memory statistics.
 class V8_EXPORT_PRIVATE StatsCollector final {
@@ -106,8 +111,11 @@ class V8_EXPORT_PRIVATE StatsCollector final {
     size_t epoch = -1;
     CollectionType collection_type = CollectionType::kMajor;
     IsForcedGC is_forced_gc = IsForcedGC::kNotForced;
-    // Marked bytes collected during marking.
+    // Marked bytes collected during marking. For young generation GCs this
+    // includes the old generation, which is treated as live.
     size_t marked_bytes = 0;
+    // Bytes marked by the marker in this cycle only.
+    size_t marked_bytes_on_current_cycle = 0;
     size_t object_size_before_sweep_bytes = -1;
     size_t memory_size_before_sweep_bytes = -1;
   };
@@ -284,12 +292,24 @@ class V8_EXPORT_PRIVATE StatsCollector final {
   // Returns the most recent marked bytes count. Should not be called during
   // marking.
   size_t marked_bytes() const;
+  // Returns the bytes marked by the most recent marking phase. Differs from
+  // marked_bytes() for young generation GCs which do not mark old objects.
+  // Should not be called during marking.
+  size_t marked_bytes_on_current_cycle() const;
   // Returns the overall duration of the most recent marking phase. Should not
   // be called during marking.
   v8::base::TimeDelta marking_time() const;
 
   double GetRecentAllocationSpeedInBytesPerMs() const;
 
+  // Returns the collection type of the running GC or, if none is running, of
+  // the most recent one.
+  CollectionType collection_type() const {
+    return gc_state_ == GarbageCollectionState::kNotRunning
+               ? previous_.collection_type
+               : current_.collection_type;
+  }
+
   const Event& GetPreviousEventForTesting() const { return previous_; }
 
   void NotifyAllocatedMemory(int64_t);
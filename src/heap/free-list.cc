@@ -6,6 +6,7 @@
 
 #include "src/base/macros.h"
 #include "src/common/globals.h"
+#include "src/flags/flags.h"
 #include "src/heap/free-list-inl.h"
 #include "src/heap/heap.h"
 #include "src/heap/memory-chunk-inl.h"
@@ -109,7 +110,22 @@ void FreeListCategory::Relink(FreeList* owner) {
 // ------------------------------------------------
 // Generic FreeList methods (alloc/free related)
 
-FreeList* FreeList::CreateFreeList() { return new FreeListManyCachedOrigin(); }
+FreeList* FreeList::CreateFreeList() {
+  switch (FLAG_gc_freelist_strategy) {
+    case 0:
+      return new FreeListManyCachedOrigin();
+    case 1:
+      return new FreeListManyCachedFastPath();
+    case 2:
+      return new FreeListManyCached();
+    case 3:
+      return new FreeListMany();
+    case 4:
+      return new FreeListSizeClasses();
+    default:
+      FATAL("Invalid FreeList strategy");
+  }
+}
 
 FreeSpace FreeList::TryFindNodeIn(FreeListCategoryType type,
                                   size_t minimum_size, size_t* node_size) {
@@ -418,6 +434,98 @@ FreeSpace FreeListManyCachedOrigin::Allocate(size_t size_in_bytes,
   }
 }
 
+// ------------------------------------------------
+// FreeListSizeClasses implementation
+
+FreeListSizeClasses::FreeListSizeClasses() {
+  STATIC_ASSERT(kMaxExactSize % kTaggedSize == 0);
+  number_of_categories_ = kNumberOfCategories;
+  last_category_ = number_of_categories_ - 1;
+  min_block_size_ = kMinBlockSize;
+  categories_ = new FreeListCategory*[number_of_categories_]();
+
+  Reset();
+}
+
+FreeListSizeClasses::~FreeListSizeClasses() { delete[] categories_; }
+
+void FreeListSizeClasses::Reset() {
+  for (int i = 0; i < kBitmapWords; i++) non_empty_categories_[i] = 0;
+  FreeList::Reset();
+}
+
+size_t FreeListSizeClasses::GuaranteedAllocatable(size_t maximum_freed) {
+  // A block either lands in an exact class, or in a class that is searched
+  // entirely when allocating a size of that class. Either way, it can serve
+  // any allocation up to its size.
+  if (maximum_freed < kMinBlockSize) return 0;
+  return maximum_freed;
+}
+
+Page* FreeListSizeClasses::GetPageForSize(size_t size_in_bytes) {
+  const FreeListCategoryType minimum_category =
+      SelectFreeListCategoryType(size_in_bytes);
+  FreeListCategoryType type = NextNonEmptyCategory(
+      IsExactCategory(minimum_category) ? minimum_category
+                                        : minimum_category + 1);
+  if (type == kInvalidCategory) {
+    // Might return a page in which |size_in_bytes| will not fit.
+    type = minimum_category;
+  }
+  return GetPageForCategoryType(type);
+}
+
+bool FreeListSizeClasses::AddCategory(FreeListCategory* category) {
+  bool was_added = FreeList::AddCategory(category);
+  if (was_added) SetCategoryNonEmpty(category->type_);
+
+#ifdef DEBUG
+  CheckBitmapIntegrity();
+#endif
+
+  return was_added;
+}
+
+void FreeListSizeClasses::RemoveCategory(FreeListCategory* category) {
+  FreeList::RemoveCategory(category);
+  if (categories_[category->type_] == nullptr) {
+    SetCategoryEmpty(category->type_);
+  }
+
+#ifdef DEBUG
+  CheckBitmapIntegrity();
+#endif
+}
+
+FreeSpace FreeListSizeClasses::Allocate(size_t size_in_bytes,
+                                        size_t* node_size,
+                                        AllocationOrigin origin) {
+  USE(origin);
+  DCHECK_GE(kMaxBlockSize, size_in_bytes);
+
+  FreeSpace node;
+  const FreeListCategoryType first_category =
+      SelectFreeListCategoryType(size_in_bytes);
+  // Only the top block of |first_category| may be too small if it is not an
+  // exact class. The top blocks of all larger classes fit.
+  for (FreeListCategoryType type = NextNonEmptyCategory(first_category);
+       type != kInvalidCategory; type = NextNonEmptyCategory(type + 1)) {
+    node = TryFindNodeIn(type, size_in_bytes, node_size);
+    if (!node.is_null()) break;
+  }
+
+  if (node.is_null() && !IsExactCategory(first_category)) {
+    node = SearchForNodeInList(first_category, size_in_bytes, node_size);
+  }
+
+  if (!node.is_null()) {
+    Page::FromHeapObject(node)->IncreaseAllocatedBytes(*node_size);
+  }
+
+  DCHECK(IsVeryLong() || Available() == SumFreeLists());
+  return node;
+}
+
 // ------------------------------------------------
 // Generic FreeList methods (non alloc/free related)
 
@@ -5,6 +5,9 @@
 #ifndef V8_HEAP_FREE_LIST_H_
 #define V8_HEAP_FREE_LIST_H_
 
+#include <algorithm>
+
+#include "src/base/bits.h"
 #include "src/base/macros.h"
 #include "src/common/globals.h"
 #include "src/heap/memory-chunk.h"
@@ -108,6 +111,7 @@ class FreeListCategory {
 
   friend class FreeList;
   friend class FreeListManyCached;
+  friend class FreeListSizeClasses;
   friend class PagedSpace;
   friend class MapSpace;
 };
@@ -121,7 +125,7 @@ class FreeListCategory {
 // categories would scatter allocation more.
 class FreeList {
  public:
-  // Creates a Freelist of the default class (FreeListLegacy for now).
+  // Creates a Freelist of the class selected by --gc-freelist-strategy.
   V8_EXPORT_PRIVATE static FreeList* CreateFreeList();
 
   virtual ~FreeList() = default;
@@ -488,6 +492,120 @@ class V8_EXPORT_PRIVATE FreeListManyCachedOrigin
                                            AllocationOrigin origin) override;
 };
 
+// Segregated free list with one exact size class per tagged word up to
+// kMaxExactSize bytes, and power-of-two classes above. Every block in an exact
+// class has the same size, so the top block of the first non-empty class that
+// is not smaller than a request always fits. A bitmap of the non-empty classes
+// finds that class in constant time. Only requests larger than kMaxExactSize
+// may have to search the blocks of their own class.
+class V8_EXPORT_PRIVATE FreeListSizeClasses : public FreeList {
+ public:
+  FreeListSizeClasses();
+  ~FreeListSizeClasses() override;
+
+  size_t GuaranteedAllocatable(size_t maximum_freed) override;
+
+  Page* GetPageForSize(size_t size_in_bytes) override;
+
+  V8_WARN_UNUSED_RESULT FreeSpace Allocate(size_t size_in_bytes,
+                                           size_t* node_size,
+                                           AllocationOrigin origin) override;
+
+  void Reset() override;
+
+  bool AddCategory(FreeListCategory* category) override;
+  void RemoveCategory(FreeListCategory* category) override;
+
+ protected:
+  static const size_t kMinBlockSize = 3 * kTaggedSize;
+  static const size_t kMaxBlockSize = MemoryChunk::kPageSize;
+  static const size_t kMaxExactSize = 256;
+
+  static const int kNumberOfExactCategories =
+      (kMaxExactSize - kMinBlockSize) / kTaggedSize + 1;
+  // Blocks larger than kMaxExactSize are kept in classes starting at
+  // kMaxExactSize + kTaggedSize, 2 * kMaxExactSize, 4 * kMaxExactSize, ...
+  // The last class holds all blocks of at least 64KB.
+  static const int kNumberOfLargeCategories = 9;
+  static const int kNumberOfCategories =
+      kNumberOfExactCategories + kNumberOfLargeCategories;
+
+  static const int kBitsPerBitmapWord = 64;
+  static const int kBitmapWords =
+      (kNumberOfCategories + kBitsPerBitmapWord - 1) / kBitsPerBitmapWord;
+
+  static bool IsExactCategory(FreeListCategoryType type) {
+    return type < kNumberOfExactCategories;
+  }
+
+  // Returns the size of the smallest block in category |type|.
+  static size_t CategoryMinSize(FreeListCategoryType type) {
+    if (IsExactCategory(type)) return kMinBlockSize + type * kTaggedSize;
+    const int large_category = type - kNumberOfExactCategories;
+    if (large_category == 0) return kMaxExactSize + kTaggedSize;
+    return kMaxExactSize << large_category;
+  }
+
+  // Return the category of blocks of |size_in_bytes| bytes.
+  FreeListCategoryType SelectFreeListCategoryType(
+      size_t size_in_bytes) override {
+    if (size_in_bytes <= kMaxExactSize) {
+      if (size_in_bytes < kMinBlockSize) return kFirstCategory;
+      return static_cast<FreeListCategoryType>(
+          (size_in_bytes - kMinBlockSize) / kTaggedSize);
+    }
+    DCHECK_LE(size_in_bytes, kMaxBlockSize);
+    const uint32_t multiple =
+        static_cast<uint32_t>(size_in_bytes / kMaxExactSize);
+    const int large_category = std::min(
+        31 - static_cast<int>(base::bits::CountLeadingZeros32(multiple)),
+        kNumberOfLargeCategories - 1);
+    return kNumberOfExactCategories + large_category;
+  }
+
+  // Returns the first non-empty category greater or equal to |type|, or
+  // kInvalidCategory if there is none.
+  FreeListCategoryType NextNonEmptyCategory(FreeListCategoryType type) const {
+    for (int word = type / kBitsPerBitmapWord; word < kBitmapWords; word++) {
+      uint64_t bits = non_empty_categories_[word];
+      if (word == type / kBitsPerBitmapWord) {
+        bits &= ~uint64_t{0} << (type % kBitsPerBitmapWord);
+      }
+      if (bits != 0) {
+        return word * kBitsPerBitmapWord +
+               base::bits::CountTrailingZeros64(bits);
+      }
+    }
+    return kInvalidCategory;
+  }
+
+  void SetCategoryNonEmpty(FreeListCategoryType type) {
+    non_empty_categories_[type / kBitsPerBitmapWord] |=
+        uint64_t{1} << (type % kBitsPerBitmapWord);
+  }
+
+  void SetCategoryEmpty(FreeListCategoryType type) {
+    non_empty_categories_[type / kBitsPerBitmapWord] &=
+        ~(uint64_t{1} << (type % kBitsPerBitmapWord));
+  }
+
+#ifdef DEBUG
+  void CheckBitmapIntegrity() {
+    for (int i = 0; i < number_of_categories_; i++) {
+      const bool non_empty = (non_empty_categories_[i / kBitsPerBitmapWord] >>
+                              (i % kBitsPerBitmapWord)) &
+                             1;
+      DCHECK_EQ(categories_[i] != nullptr, non_empty);
+    }
+  }
+#endif
+
+  uint64_t non_empty_categories_[kBitmapWords];
+
+  FRIEND_TEST(SpacesTest, FreeListSizeClassesSelectFreeListCategoryType);
+  FRIEND_TEST(SpacesTest, FreeListSizeClassesGuaranteedAllocatable);
+};
+
 }  // namespace internal
 }  // namespace v8
 
@@ -5,21 +5,27 @@
 #include "src/heap/gc-tracer.h"
 
 #include <cstdarg>
+#include <limits>
+#include <vector>
 
 #include "include/v8-metrics.h"
+#include "src/base/address-region.h"
 #include "src/base/atomic-utils.h"
 #include "src/base/strings.h"
 #include "src/common/globals.h"
 #include "src/execution/isolate.h"
 #include "src/execution/thread-id.h"
+#include "src/heap/code-range.h"
 #include "src/heap/cppgc-js/cpp-heap.h"
 #include "src/heap/cppgc/metric-recorder.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/incremental-marking.h"
 #include "src/heap/spaces.h"
+#include "src/init/v8.h"
 #include "src/logging/counters.h"
 #include "src/logging/metrics.h"
 #include "src/logging/tracing-flags.h"
+#include "src/tasks/cancelable-task.h"
 #include "src/tracing/tracing-category-observer.h"
 
 namespace v8 {
@@ -224,12 +230,16 @@ void GCTracer::ResetForTesting() {
   recorded_minor_gcs_total_.Reset();
   recorded_minor_gcs_survived_.Reset();
   recorded_compactions_.Reset();
+  recorded_concurrent_sweepings_.Reset();
   recorded_mark_compacts_.Reset();
   recorded_incremental_mark_compacts_.Reset();
   recorded_new_generation_allocations_.Reset();
   recorded_old_generation_allocations_.Reset();
   recorded_embedder_generation_allocations_.Reset();
   recorded_survival_ratios_.Reset();
+  recorded_young_generation_pauses_.Reset();
+  recorded_full_pauses_.Reset();
+  pause_histogram_ = PauseHistogram();
   start_counter_ = 0;
   average_mutator_duration_ = 0;
   average_mark_compact_duration_ = 0;
@@ -369,6 +379,7 @@ void GCTracer::Stop(GarbageCollector collector) {
       recorded_minor_gcs_survived_.Push(
           MakeBytesAndDuration(current_.survived_young_object_size, duration));
       FetchBackgroundMinorGCCounters();
+      recorded_young_generation_pauses_.Push(duration);
       long_task_stats->gc_young_wall_clock_duration_us += duration_us;
       break;
     case Event::INCREMENTAL_MARK_COMPACTOR:
@@ -389,6 +400,8 @@ void GCTracer::Stop(GarbageCollector collector) {
       ResetIncrementalMarkingCounters();
       combined_mark_compact_speed_cache_ = 0.0;
       FetchBackgroundMarkCompactCounters();
+      ScheduleHugePageSampling();
+      recorded_full_pauses_.Push(duration);
       long_task_stats->gc_full_atomic_wall_clock_duration_us += duration_us;
       break;
     case Event::MARK_COMPACTOR:
@@ -402,12 +415,15 @@ void GCTracer::Stop(GarbageCollector collector) {
       ResetIncrementalMarkingCounters();
       combined_mark_compact_speed_cache_ = 0.0;
       FetchBackgroundMarkCompactCounters();
+      ScheduleHugePageSampling();
+      recorded_full_pauses_.Push(duration);
       long_task_stats->gc_full_atomic_wall_clock_duration_us += duration_us;
       break;
     case Event::START:
       UNREACHABLE();
   }
   FetchBackgroundGeneralCounters();
+  RecordPause(duration);
 
   heap_->UpdateTotalGCTime(duration);
 
@@ -437,6 +453,71 @@ void GCTracer::Stop(GarbageCollector collector) {
   }
 }
 
+// Parses /proc/self/smaps on a worker thread, which takes too long to be
+// done as part of the atomic pause.
+class GCTracer::HugePageSamplingTask final : public CancelableTask {
+ public:
+  HugePageSamplingTask(Isolate* isolate, GCTracer* tracer,
+                       std::vector<base::AddressRegion> regions)
+      : CancelableTask(isolate),
+        tracer_(tracer),
+        regions_(std::move(regions)) {}
+
+  ~HugePageSamplingTask() override = default;
+
+  HugePageSamplingTask(const HugePageSamplingTask&) = delete;
+  HugePageSamplingTask& operator=(const HugePageSamplingTask&) = delete;
+
+ private:
+  void RunInternal() final {
+    size_t backed_bytes = 0;
+    for (const base::AddressRegion& region : regions_) {
+      backed_bytes += base::OS::HugePageBackedMemory(
+          reinterpret_cast<void*>(region.begin()), region.size());
+    }
+    tracer_->huge_page_backed_bytes_.store(backed_bytes,
+                                           std::memory_order_relaxed);
+    tracer_->huge_page_sampling_pending_.store(false,
+                                               std::memory_order_release);
+  }
+
+  GCTracer* const tracer_;
+  const std::vector<base::AddressRegion> regions_;
+};
+
+void GCTracer::ScheduleHugePageSampling() {
+  if (!FLAG_huge_page_heap) return;
+  const double now = MonotonicallyIncreasingTimeInMs();
+  if (last_huge_page_sampling_ms_ > 0 &&
+      now - last_huge_page_sampling_ms_ < kHugePageSamplingIntervalMs) {
+    return;
+  }
+  if (huge_page_sampling_pending_.load(std::memory_order_acquire)) return;
+
+  const VirtualMemoryCage* cage = heap_->isolate()->GetPtrComprCage();
+  const CodeRange* code_range = heap_->code_range();
+  std::vector<base::AddressRegion> regions;
+  if (cage != nullptr && cage->IsReserved()) {
+    regions.emplace_back(cage->reservation()->address(),
+                         cage->reservation()->size());
+  }
+  // The code range may have been reserved inside of the cage.
+  if (code_range != nullptr && code_range->IsReserved() &&
+      (cage == nullptr ||
+       !cage->reservation()->InVM(code_range->reservation()->address(),
+                                  code_range->reservation()->size()))) {
+    regions.emplace_back(code_range->reservation()->address(),
+                         code_range->reservation()->size());
+  }
+  if (regions.empty()) return;
+
+  last_huge_page_sampling_ms_ = now;
+  huge_page_sampling_pending_.store(true, std::memory_order_relaxed);
+  V8::GetCurrentPlatform()->CallOnWorkerThread(
+      std::make_unique<HugePageSamplingTask>(heap_->isolate(), this,
+                                             std::move(regions)));
+}
+
 void GCTracer::NotifySweepingCompleted() {
   if (FLAG_trace_gc_freelists) {
     PrintIsolate(heap_->isolate(),
@@ -509,6 +590,12 @@ void GCTracer::AddCompactionEvent(double duration,
       MakeBytesAndDuration(live_bytes_compacted, duration));
 }
 
+void GCTracer::AddConcurrentSweepingEvent(double duration,
+                                          size_t swept_bytes) {
+  recorded_concurrent_sweepings_.Push(
+      MakeBytesAndDuration(swept_bytes, duration));
+}
+
 
 void GCTracer::AddSurvivalRatio(double promotion_ratio) {
   recorded_survival_ratios_.Push(promotion_ratio);
@@ -522,6 +609,39 @@ void GCTracer::AddIncrementalMarkingStep(double duration, size_t bytes) {
   ReportIncrementalMarkingStepToRecorder();
 }
 
+// static
+double GCTracer::PauseHistogramBucketBoundInMs(int bucket) {
+  DCHECK_LE(0, bucket);
+  DCHECK_LT(bucket, kPauseHistogramBuckets);
+  if (bucket == kPauseHistogramBuckets - 1) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return kFirstPauseHistogramBoundInMs * (1 << bucket);
+}
+
+void GCTracer::RecordPause(double duration) {
+  int bucket = 0;
+  while (duration >= PauseHistogramBucketBoundInMs(bucket)) bucket++;
+  pause_histogram_.buckets[bucket]++;
+  pause_histogram_.total_pauses++;
+  pause_histogram_.max_pause_in_ms =
+      std::max(pause_histogram_.max_pause_in_ms, duration);
+  const double target = heap_->gc_pause_target_ms();
+  if (target > 0 && duration > target) {
+    pause_histogram_.pauses_over_target++;
+  }
+}
+
+double GCTracer::RecentMaxYoungGenerationPauseInMs() const {
+  return recorded_young_generation_pauses_.Sum(
+      [](double a, double b) { return std::max(a, b); }, 0.0);
+}
+
+double GCTracer::RecentMaxFullPauseInMs() const {
+  return recorded_full_pauses_.Sum(
+      [](double a, double b) { return std::max(a, b); }, 0.0);
+}
+
 void GCTracer::Output(const char* format, ...) const {
   if (FLAG_trace_gc) {
     va_list arguments;
@@ -1053,6 +1173,10 @@ double GCTracer::CompactionSpeedInBytesPerMillisecond() const {
   return AverageSpeed(recorded_compactions_);
 }
 
+double GCTracer::ConcurrentSweepingSpeedInBytesPerMillisecond() const {
+  return AverageSpeed(recorded_concurrent_sweepings_);
+}
+
 double GCTracer::MarkCompactSpeedInBytesPerMillisecond() const {
   return AverageSpeed(recorded_mark_compacts_);
 }
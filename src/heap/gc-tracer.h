@@ -5,6 +5,8 @@
 #ifndef V8_HEAP_GC_TRACER_H_
 #define V8_HEAP_GC_TRACER_H_
 
+#include <atomic>
+
 #include "include/v8-metrics.h"
 #include "src/base/compiler-specific.h"
 #include "src/base/macros.h"
@@ -232,6 +234,9 @@ class V8_EXPORT_PRIVATE GCTracer {
 
   void AddCompactionEvent(double duration, size_t live_bytes_compacted);
 
+  // Log the accumulated time and page area swept by concurrent sweeper tasks.
+  void AddConcurrentSweepingEvent(double duration, size_t swept_bytes);
+
   void AddSurvivalRatio(double survival_ratio);
 
   // Log an incremental marking step.
@@ -254,6 +259,43 @@ class V8_EXPORT_PRIVATE GCTracer {
   // Returns 0 if not enough events have been recorded.
   double CompactionSpeedInBytesPerMillisecond() const;
 
+  // Compute the average sweeping speed of a single concurrent sweeper task in
+  // bytes/millisecond.
+  // Returns 0 if no events have been recorded.
+  double ConcurrentSweepingSpeedInBytesPerMillisecond() const;
+
+  // Histogram of main thread pauses, i.e. atomic GCs and incremental marking
+  // steps. Bucket i < kPauseHistogramBuckets - 1 counts the pauses shorter
+  // than PauseHistogramBucketBoundInMs(i) that did not fit into bucket i - 1.
+  static constexpr int kPauseHistogramBuckets = 10;
+  static constexpr double kFirstPauseHistogramBoundInMs = 0.25;
+  struct PauseHistogram {
+    size_t buckets[kPauseHistogramBuckets] = {};
+    size_t total_pauses = 0;
+    size_t pauses_over_target = 0;
+    double max_pause_in_ms = 0.0;
+  };
+  static double PauseHistogramBucketBoundInMs(int bucket);
+
+  // Records a main thread pause of the given duration. Pauses are checked
+  // against Heap::gc_pause_target_ms() at the time they are recorded.
+  void RecordPause(double duration);
+
+  const PauseHistogram& pause_histogram() const { return pause_histogram_; }
+
+  // Longest of the recently recorded atomic pauses of young and full GCs,
+  // respectively. Returns 0 if no pauses have been recorded.
+  double RecentMaxYoungGenerationPauseInMs() const;
+  double RecentMaxFullPauseInMs() const;
+
+  // Bytes of the pointer compression cage and the code range that were
+  // backed by huge pages when last sampled. Only sampled with
+  // --huge-page-heap, on a worker thread after a full GC and at most once
+  // every kHugePageSamplingIntervalMs.
+  size_t huge_page_backed_bytes() const {
+    return huge_page_backed_bytes_.load(std::memory_order_relaxed);
+  }
+
   // Compute the average mark-sweep speed in bytes/millisecond.
   // Returns 0 if no events have been recorded.
   double MarkCompactSpeedInBytesPerMillisecond() const;
@@ -419,6 +461,12 @@ class V8_EXPORT_PRIVATE GCTracer {
   void FetchBackgroundMarkCompactCounters();
   void FetchBackgroundGeneralCounters();
 
+  class HugePageSamplingTask;
+
+  static constexpr double kHugePageSamplingIntervalMs = 10000;
+
+  void ScheduleHugePageSampling();
+
   void ReportFullCycleToRecorder();
   void ReportIncrementalMarkingStepToRecorder();
 
@@ -480,15 +528,24 @@ class V8_EXPORT_PRIVATE GCTracer {
   base::RingBuffer<BytesAndDuration> recorded_minor_gcs_total_;
   base::RingBuffer<BytesAndDuration> recorded_minor_gcs_survived_;
   base::RingBuffer<BytesAndDuration> recorded_compactions_;
+  base::RingBuffer<BytesAndDuration> recorded_concurrent_sweepings_;
   base::RingBuffer<BytesAndDuration> recorded_incremental_mark_compacts_;
   base::RingBuffer<BytesAndDuration> recorded_mark_compacts_;
   base::RingBuffer<BytesAndDuration> recorded_new_generation_allocations_;
   base::RingBuffer<BytesAndDuration> recorded_old_generation_allocations_;
   base::RingBuffer<BytesAndDuration> recorded_embedder_generation_allocations_;
   base::RingBuffer<double> recorded_survival_ratios_;
+  base::RingBuffer<double> recorded_young_generation_pauses_;
+  base::RingBuffer<double> recorded_full_pauses_;
+
+  PauseHistogram pause_histogram_;
 
   bool metrics_report_pending_ = false;
 
+  std::atomic<size_t> huge_page_backed_bytes_{0};
+  std::atomic<bool> huge_page_sampling_pending_{false};
+  double last_huge_page_sampling_ms_ = 0;
+
   v8::metrics::GarbageCollectionFullMainThreadBatchedIncrementalMark
       incremental_mark_batched_events_;
 
@@ -235,7 +235,9 @@ AllocationResult Heap::AllocateRaw(int size_in_bytes, AllocationType type,
   HeapObject object;
   AllocationResult allocation;
 
-  if (FLAG_single_generation && type == AllocationType::kYoung) {
+  // The generational third-party heap keeps young allocations in its nursery.
+  if (FLAG_single_generation && type == AllocationType::kYoung &&
+      !V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL) {
     type = AllocationType::kOld;
   }
 
@@ -37,6 +37,9 @@ V8_EXPORT_PRIVATE void Heap_GenerationalBarrierForCodeSlow(Code host,
 V8_EXPORT_PRIVATE void Heap_GenerationalEphemeronKeyBarrierSlow(
     Heap* heap, EphemeronHashTable table, Address slot);
 
+V8_EXPORT_PRIVATE void Heap_ThirdPartyHeapGenerationalBarrierSlow(
+    HeapObject object, Address slot, HeapObject value);
+
 // Do not use these internal details anywhere outside of this file. These
 // internals are only intended to shortcut write barrier checks.
 namespace heap_internals {
@@ -114,6 +117,13 @@ inline void GenerationalEphemeronKeyBarrierInternal(EphemeronHashTable table,
   Heap_GenerationalEphemeronKeyBarrierSlow(table_chunk->GetHeap(), table, slot);
 }
 
+inline void ThirdPartyHeapGenerationalBarrier(HeapObject object, Address slot,
+                                              HeapObject value) {
+  DCHECK(V8_ENABLE_THIRD_PARTY_HEAP_BOOL);
+  if (!V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL) return;
+  Heap_ThirdPartyHeapGenerationalBarrierSlow(object, slot, value);
+}
+
 }  // namespace heap_internals
 
 inline void WriteBarrierForCode(Code host, RelocInfo* rinfo, Object value) {
@@ -133,7 +143,10 @@ inline void WriteBarrierForCode(Code host) {
 
 inline void GenerationalBarrier(HeapObject object, ObjectSlot slot,
                                 Object value) {
-  if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) return;
+  if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL &&
+      !V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL) {
+    return;
+  }
   DCHECK(!HasWeakHeapObjectTag(value));
   if (!value.IsHeapObject()) return;
   GenerationalBarrier(object, slot, HeapObject::cast(value));
@@ -147,33 +160,51 @@ inline void GenerationalBarrier(HeapObject object, ObjectSlot slot,
 
 inline void GenerationalBarrier(HeapObject object, ObjectSlot slot,
                                 HeapObject value) {
-  if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) return;
   DCHECK(!HasWeakHeapObjectTag(*slot));
+  if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) {
+    heap_internals::ThirdPartyHeapGenerationalBarrier(object, slot.address(),
+                                                      value);
+    return;
+  }
   heap_internals::GenerationalBarrierInternal(object, slot.address(), value);
 }
 
 inline void GenerationalEphemeronKeyBarrier(EphemeronHashTable table,
                                             ObjectSlot slot, Object value) {
-  if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) return;
   DCHECK(!HasWeakHeapObjectTag(*slot));
   DCHECK(!HasWeakHeapObjectTag(value));
   DCHECK(value.IsHeapObject());
+  if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) {
+    heap_internals::ThirdPartyHeapGenerationalBarrier(
+        table, slot.address(), HeapObject::cast(value));
+    return;
+  }
   heap_internals::GenerationalEphemeronKeyBarrierInternal(
       table, slot.address(), HeapObject::cast(value));
 }
 
 inline void GenerationalBarrier(HeapObject object, MaybeObjectSlot slot,
                                 MaybeObject value) {
-  if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) return;
   HeapObject value_heap_object;
   if (!value->GetHeapObject(&value_heap_object)) return;
+  if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) {
+    heap_internals::ThirdPartyHeapGenerationalBarrier(object, slot.address(),
+                                                      value_heap_object);
+    return;
+  }
   heap_internals::GenerationalBarrierInternal(object, slot.address(),
                                               value_heap_object);
 }
 
 inline void GenerationalBarrierForCode(Code host, RelocInfo* rinfo,
                                        HeapObject object) {
-  if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) return;
+  if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) {
+    // Code objects with a dirty card are visited as a whole, so recording
+    // the object start is enough.
+    heap_internals::ThirdPartyHeapGenerationalBarrier(host, host.address(),
+                                                      object);
+    return;
+  }
   heap_internals::MemoryChunk* object_chunk =
       heap_internals::MemoryChunk::FromHeapObject(object);
   if (!object_chunk->InYoungGeneration()) return;
@@ -182,6 +213,8 @@ inline void GenerationalBarrierForCode(Code host, RelocInfo* rinfo,
 
 inline WriteBarrierMode GetWriteBarrierModeForObject(
     HeapObject object, const DisallowGarbageCollection* promise) {
+  // The nursery of the third-party heap is not visible to V8.
+  if (V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL) return UPDATE_WRITE_BARRIER;
   if (FLAG_disable_write_barriers) return SKIP_WRITE_BARRIER;
   DCHECK(Heap_PageFlagsAreConsistent(object));
   heap_internals::MemoryChunk* chunk =
@@ -66,6 +66,7 @@
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/objects-visiting.h"
 #include "src/heap/paged-spaces-inl.h"
+#include "src/heap/pretenuring-sampler.h"
 #include "src/heap/read-only-heap.h"
 #include "src/heap/remembered-set.h"
 #include "src/heap/safepoint.h"
@@ -159,6 +160,12 @@ void Heap_GenerationalEphemeronKeyBarrierSlow(Heap* heap,
   heap->RecordEphemeronKeyWrite(table, slot);
 }
 
+void Heap_ThirdPartyHeapGenerationalBarrierSlow(HeapObject object,
+                                                Address slot,
+                                                HeapObject value) {
+  third_party_heap::Heap::WriteBarrier(object, slot, value);
+}
+
 void Heap::SetConstructStubCreateDeoptPCOffset(int pc_offset) {
   DCHECK_EQ(Smi::zero(), construct_stub_create_deopt_pc_offset());
   set_construct_stub_create_deopt_pc_offset(Smi::FromInt(pc_offset));
@@ -468,6 +475,12 @@ GarbageCollector Heap::SelectGarbageCollector(AllocationSpace space,
     return GarbageCollector::MARK_COMPACTOR;
   }
 
+  if (V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL) {
+    // The nursery of the third-party heap is collected instead.
+    *reason = nullptr;
+    return YoungGenerationCollector();
+  }
+
   if (FLAG_gc_global || ShouldStressCompaction() || !new_space()) {
     *reason = "GC in old space forced by flags";
     return GarbageCollector::MARK_COMPACTOR;
@@ -571,6 +584,10 @@ void Heap::PrintShortHeapStatistics() {
                backing_store_bytes() / KB);
   PrintIsolate(isolate_, "External memory global %zu KB\n",
                external_memory_callback_() / KB);
+  if (FLAG_huge_page_heap) {
+    PrintIsolate(isolate_, "Huge page backed memory: %6zu KB\n",
+                 tracer()->huge_page_backed_bytes() / KB);
+  }
   PrintIsolate(isolate_, "Total time spent in GC  : %.1f ms\n",
                total_gc_time_ms_);
 }
@@ -1223,6 +1240,7 @@ void Heap::ProcessPretenuringFeedback() {
     global_pretenuring_feedback_.clear();
     global_pretenuring_feedback_.reserve(kInitialFeedbackCapacity);
   }
+  if (pretenuring_sampler_) pretenuring_sampler_->ProcessSamples();
 }
 
 void Heap::PretenureAllocationSiteOnNextCollection(AllocationSite site) {
@@ -1786,7 +1804,11 @@ bool Heap::CollectGarbage(AllocationSpace space,
       }
 
       if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) {
-        tp_heap_->CollectGarbage();
+        if (IsYoungGenerationCollector(collector)) {
+          tp_heap_->CollectNurseryGarbage();
+        } else {
+          tp_heap_->CollectGarbage();
+        }
       } else {
         freed_global_handles +=
             PerformGarbageCollection(collector, gc_callback_flags);
@@ -2520,8 +2542,16 @@ void Heap::MarkCompactPrologue() {
 }
 
 void Heap::CheckNewSpaceExpansionCriteria() {
+  // Scavenge pauses grow with the new space. With a pause target, only grow
+  // if the recent scavenges would still meet the target after growing.
+  const bool pause_target_allows_growth =
+      !HasGCPauseTarget() ||
+      tracer()->RecentMaxYoungGenerationPauseInMs() *
+              FLAG_semi_space_growth_factor <=
+          gc_pause_target_ms_;
   if (new_space_->TotalCapacity() < new_space_->MaximumCapacity() &&
-      survived_since_last_expansion_ > new_space_->TotalCapacity()) {
+      survived_since_last_expansion_ > new_space_->TotalCapacity() &&
+      pause_target_allows_growth) {
     // Grow the size of new space if there is room to grow, and enough data
     // has survived scavenge since the last expansion.
     new_space_->Grow();
@@ -3671,12 +3701,20 @@ void Heap::ReduceNewSpaceSize() {
 
   if (FLAG_predictable) return;
 
-  if (ShouldReduceMemory() ||
+  const bool scavenges_miss_pause_target =
+      HasGCPauseTarget() &&
+      tracer()->RecentMaxYoungGenerationPauseInMs() > gc_pause_target_ms_;
+
+  if (ShouldReduceMemory() || scavenges_miss_pause_target ||
       ((allocation_throughput != 0) &&
        (allocation_throughput < kLowAllocationThroughput))) {
     new_space_->Shrink();
     new_lo_space_->SetCapacity(new_space_->Capacity());
     UncommitFromSpace();
+  } else if (FLAG_uncommit_from_space && new_space_->IsFromSpaceCommitted()) {
+    // The from-space only holds garbage between GCs. Its pages go back to the
+    // pool and are recommitted by EnsureFromSpaceIsCommitted().
+    UncommitFromSpace();
   }
 }
 
@@ -5097,6 +5135,10 @@ void Heap::ConfigureHeap(const v8::ResourceConstraints& constraints) {
 
   code_range_size_ = constraints.code_range_size_in_bytes();
 
+  gc_pause_target_ms_ = FLAG_gc_pause_target > 0
+                            ? FLAG_gc_pause_target
+                            : constraints.gc_pause_target_in_ms();
+
   configured_ = true;
 }
 
@@ -5522,10 +5564,6 @@ void Heap::SetUp(LocalHeap* main_thread_local_heap) {
   allocation_timeout_ = NextAllocationTimeout();
 #endif
 
-#ifdef V8_ENABLE_THIRD_PARTY_HEAP
-  tp_heap_ = third_party_heap::Heap::New(isolate());
-#endif
-
   // Initialize heap spaces and initial maps and objects.
   //
   // If the heap is not yet configured (e.g. through the API), configure it.
@@ -5534,6 +5572,14 @@ void Heap::SetUp(LocalHeap* main_thread_local_heap) {
   // and old_generation_size_ otherwise.
   if (!configured_) ConfigureHeapDefault();
 
+#ifdef V8_ENABLE_THIRD_PARTY_HEAP
+  // The third-party heap sizes its reservation from the configured limits.
+  tp_heap_ = third_party_heap::Heap::New(isolate());
+  if (V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL) {
+    third_party_heap_card_table_base_ = tp_heap_->card_table_base();
+  }
+#endif
+
   mmap_region_base_ =
       reinterpret_cast<uintptr_t>(v8::internal::GetRandomMmapAddr()) &
       ~kMmapRegionMask;
@@ -5674,6 +5720,7 @@ void Heap::SetUpSpaces() {
     live_object_stats_.reset(new ObjectStats(this));
     dead_object_stats_.reset(new ObjectStats(this));
   }
+  object_stats_sampling_interval_ = FLAG_gc_object_stats_sampling_interval;
   local_embedder_heap_tracer_.reset(new LocalEmbedderHeapTracer(isolate()));
   embedder_roots_handler_ =
       &local_embedder_heap_tracer()->default_embedder_roots_handler();
@@ -5708,6 +5755,9 @@ void Heap::SetUpSpaces() {
     stress_scavenge_observer_ = new StressScavengeObserver(this);
     new_space()->AddAllocationObserver(stress_scavenge_observer_);
   }
+  if (FLAG_sampling_pretenuring && new_space()) {
+    pretenuring_sampler_.reset(new PretenuringSampler(this));
+  }
 
   write_protect_code_memory_ = FLAG_write_protect_code_memory;
 
@@ -5959,6 +6009,7 @@ void Heap::TearDown() {
     delete stress_scavenge_observer_;
     stress_scavenge_observer_ = nullptr;
   }
+  pretenuring_sampler_.reset();
 
   if (mark_compact_collector_) {
     mark_compact_collector_->TearDown();
@@ -5989,6 +6040,7 @@ void Heap::TearDown() {
 
   live_object_stats_.reset();
   dead_object_stats_.reset();
+  sampled_object_stats_.reset();
 
   local_embedder_heap_tracer_.reset();
   embedder_roots_handler_ = nullptr;
@@ -6997,6 +7049,43 @@ void Heap::CreateObjectStats() {
   }
 }
 
+void Heap::SampleObjectStats() {
+  TRACE_GC(tracer(), GCTracer::Scope::MC_SAMPLE_OBJECT_STATS);
+  if (!sampled_object_stats_) {
+    sampled_object_stats_.reset(new ObjectStats(this));
+  }
+  // The previous sample becomes the baseline of the delta.
+  sampled_object_stats_->CheckpointObjectStats();
+  ObjectStatsCollector collector(this, sampled_object_stats_.get(), nullptr);
+  collector.Collect();
+  object_stats_sample_gc_count_ = ms_count_;
+  object_stats_sample_pending_ = true;
+}
+
+bool Heap::GetObjectStatsDelta(
+    std::vector<v8::HeapObjectStatisticsDelta>* stats, int* gc_count) {
+  if (!object_stats_sample_pending_) return false;
+  object_stats_sample_pending_ = false;
+  ObjectStats* sample = sampled_object_stats_.get();
+  for (size_t i = 0; i < ObjectStats::OBJECT_STATS_COUNT; i++) {
+    size_t count = sample->object_count(i);
+    size_t size = sample->object_size(i);
+    size_t previous_count = sample->object_count_last_gc(i);
+    size_t previous_size = sample->object_size_last_gc(i);
+    if (count == previous_count && size == previous_size) continue;
+    const char* object_type;
+    const char* object_sub_type;
+    if (!GetObjectTypeName(i, &object_type, &object_sub_type)) continue;
+    stats->push_back({object_type, count, size,
+                      static_cast<int64_t>(count) -
+                          static_cast<int64_t>(previous_count),
+                      static_cast<int64_t>(size) -
+                          static_cast<int64_t>(previous_size)});
+  }
+  if (gc_count) *gc_count = object_stats_sample_gc_count_;
+  return true;
+}
+
 Map Heap::GcSafeMapOfCodeSpaceObject(HeapObject object) {
   PtrComprCageBase cage_base(isolate());
   MapWord map_word = object.map_word(cage_base, kRelaxedLoad);
@@ -7177,6 +7266,11 @@ template void Heap::WriteBarrierForRange<MaybeObjectSlot>(
 template <typename TSlot>
 void Heap::WriteBarrierForRange(HeapObject object, TSlot start_slot,
                                 TSlot end_slot) {
+  if (V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL) {
+    third_party_heap::Heap::WriteBarrierForRange(object, start_slot.address(),
+                                                 end_slot.address());
+    return;
+  }
   if (FLAG_disable_write_barriers) return;
   MemoryChunk* source_page = MemoryChunk::FromHeapObject(object);
   base::Flags<RangeWriteBarrierMode> mode;
@@ -54,6 +54,7 @@ class TestMemoryAllocatorScope;
 }  // namespace heap
 
 namespace third_party_heap {
+class Collector;
 class Heap;
 class Impl;
 }  // namespace third_party_heap
@@ -98,6 +99,7 @@ class ObjectIterator;
 class ObjectStats;
 class Page;
 class PagedSpace;
+class PretenuringSampler;
 class ReadOnlyHeap;
 class RootVisitor;
 class SafepointScope;
@@ -816,6 +818,12 @@ class Heap {
 
   V8_EXPORT_PRIVATE bool ShouldOptimizeForMemoryUsage();
 
+  // Target for the duration of main thread GC pauses in ms, or 0 if there is
+  // none. See v8::ResourceConstraints::gc_pause_target_in_ms.
+  double gc_pause_target_ms() const { return gc_pause_target_ms_; }
+  bool HasGCPauseTarget() const { return gc_pause_target_ms_ > 0; }
+  void SetGCPauseTarget(double target_ms) { gc_pause_target_ms_ = target_ms; }
+
   bool HighMemoryPressure() {
     return memory_pressure_level_.load(std::memory_order_relaxed) !=
            MemoryPressureLevel::kNone;
@@ -916,6 +924,11 @@ class Heap {
     return array_buffer_sweeper_.get();
   }
 
+  // Only set with --sampling-pretenuring.
+  PretenuringSampler* pretenuring_sampler() {
+    return pretenuring_sampler_.get();
+  }
+
   const base::AddressRegion& code_region();
 
   CodeRange* code_range() { return code_range_.get(); }
@@ -1087,6 +1100,12 @@ class Heap {
 
   void SetIsMarkingFlag(uint8_t flag) { is_marking_flag_ = flag; }
 
+  // Used by generated code to mark cards of the generational third-party
+  // heap, see third_party_heap::Heap::card_table_base().
+  Address* ThirdPartyHeapCardTableBaseAddress() {
+    return &third_party_heap_card_table_base_;
+  }
+
   V8_EXPORT_PRIVATE Address* store_buffer_top_address();
   static intptr_t store_buffer_mask_constant();
   static Address store_buffer_overflow_function_address();
@@ -1308,6 +1327,21 @@ class Heap {
   bool GetObjectTypeName(size_t index, const char** object_type,
                          const char** object_sub_type);
 
+  // Object statistics are sampled on every n-th full GC, 0 disables
+  // sampling. See v8::Isolate::GetHeapObjectStatisticsDelta().
+  int object_stats_sampling_interval() const {
+    return object_stats_sampling_interval_;
+  }
+  void set_object_stats_sampling_interval(int interval) {
+    object_stats_sampling_interval_ = interval;
+  }
+  // Collects statistics of live objects. Requires mark bits to be present.
+  void SampleObjectStats();
+  // Appends the delta between the two most recent samples. Returns false if
+  // there is no sample that has not been reported yet.
+  bool GetObjectStatsDelta(std::vector<v8::HeapObjectStatisticsDelta>* stats,
+                           int* gc_count);
+
   // The total number of native contexts object on the heap.
   size_t NumberOfNativeContexts();
   // The total number of native contexts that were detached but were not
@@ -2191,6 +2225,7 @@ class Heap {
   // These limits are initialized in Heap::ConfigureHeap based on the resource
   // constraints and flags.
   size_t code_range_size_ = 0;
+  double gc_pause_target_ms_ = 0.0;
   size_t max_semi_space_size_ = 0;
   size_t initial_semispace_size_ = 0;
   // Full garbage collections can be skipped if the old generation size
@@ -2383,9 +2418,15 @@ class Heap {
   std::unique_ptr<MemoryReducer> memory_reducer_;
   std::unique_ptr<ObjectStats> live_object_stats_;
   std::unique_ptr<ObjectStats> dead_object_stats_;
+  // Holds the most recent sample and, as the checkpoint, the previous one.
+  std::unique_ptr<ObjectStats> sampled_object_stats_;
+  int object_stats_sampling_interval_ = 0;
+  int object_stats_sample_gc_count_ = 0;
+  bool object_stats_sample_pending_ = false;
   std::unique_ptr<ScavengeJob> scavenge_job_;
   std::unique_ptr<AllocationObserver> scavenge_task_observer_;
   std::unique_ptr<AllocationObserver> stress_concurrent_allocation_observer_;
+  std::unique_ptr<PretenuringSampler> pretenuring_sampler_;
   std::unique_ptr<LocalEmbedderHeapTracer> local_embedder_heap_tracer_;
   std::unique_ptr<MarkingBarrier> marking_barrier_;
 
@@ -2437,6 +2478,8 @@ class Heap {
   // Used as boolean.
   uint8_t is_marking_flag_ = 0;
 
+  Address third_party_heap_card_table_base_ = kNullAddress;
+
   // If it's not full then the data is from 0 to ring_buffer_end_.  If it's
   // full then the data is from ring_buffer_end_ to the end of the buffer and
   // from 0 to ring_buffer_end_.
@@ -2549,6 +2592,7 @@ class Heap {
   friend class Space;
   friend class Sweeper;
   friend class heap::TestMemoryAllocatorScope;
+  friend class third_party_heap::Collector;
   friend class third_party_heap::Heap;
   friend class third_party_heap::Impl;
 
@@ -245,7 +245,7 @@ void IncrementalMarking::StartMarking() {
   MarkRoots();
 
   if (FLAG_concurrent_marking && !heap_->IsTearingDown()) {
-    heap_->concurrent_marking()->ScheduleJob();
+    heap_->concurrent_marking()->ScheduleJob(ConcurrentMarkingPriority());
   }
 
   // Ready to start incremental marking.
@@ -786,7 +786,8 @@ StepResult IncrementalMarking::AdvanceWithDeadline(
 
   ScheduleBytesToMarkBasedOnTime(heap()->MonotonicallyIncreasingTimeInMs());
   FastForwardScheduleIfCloseToFinalization();
-  return Step(kStepSizeInMs, completion_action, step_origin);
+  return Step(StepSizeForPauseTarget(kStepSizeInMs), completion_action,
+              step_origin);
 }
 
 size_t IncrementalMarking::StepSizeToKeepUpWithAllocations() {
@@ -812,6 +813,20 @@ size_t IncrementalMarking::StepSizeToMakeProgress() {
                   kMaxStepSizeInByte);
 }
 
+double IncrementalMarking::StepSizeForPauseTarget(
+    double step_size_in_ms) const {
+  if (!heap_->HasGCPauseTarget()) return step_size_in_ms;
+  return std::min(step_size_in_ms, heap_->gc_pause_target_ms() / 2);
+}
+
+TaskPriority IncrementalMarking::ConcurrentMarkingPriority() const {
+  if (heap_->HasGCPauseTarget() &&
+      heap_->tracer()->RecentMaxFullPauseInMs() > heap_->gc_pause_target_ms()) {
+    return TaskPriority::kUserBlocking;
+  }
+  return TaskPriority::kUserVisible;
+}
+
 void IncrementalMarking::AddScheduledBytesToMark(size_t bytes_to_mark) {
   if (scheduled_bytes_to_mark_ + bytes_to_mark < scheduled_bytes_to_mark_) {
     // The overflow case.
@@ -888,7 +903,8 @@ void IncrementalMarking::AdvanceOnAllocation() {
   TRACE_GC_EPOCH(heap_->tracer(), GCTracer::Scope::MC_INCREMENTAL,
                  ThreadKind::kMain);
   ScheduleBytesToMarkBasedOnAllocation();
-  Step(kMaxStepSizeInMs, GC_VIA_STACK_GUARD, StepOrigin::kV8);
+  Step(StepSizeForPauseTarget(kMaxStepSizeInMs), GC_VIA_STACK_GUARD,
+       StepOrigin::kV8);
 }
 
 StepResult IncrementalMarking::Step(double max_step_size_in_ms,
@@ -968,7 +984,8 @@ StepResult IncrementalMarking::Step(double max_step_size_in_ms,
     }
     if (FLAG_concurrent_marking) {
       local_marking_worklists()->ShareWork();
-      heap_->concurrent_marking()->RescheduleJobIfNeeded();
+      heap_->concurrent_marking()->RescheduleJobIfNeeded(
+          ConcurrentMarkingPriority());
     }
   }
   if (state_ == MARKING) {
@@ -977,6 +994,12 @@ StepResult IncrementalMarking::Step(double max_step_size_in_ms,
     const double v8_duration =
         heap_->MonotonicallyIncreasingTimeInMs() - start - embedder_duration;
     heap_->tracer()->AddIncrementalMarkingStep(v8_duration, v8_bytes_processed);
+    // Steps that did no marking work would skew the pause statistics towards
+    // zero.
+    if (v8_bytes_processed > 0 || embedder_duration > 0) {
+      heap_->tracer()->RecordPause(heap_->MonotonicallyIncreasingTimeInMs() -
+                                   start);
+    }
   }
   if (FLAG_trace_incremental_marking) {
     heap_->isolate()->PrintWithTimestamp(
@@ -5,6 +5,7 @@
 #ifndef V8_HEAP_INCREMENTAL_MARKING_H_
 #define V8_HEAP_INCREMENTAL_MARKING_H_
 
+#include "include/v8-platform.h"
 #include "src/base/platform/mutex.h"
 #include "src/heap/heap.h"
 #include "src/heap/incremental-marking-job.h"
@@ -261,6 +262,14 @@ class V8_EXPORT_PRIVATE IncrementalMarking final {
   size_t StepSizeToMakeProgress();
   void AddScheduledBytesToMark(size_t bytes_to_mark);
 
+  // Caps |step_size_in_ms| so that a step takes at most half of the GC pause
+  // target, leaving the rest to the work following the step.
+  double StepSizeForPauseTarget(double step_size_in_ms) const;
+
+  // Concurrent marking gets a higher priority while recent atomic pauses miss
+  // the GC pause target, so that less work is left to the atomic pause.
+  TaskPriority ConcurrentMarkingPriority() const;
+
   // Schedules more bytes to mark so that the marker is no longer ahead
   // of schedule.
   void FastForwardSchedule();
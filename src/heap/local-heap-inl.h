@@ -12,6 +12,7 @@
 #include "src/heap/concurrent-allocator-inl.h"
 #include "src/heap/heap.h"
 #include "src/heap/local-heap.h"
+#include "src/heap/third-party/heap-api.h"
 
 namespace v8 {
 namespace internal {
@@ -19,7 +20,6 @@ namespace internal {
 AllocationResult LocalHeap::AllocateRaw(int size_in_bytes, AllocationType type,
                                         AllocationOrigin origin,
                                         AllocationAlignment alignment) {
-  DCHECK(!FLAG_enable_third_party_heap);
 #if DEBUG
   VerifyCurrent();
   DCHECK(AllowHandleAllocation::IsAllowed());
@@ -34,6 +34,11 @@ AllocationResult LocalHeap::AllocateRaw(int size_in_bytes, AllocationType type,
   // Each allocation is supposed to be a safepoint.
   Safepoint();
 
+  if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) {
+    return heap()->tp_heap_->Allocate(tp_allocator_, size_in_bytes, type,
+                                      alignment);
+  }
+
   bool large_object = size_in_bytes > heap_->MaxRegularHeapObjectSize(type);
 
   if (type == AllocationType::kCode) {
@@ -62,7 +67,6 @@ AllocationResult LocalHeap::AllocateRaw(int size_in_bytes, AllocationType type,
 Address LocalHeap::AllocateRawOrFail(int object_size, AllocationType type,
                                      AllocationOrigin origin,
                                      AllocationAlignment alignment) {
-  DCHECK(!FLAG_enable_third_party_heap);
   AllocationResult result = AllocateRaw(object_size, type, origin, alignment);
   if (!result.IsRetry()) return result.ToObject().address();
   return PerformCollectionAndAllocateAgain(object_size, type, origin,
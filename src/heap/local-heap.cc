@@ -21,6 +21,7 @@
 #include "src/heap/marking-barrier.h"
 #include "src/heap/parked-scope.h"
 #include "src/heap/safepoint.h"
+#include "src/heap/third-party/heap-api.h"
 
 namespace v8 {
 namespace internal {
@@ -81,6 +82,9 @@ LocalHeap::~LocalHeap() {
     if (!is_main_thread()) {
       marking_barrier_->Publish();
       WriteBarrier::ClearForThread(marking_barrier_.get());
+      if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) {
+        heap_->tp_heap_->DisposeLocalAllocator(tp_allocator_);
+      }
     }
   });
 
@@ -110,6 +114,11 @@ void LocalHeap::SetUp() {
 
   DCHECK_NULL(marking_barrier_);
   marking_barrier_ = std::make_unique<MarkingBarrier>(this);
+
+  if (V8_ENABLE_THIRD_PARTY_HEAP_BOOL) {
+    DCHECK_NULL(tp_allocator_);
+    tp_allocator_ = heap_->tp_heap_->NewLocalAllocator(this);
+  }
 }
 
 void LocalHeap::EnsurePersistentHandles() {
@@ -23,6 +23,10 @@ class Heap;
 class Safepoint;
 class LocalHandles;
 
+namespace third_party_heap {
+class LocalAllocator;
+}  // namespace third_party_heap
+
 // LocalHeap is used by the GC to track all threads with heap access in order to
 // stop them before performing a collection. LocalHeaps can be either Parked or
 // Running and are in Parked mode when initialized.
@@ -306,6 +310,8 @@ class V8_EXPORT_PRIVATE LocalHeap {
   std::unique_ptr<ConcurrentAllocator> old_space_allocator_;
   std::unique_ptr<ConcurrentAllocator> code_space_allocator_;
 
+  third_party_heap::LocalAllocator* tp_allocator_ = nullptr;
+
   friend class CollectionBarrier;
   friend class ConcurrentAllocator;
   friend class IsolateSafepoint;
@@ -718,10 +718,41 @@ void MarkCompactCollector::ComputeEvacuationHeuristics(
     } else {
       *target_fragmentation_percent = kTargetFragmentationPercent;
     }
-    *max_evacuated_bytes = kMaxEvacuatedBytes;
+    *max_evacuated_bytes = FLAG_incremental_compaction
+                               ? IncrementalCompactionBudgetInBytes()
+                               : kMaxEvacuatedBytes;
   }
 }
 
+size_t MarkCompactCollector::IncrementalCompactionBudgetInBytes() {
+  // Used until there are compaction speed samples.
+  const size_t kDefaultBudgetInBytes = 1 * MB;
+  double budget_ms = FLAG_compaction_pause_budget;
+  if (heap()->HasGCPauseTarget()) {
+    budget_ms = std::min(budget_ms, heap()->gc_pause_target_ms() / 2);
+  }
+  const double compaction_speed =
+      heap()->tracer()->CompactionSpeedInBytesPerMillisecond();
+  if (compaction_speed == 0) return kDefaultBudgetInBytes;
+  return static_cast<size_t>(compaction_speed * budget_ms);
+}
+
+void MarkCompactCollector::SortPagesForIncrementalCompaction(
+    PagedSpace* space, std::vector<std::pair<size_t, Page*>>* pages) {
+  std::sort(pages->begin(), pages->end(),
+            [](const std::pair<size_t, Page*>& a,
+               const std::pair<size_t, Page*>& b) {
+              return a.second->address() < b.second->address();
+            });
+  const Address cursor = compaction_cursor_[space->identity()];
+  auto first = std::find_if(pages->begin(), pages->end(),
+                            [cursor](const std::pair<size_t, Page*>& page) {
+                              return page.second->address() >= cursor;
+                            });
+  // Wrap around once the end of the space has been reached.
+  std::rotate(pages->begin(), first, pages->end());
+}
+
 void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
   DCHECK(space->identity() == OLD_SPACE || space->identity() == CODE_SPACE);
 
@@ -836,10 +867,18 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
     // - the total size of evacuated objects does not exceed the specified
     // limit.
     // - fragmentation of (n+1)-th page does not exceed the specified limit.
-    std::sort(pages.begin(), pages.end(),
-              [](const LiveBytesPagePair& a, const LiveBytesPagePair& b) {
-                return a.first < b.first;
-              });
+    //
+    // With --incremental-compaction, the fragmented pages are instead taken in
+    // address order, starting where the previous GC stopped. Each GC thereby
+    // evacuates the next address range within its budget.
+    if (FLAG_incremental_compaction) {
+      SortPagesForIncrementalCompaction(space, &pages);
+    } else {
+      std::sort(pages.begin(), pages.end(),
+                [](const LiveBytesPagePair& a, const LiveBytesPagePair& b) {
+                  return a.first < b.first;
+                });
+    }
     for (size_t i = 0; i < pages.size(); i++) {
       size_t live_bytes = pages[i].first;
       DCHECK_GE(area_size, live_bytes);
@@ -847,6 +886,8 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
           ((total_live_bytes + live_bytes) <= max_evacuated_bytes)) {
         candidate_count++;
         total_live_bytes += live_bytes;
+      } else if (FLAG_incremental_compaction) {
+        break;
       }
       if (FLAG_trace_fragmentation_verbose) {
         PrintIsolate(isolate(),
@@ -865,6 +906,15 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
         static_cast<int>((total_live_bytes + area_size - 1) / area_size);
     DCHECK_LE(estimated_new_pages, candidate_count);
     int estimated_released_pages = candidate_count - estimated_new_pages;
+    if (FLAG_incremental_compaction && !pages.empty()) {
+      // Continue after the considered range, even if it ends up not being
+      // evacuated below. A page at the cursor whose live bytes alone exceed
+      // the budget is skipped, as it would otherwise block the rest of the
+      // space. Skipped pages are considered again after wrapping around.
+      const int last_considered = std::max(candidate_count, 1) - 1;
+      compaction_cursor_[space->identity()] =
+          pages[last_considered].second->address() + 1;
+    }
     // Avoid (compact -> expand) cycles.
     if ((estimated_released_pages == 0) && !FLAG_always_compact) {
       candidate_count = 0;
@@ -2080,6 +2130,11 @@ void MarkCompactCollector::RecordObjectStats() {
     heap()->live_object_stats_->CheckpointObjectStats();
     heap()->dead_object_stats_->ClearObjectStats();
   }
+  const int sampling_interval = heap()->object_stats_sampling_interval();
+  if (V8_UNLIKELY(sampling_interval > 0) &&
+      heap()->ms_count() % sampling_interval == 0) {
+    heap()->SampleObjectStats();
+  }
 }
 
 void MarkCompactCollector::MarkLiveObjects() {
@@ -594,6 +594,15 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
                                    int* target_fragmentation_percent,
                                    size_t* max_evacuated_bytes);
 
+  // Bytes that can be evacuated within --compaction-pause-budget, or the GC
+  // pause target if that is shorter, at the traced compaction speed.
+  size_t IncrementalCompactionBudgetInBytes();
+
+  // With --incremental-compaction, orders the candidate |pages| of |space| by
+  // address, starting at the page following the range evacuated last.
+  void SortPagesForIncrementalCompaction(
+      PagedSpace* space, std::vector<std::pair<size_t, Page*>>* pages);
+
   void RecordObjectStats();
 
   // Finishes GC, performs heap verification if enabled.
@@ -771,6 +780,9 @@ class MarkCompactCollector final : public MarkCompactCollectorBase {
 
   // Candidates for pages that should be evacuated.
   std::vector<Page*> evacuation_candidates_;
+  // With --incremental-compaction, the address from which the next GC
+  // continues to select evacuation candidates of a space.
+  Address compaction_cursor_[LAST_GROWABLE_PAGED_SPACE + 1] = {kNullAddress};
   // Pages that are actually processed during evacuation.
   std::vector<Page*> old_space_evacuation_pages_;
   std::vector<Page*> new_space_evacuation_pages_;
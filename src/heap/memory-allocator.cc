@@ -7,6 +7,7 @@
 #include <cinttypes>
 
 #include "src/base/address-region.h"
+#include "src/base/platform/platform.h"
 #include "src/common/globals.h"
 #include "src/execution/isolate.h"
 #include "src/flags/flags.h"
@@ -156,15 +157,18 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks(
   // Regular chunks.
   while ((chunk = GetMemoryChunkSafe<kRegular>()) != nullptr) {
     bool pooled = chunk->IsFlagSet(MemoryChunk::POOLED);
+    const int numa_node = chunk->numa_node();
     allocator_->PerformFreeMemory(chunk);
-    if (pooled) AddMemoryChunkSafe<kPooled>(chunk);
+    if (pooled) AddPooledMemoryChunkSafe(chunk, numa_node);
     if (delegate && delegate->ShouldYield()) return;
   }
   if (mode == MemoryAllocator::Unmapper::FreeMode::kReleasePooled) {
     // The previous loop uncommitted any pages marked as pooled and added them
     // to the pooled list. In case of kReleasePooled we need to free them
     // though.
-    while ((chunk = GetMemoryChunkSafe<kPooled>()) != nullptr) {
+    int numa_node;
+    while ((chunk = GetPooledMemoryChunkSafe(MemoryChunk::kNoNumaNode,
+                                             &numa_node)) != nullptr) {
       allocator_->Free<MemoryAllocator::kAlreadyPooled>(chunk);
       if (delegate && delegate->ShouldYield()) return;
     }
@@ -172,6 +176,36 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks(
   PerformFreeMemoryOnQueuedNonRegularChunks();
 }
 
+void MemoryAllocator::Unmapper::AddPooledMemoryChunkSafe(MemoryChunk* chunk,
+                                                         int numa_node) {
+  base::MutexGuard guard(&mutex_);
+  chunks_[kPooled].push_back(chunk);
+  pooled_numa_nodes_.push_back(numa_node);
+}
+
+MemoryChunk* MemoryAllocator::Unmapper::GetPooledMemoryChunkSafe(
+    int numa_node, int* chunk_numa_node) {
+  base::MutexGuard guard(&mutex_);
+  std::vector<MemoryChunk*>& pooled = chunks_[kPooled];
+  DCHECK_EQ(pooled.size(), pooled_numa_nodes_.size());
+  if (pooled.empty()) return nullptr;
+  size_t index = pooled.size() - 1;
+  if (numa_node != MemoryChunk::kNoNumaNode) {
+    for (size_t i = pooled.size(); i > 0; i--) {
+      if (pooled_numa_nodes_[i - 1] != numa_node) continue;
+      index = i - 1;
+      break;
+    }
+  }
+  MemoryChunk* chunk = pooled[index];
+  *chunk_numa_node = pooled_numa_nodes_[index];
+  pooled[index] = pooled.back();
+  pooled.pop_back();
+  pooled_numa_nodes_[index] = pooled_numa_nodes_.back();
+  pooled_numa_nodes_.pop_back();
+  return chunk;
+}
+
 void MemoryAllocator::Unmapper::TearDown() {
   CHECK(!job_handle_ || !job_handle_->IsValid());
   PerformFreeMemoryOnQueuedChunks<FreeMode::kReleasePooled>();
@@ -198,8 +232,11 @@ size_t MemoryAllocator::Unmapper::CommittedBufferedMemory() {
   base::MutexGuard guard(&mutex_);
 
   size_t sum = 0;
-  // kPooled chunks are already uncommited. We only have to account for
-  // kRegular and kNonRegular chunks.
+  // kPooled chunks are already uncommited unless huge pages are used. We
+  // otherwise only have to account for kRegular and kNonRegular chunks.
+  if (FLAG_huge_page_heap) {
+    sum += chunks_[kPooled].size() * MemoryChunk::kPageSize;
+  }
   for (auto& chunk : chunks_[kRegular]) {
     sum += chunk->size();
   }
@@ -496,7 +533,9 @@ void MemoryAllocator::PerformFreeMemory(MemoryChunk* chunk) {
 
   VirtualMemory* reservation = chunk->reserved_memory();
   if (chunk->IsFlagSet(MemoryChunk::POOLED)) {
-    UncommitMemory(reservation);
+    // Uncommitting discards the pages, which splits the huge pages backing
+    // them. With --huge-page-heap pooled chunks stay committed instead.
+    if (!FLAG_huge_page_heap) UncommitMemory(reservation);
   } else {
     DCHECK(reservation->IsReserved());
     reservation->Free();
@@ -545,17 +584,23 @@ template <MemoryAllocator::AllocationMode alloc_mode, typename SpaceType>
 Page* MemoryAllocator::AllocatePage(size_t size, SpaceType* owner,
                                     Executability executable) {
   MemoryChunk* chunk = nullptr;
+  // Data pages are placed on the NUMA node of the allocating thread, which is
+  // the thread that fills them.
+  const int numa_node = FLAG_numa_aware_heap && executable == NOT_EXECUTABLE
+                            ? base::OS::GetCurrentNumaNode()
+                            : MemoryChunk::kNoNumaNode;
   if (alloc_mode == kPooled) {
     DCHECK_EQ(size, static_cast<size_t>(
                         MemoryChunkLayout::AllocatableMemoryInMemoryChunk(
                             owner->identity())));
     DCHECK_EQ(executable, NOT_EXECUTABLE);
-    chunk = AllocatePagePooled(owner);
+    chunk = AllocatePagePooled(owner, numa_node);
   }
   if (chunk == nullptr) {
     chunk = AllocateChunk(size, size, executable, owner);
   }
   if (chunk == nullptr) return nullptr;
+  if (numa_node != MemoryChunk::kNoNumaNode) SetNumaNode(chunk, numa_node);
   return owner->InitializePage(chunk);
 }
 
@@ -593,9 +638,22 @@ LargePage* MemoryAllocator::AllocateLargePage(size_t size,
   return LargePage::Initialize(isolate_->heap(), chunk, executable);
 }
 
+void MemoryAllocator::SetNumaNode(MemoryChunk* chunk, int numa_node) {
+  if (chunk->numa_node() == numa_node) return;
+  // Only the header has been touched so far; the rest of the chunk is faulted
+  // in on the preferred node.
+  if (base::OS::SetPreferredNumaNode(reinterpret_cast<void*>(chunk->address()),
+                                     chunk->size(), numa_node)) {
+    chunk->set_numa_node(numa_node);
+  }
+}
+
 template <typename SpaceType>
-MemoryChunk* MemoryAllocator::AllocatePagePooled(SpaceType* owner) {
-  MemoryChunk* chunk = unmapper()->TryGetPooledMemoryChunkSafe();
+MemoryChunk* MemoryAllocator::AllocatePagePooled(SpaceType* owner,
+                                                 int numa_node) {
+  int chunk_numa_node = MemoryChunk::kNoNumaNode;
+  MemoryChunk* chunk =
+      unmapper()->TryGetPooledMemoryChunkSafe(numa_node, &chunk_numa_node);
   if (chunk == nullptr) return nullptr;
   const int size = MemoryChunk::kPageSize;
   const Address start = reinterpret_cast<Address>(chunk);
@@ -614,6 +672,8 @@ MemoryChunk* MemoryAllocator::AllocatePagePooled(SpaceType* owner) {
       BasicMemoryChunk::Initialize(isolate_->heap(), start, size, area_start,
                                    area_end, owner, std::move(reservation));
   MemoryChunk::Initialize(basic_chunk, isolate_->heap(), NOT_EXECUTABLE);
+  // The memory policy of the range survived uncommitting.
+  chunk->set_numa_node(chunk_numa_node);
   size_ += size;
   return chunk;
 }
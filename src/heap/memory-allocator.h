@@ -47,6 +47,7 @@ class MemoryAllocator {
         : heap_(heap), allocator_(allocator) {
       chunks_[kRegular].reserve(kReservedQueueingSlots);
       chunks_[kPooled].reserve(kReservedQueueingSlots);
+      pooled_numa_nodes_.reserve(kReservedQueueingSlots);
     }
 
     void AddMemoryChunkSafe(MemoryChunk* chunk) {
@@ -57,16 +58,19 @@ class MemoryAllocator {
       }
     }
 
-    MemoryChunk* TryGetPooledMemoryChunkSafe() {
+    // Returns the NUMA node the chunk is bound to in |chunk_numa_node|.
+    MemoryChunk* TryGetPooledMemoryChunkSafe(int numa_node,
+                                             int* chunk_numa_node) {
       // Procedure:
       // (1) Try to get a chunk that was declared as pooled and already has
-      // been uncommitted.
+      // been uncommitted, preferably one bound to |numa_node|.
       // (2) Try to steal any memory chunk of kPageSize that would've been
       // unmapped.
-      MemoryChunk* chunk = GetMemoryChunkSafe<kPooled>();
+      MemoryChunk* chunk = GetPooledMemoryChunkSafe(numa_node, chunk_numa_node);
       if (chunk == nullptr) {
         chunk = GetMemoryChunkSafe<kRegular>();
         if (chunk != nullptr) {
+          *chunk_numa_node = chunk->numa_node();
           // For stolen chunks we need to manually free any allocated memory.
           chunk->ReleaseAllAllocatedMemory();
         }
@@ -115,6 +119,11 @@ class MemoryAllocator {
       return chunk;
     }
 
+    // Pooled chunks are uncommitted, so their NUMA nodes are kept in
+    // |pooled_numa_nodes_| alongside the kPooled queue.
+    void AddPooledMemoryChunkSafe(MemoryChunk* chunk, int numa_node);
+    MemoryChunk* GetPooledMemoryChunkSafe(int numa_node, int* chunk_numa_node);
+
     bool MakeRoomForNewTasks();
 
     template <FreeMode mode>
@@ -127,6 +136,7 @@ class MemoryAllocator {
     MemoryAllocator* const allocator_;
     base::Mutex mutex_;
     std::vector<MemoryChunk*> chunks_[kNumberOfChunkQueues];
+    std::vector<int> pooled_numa_nodes_;
     std::unique_ptr<v8::JobHandle> job_handle_;
 
     friend class MemoryAllocator;
@@ -288,7 +298,10 @@ class MemoryAllocator {
   // See AllocatePage for public interface. Note that currently we only
   // support pools for NOT_EXECUTABLE pages of size MemoryChunk::kPageSize.
   template <typename SpaceType>
-  MemoryChunk* AllocatePagePooled(SpaceType* owner);
+  MemoryChunk* AllocatePagePooled(SpaceType* owner, int numa_node);
+
+  // Makes |numa_node| the preferred node of the pages of |chunk|.
+  void SetNumaNode(MemoryChunk* chunk, int numa_node);
 
   // Initializes pages in a chunk. Returns the first page address.
   // This function and GetChunkId() are provided for the mark-compact
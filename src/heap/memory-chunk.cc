@@ -176,6 +176,7 @@ MemoryChunk* MemoryChunk::Initialize(BasicMemoryChunk* basic_chunk, Heap* heap,
   }
 
   chunk->possibly_empty_buckets_.Initialize();
+  chunk->numa_node_ = kNoNumaNode;
 
   // All pages of a shared heap need to be marked with this flag.
   if (heap->IsShared()) chunk->SetFlag(IN_SHARED_HEAP);
@@ -470,6 +471,8 @@ void MemoryChunk::ValidateOffsets(MemoryChunk* chunk) {
   DCHECK_EQ(reinterpret_cast<Address>(&chunk->possibly_empty_buckets_) -
                 chunk->address(),
             MemoryChunkLayout::kPossiblyEmptyBucketsOffset);
+  DCHECK_EQ(reinterpret_cast<Address>(&chunk->numa_node_) - chunk->address(),
+            MemoryChunkLayout::kNumaNodeOffset);
 }
 #endif
 
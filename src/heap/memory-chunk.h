@@ -52,6 +52,8 @@ class MemoryChunk : public BasicMemoryChunk {
   // Maximum number of nested code memory modification scopes.
   static const int kMaxWriteUnprotectCounter = 3;
 
+  static const int kNoNumaNode = -1;
+
   // Only works if the pointer is in the first kPageSize of the MemoryChunk.
   static MemoryChunk* FromAddress(Address a) {
     return cast(BasicMemoryChunk::FromAddress(a));
@@ -204,6 +206,10 @@ class MemoryChunk : public BasicMemoryChunk {
     return &possibly_empty_buckets_;
   }
 
+  // The NUMA node that the pages of this chunk prefer, or kNoNumaNode.
+  int numa_node() const { return static_cast<int>(numa_node_); }
+  void set_numa_node(int node) { numa_node_ = node; }
+
   // Release memory allocated by the chunk, except that which is needed by
   // read-only space chunks.
   void ReleaseAllocatedMemoryNeededForWritableChunk();
@@ -286,6 +292,8 @@ class MemoryChunk : public BasicMemoryChunk {
 
   PossiblyEmptyBuckets possibly_empty_buckets_;
 
+  intptr_t numa_node_;
+
 #ifdef V8_ENABLE_CONSERVATIVE_STACK_SCANNING
   ObjectStartBitmap object_start_bitmap_;
 #endif
@@ -4,6 +4,9 @@
 
 #include "src/heap/memory-measurement.h"
 
+#include <algorithm>
+#include <sstream>
+
 #include "include/v8-local-handle.h"
 #include "src/api/api-inl.h"
 #include "src/execution/isolate-inl.h"
@@ -12,10 +15,13 @@
 #include "src/heap/incremental-marking.h"
 #include "src/heap/marking-worklist.h"
 #include "src/logging/counters.h"
+#include "src/logging/tracing-flags.h"
 #include "src/objects/js-array-buffer-inl.h"
 #include "src/objects/js-promise-inl.h"
 #include "src/objects/smi.h"
 #include "src/tasks/task-utils.h"
+#include "src/tracing/trace-event.h"
+#include "src/tracing/tracing-category-observer.h"
 
 namespace v8 {
 namespace internal {
@@ -195,8 +201,15 @@ bool MemoryMeasurement::EnqueueRequest(
 }
 
 std::vector<Address> MemoryMeasurement::StartProcessing() {
-  if (received_.empty()) return {};
   std::unordered_set<Address> unique_contexts;
+  for (auto& account : context_accounts_) {
+    account->measuring = account->context.IsAlive();
+    if (account->measuring) unique_contexts.insert(account->context.address());
+  }
+  if (received_.empty()) {
+    return std::vector<Address>(unique_contexts.begin(),
+                                unique_contexts.end());
+  }
   DCHECK(processing_.empty());
   processing_ = std::move(received_);
   for (const auto& request : processing_) {
@@ -212,6 +225,7 @@ std::vector<Address> MemoryMeasurement::StartProcessing() {
 }
 
 void MemoryMeasurement::FinishProcessing(const NativeContextStats& stats) {
+  if (!context_accounts_.empty()) UpdateContextAccounts(stats);
   if (processing_.empty()) return;
 
   while (!processing_.empty()) {
@@ -230,6 +244,136 @@ void MemoryMeasurement::FinishProcessing(const NativeContextStats& stats) {
   ScheduleReportingTask();
 }
 
+void MemoryMeasurement::SetContextBudget(
+    Handle<NativeContext> context, size_t budget,
+    v8::ContextMemoryBudgetCallback callback, void* data) {
+  ContextAccount* account = FindContextAccount(context);
+  if (!account) {
+    // Registering the context gives it a stable id for tracing.
+    isolate_->GetOrRegisterRecorderContextId(context);
+    Object recorder_id = context->recorder_context_id();
+    context_accounts_.push_back(std::make_unique<ContextAccount>(
+        isolate_, *context,
+        recorder_id.IsSmi() ? Smi::ToInt(recorder_id) : -1));
+    account = context_accounts_.back().get();
+  }
+  account->budget = budget;
+  account->callback = callback;
+  account->data = data;
+}
+
+void MemoryMeasurement::ClearContextBudget(Handle<NativeContext> context) {
+  for (auto it = context_accounts_.begin(); it != context_accounts_.end();
+       ++it) {
+    ContextAccount* account = it->get();
+    if (account->context.IsAlive() &&
+        account->context.address() == context->ptr()) {
+      context_accounts_.erase(it);
+      return;
+    }
+  }
+}
+
+size_t MemoryMeasurement::GetContextSize(Handle<NativeContext> context) {
+  ContextAccount* account = FindContextAccount(context);
+  return account ? account->size : 0;
+}
+
+MemoryMeasurement::ContextAccount* MemoryMeasurement::FindContextAccount(
+    Handle<NativeContext> context) {
+  // Embedders account few contexts, so a linear search is fine.
+  for (auto& account : context_accounts_) {
+    if (account->context.IsAlive() &&
+        account->context.address() == context->ptr()) {
+      return account.get();
+    }
+  }
+  return nullptr;
+}
+
+void MemoryMeasurement::UpdateContextAccounts(const NativeContextStats& stats) {
+  bool exceeded = false;
+  // Accounts of dead contexts are removed. Their phantom handles have been
+  // reset and released by the GC.
+  context_accounts_.erase(
+      std::remove_if(context_accounts_.begin(), context_accounts_.end(),
+                     [](const std::unique_ptr<ContextAccount>& account) {
+                       return !account->context.IsAlive();
+                     }),
+      context_accounts_.end());
+  for (auto& account : context_accounts_) {
+    if (!account->measuring) continue;
+    account->measuring = false;
+    // Contexts do not move before evacuation, so the handles still point to
+    // the addresses that the marker used.
+    account->size = stats.Get(account->context.address());
+    if (account->callback && account->size > account->budget) {
+      account->exceeded = true;
+      exceeded = true;
+    }
+  }
+  if (V8_UNLIKELY(TracingFlags::gc.load(std::memory_order_relaxed) &
+                  v8::tracing::TracingCategoryObserver::ENABLED_BY_TRACING)) {
+    TraceContextAccounts(stats.Get(MarkingWorklists::kSharedContext));
+  }
+  if (exceeded) ScheduleBudgetTask();
+}
+
+void MemoryMeasurement::TraceContextAccounts(size_t shared) {
+  std::stringstream sizes;
+  sizes << "{\"shared\":" << shared << ",\"contexts\":[";
+  bool first = true;
+  for (auto& account : context_accounts_) {
+    if (!first) sizes << ",";
+    first = false;
+    sizes << "{\"id\":" << account->recorder_id
+          << ",\"size\":" << account->size
+          << ",\"budget\":" << account->budget << "}";
+  }
+  sizes << "]}";
+  TRACE_EVENT_INSTANT1(TRACE_DISABLED_BY_DEFAULT("v8.gc"),
+                       "V8.GC_Context_Memory", TRACE_EVENT_SCOPE_THREAD,
+                       "sizes", TRACE_STR_COPY(sizes.str().c_str()));
+}
+
+void MemoryMeasurement::ScheduleBudgetTask() {
+  if (budget_task_pending_) return;
+  budget_task_pending_ = true;
+  auto taskrunner = V8::GetCurrentPlatform()->GetForegroundTaskRunner(
+      reinterpret_cast<v8::Isolate*>(isolate_));
+  taskrunner->PostTask(MakeCancelableTask(isolate_, [this] {
+    budget_task_pending_ = false;
+    ReportExceededBudgets();
+  }));
+}
+
+void MemoryMeasurement::ReportExceededBudgets() {
+  HandleScope handle_scope(isolate_);
+  struct ExceededBudget {
+    Handle<NativeContext> context;
+    size_t size;
+    size_t budget;
+    v8::ContextMemoryBudgetCallback callback;
+    void* data;
+  };
+  // Collect the contexts first as callbacks may change the budgets.
+  std::vector<ExceededBudget> exceeded;
+  for (auto& account : context_accounts_) {
+    if (!account->exceeded) continue;
+    account->exceeded = false;
+    if (!account->context.IsAlive()) continue;
+    Handle<NativeContext> context(
+        NativeContext::cast(Object(account->context.address())), isolate_);
+    exceeded.push_back({context, account->size, account->budget,
+                        account->callback, account->data});
+  }
+  for (const ExceededBudget& entry : exceeded) {
+    entry.callback(reinterpret_cast<v8::Isolate*>(isolate_),
+                   Utils::ToLocal(Handle<Context>::cast(entry.context)),
+                   entry.size, entry.budget, entry.data);
+  }
+}
+
 void MemoryMeasurement::ScheduleReportingTask() {
   if (reporting_task_pending_) return;
   reporting_task_pending_ = true;
@@ -6,12 +6,15 @@
 #define V8_HEAP_MEMORY_MEASUREMENT_H_
 
 #include <list>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "include/v8-statistics.h"
 #include "src/base/platform/elapsed-timer.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/common/globals.h"
+#include "src/handles/global-handles.h"
 #include "src/objects/contexts.h"
 #include "src/objects/map.h"
 #include "src/objects/objects.h"
@@ -36,6 +39,13 @@ class MemoryMeasurement {
       Isolate* isolate, Handle<NativeContext> context,
       Handle<JSPromise> promise, v8::MeasureMemoryMode mode);
 
+  // Continuous accounting of contexts during every full GC, see
+  // v8::Isolate::SetContextMemoryBudget.
+  void SetContextBudget(Handle<NativeContext> context, size_t budget,
+                        v8::ContextMemoryBudgetCallback callback, void* data);
+  void ClearContextBudget(Handle<NativeContext> context);
+  size_t GetContextSize(Handle<NativeContext> context);
+
  private:
   static const int kGCTaskDelayInSeconds = 10;
   struct Request {
@@ -45,6 +55,25 @@ class MemoryMeasurement {
     size_t shared;
     base::ElapsedTimer timer;
   };
+  struct ContextAccount {
+    ContextAccount(Isolate* isolate, NativeContext context,
+                   intptr_t recorder_id)
+        : context(isolate, context), recorder_id(recorder_id) {}
+
+    PhantomGlobalHandle context;
+    // Id of the context in v8::metrics::Recorder events.
+    intptr_t recorder_id;
+    size_t size = 0;
+    size_t budget = 0;
+    v8::ContextMemoryBudgetCallback callback = nullptr;
+    void* data = nullptr;
+    // Set if the context is measured by the current GC. Contexts accounted
+    // after marking started are measured by the next GC.
+    bool measuring = false;
+    // Set if the last GC found the context over budget and the callback has
+    // not been invoked yet.
+    bool exceeded = false;
+  };
   void ScheduleReportingTask();
   void ReportResults();
   void ScheduleGCTask(v8::MeasureMemoryExecution execution);
@@ -52,6 +81,11 @@ class MemoryMeasurement {
   void SetGCTaskPending(v8::MeasureMemoryExecution execution);
   void SetGCTaskDone(v8::MeasureMemoryExecution execution);
   int NextGCTaskDelayInSeconds();
+  ContextAccount* FindContextAccount(Handle<NativeContext> context);
+  void UpdateContextAccounts(const NativeContextStats& stats);
+  void TraceContextAccounts(size_t shared);
+  void ScheduleBudgetTask();
+  void ReportExceededBudgets();
 
   std::list<Request> received_;
   std::list<Request> processing_;
@@ -60,6 +94,8 @@ class MemoryMeasurement {
   bool reporting_task_pending_ = false;
   bool delayed_gc_task_pending_ = false;
   bool eager_gc_task_pending_ = false;
+  std::vector<std::unique_ptr<ContextAccount>> context_accounts_;
+  bool budget_task_pending_ = false;
   base::RandomNumberGenerator random_number_generator_;
 };
 
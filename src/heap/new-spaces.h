@@ -225,6 +225,12 @@ class SemiSpaceObjectIterator : public ObjectIterator {
 //
 // The new space consists of a contiguous pair of semispaces.  It simply
 // forwards most functions to the appropriate semispace.
+//
+// The address space of both semispaces is reserved up front. With
+// --uncommit-from-space only the to-space stays committed between GCs; the
+// from-space is recommitted right before the next GC. Survivors are still
+// copied between the semispaces, there is no paged new space that promotes
+// or compacts young objects page by page.
 
 class V8_EXPORT_PRIVATE NewSpace
     : NON_EXPORTED_BASE(public SpaceWithLinearArea) {
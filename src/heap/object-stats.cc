@@ -8,6 +8,7 @@
 #include <unordered_set>
 
 #include "src/base/bits.h"
+#include "src/base/optional.h"
 #include "src/codegen/assembler-inl.h"
 #include "src/codegen/compilation-cache.h"
 #include "src/common/globals.h"
@@ -1073,13 +1074,16 @@ class ObjectStatsVisitor {
         dead_collector_(dead_collector),
         marking_state_(
             heap->mark_compact_collector()->non_atomic_marking_state()),
-        phase_(phase) {}
+        phase_(phase),
+        collect_field_stats_(
+            dead_collector ? ObjectStatsCollectorImpl::CollectFieldStats::kYes
+                           : ObjectStatsCollectorImpl::CollectFieldStats::kNo) {
+  }
 
   void Visit(HeapObject obj) {
     if (marking_state_->IsBlack(obj)) {
-      live_collector_->CollectStatistics(
-          obj, phase_, ObjectStatsCollectorImpl::CollectFieldStats::kYes);
-    } else {
+      live_collector_->CollectStatistics(obj, phase_, collect_field_stats_);
+    } else if (dead_collector_) {
       DCHECK(!marking_state_->IsGrey(obj));
       dead_collector_->CollectStatistics(
           obj, phase_, ObjectStatsCollectorImpl::CollectFieldStats::kNo);
@@ -1091,6 +1095,7 @@ class ObjectStatsVisitor {
   ObjectStatsCollectorImpl* dead_collector_;
   MarkCompactCollector::NonAtomicMarkingState* marking_state_;
   ObjectStatsCollectorImpl::Phase phase_;
+  ObjectStatsCollectorImpl::CollectFieldStats collect_field_stats_;
 };
 
 namespace {
@@ -1107,10 +1112,12 @@ void IterateHeap(Heap* heap, ObjectStatsVisitor* visitor) {
 
 void ObjectStatsCollector::Collect() {
   ObjectStatsCollectorImpl live_collector(heap_, live_);
-  ObjectStatsCollectorImpl dead_collector(heap_, dead_);
+  base::Optional<ObjectStatsCollectorImpl> dead_collector;
+  if (dead_) dead_collector.emplace(heap_, dead_);
   live_collector.CollectGlobalStatistics();
   for (int i = 0; i < ObjectStatsCollectorImpl::kNumberOfPhases; i++) {
-    ObjectStatsVisitor visitor(heap_, &live_collector, &dead_collector,
+    ObjectStatsVisitor visitor(heap_, &live_collector,
+                               dead_ ? &dead_collector.value() : nullptr,
                                static_cast<ObjectStatsCollectorImpl::Phase>(i));
     IterateHeap(heap_, &visitor);
   }
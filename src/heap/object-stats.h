@@ -131,6 +131,9 @@ class ObjectStats {
     return object_sizes_last_time_[index];
   }
 
+  size_t object_count(size_t index) { return object_counts_[index]; }
+  size_t object_size(size_t index) { return object_sizes_[index]; }
+
   Isolate* isolate();
   Heap* heap() { return heap_; }
 
@@ -180,11 +183,11 @@ class ObjectStatsCollector {
       : heap_(heap), live_(live), dead_(dead) {
     DCHECK_NOT_NULL(heap_);
     DCHECK_NOT_NULL(live_);
-    DCHECK_NOT_NULL(dead_);
   }
 
   // Collects type information of live and dead objects. Requires mark bits to
-  // be present.
+  // be present. Without |dead| stats, dead objects are skipped and no field
+  // statistics are collected, which makes collection considerably cheaper.
   void Collect();
 
  private:
@@ -0,0 +1,126 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/pretenuring-sampler.h"
+
+#include "src/execution/frames-inl.h"
+#include "src/execution/isolate.h"
+#include "src/flags/flags.h"
+#include "src/handles/global-handles.h"
+#include "src/heap/allocation-observer.h"
+#include "src/heap/heap-inl.h"
+#include "src/logging/counters.h"
+#include "src/objects/allocation-site.h"
+#include "src/objects/shared-function-info.h"
+
+namespace v8 {
+namespace internal {
+
+class PretenuringSampler::Observer final : public AllocationObserver {
+ public:
+  explicit Observer(PretenuringSampler* sampler)
+      : AllocationObserver(FLAG_sampling_pretenuring_interval),
+        sampler_(sampler) {}
+
+  void Step(int bytes_allocated, Address soon_object, size_t size) override {
+    if (soon_object) sampler_->SampleObject(soon_object, size);
+  }
+
+ private:
+  PretenuringSampler* const sampler_;
+};
+
+PretenuringSampler::PretenuringSampler(Heap* heap)
+    : heap_(heap), observer_(new Observer(this)) {
+  heap_->new_space()->AddAllocationObserver(observer_.get());
+}
+
+PretenuringSampler::~PretenuringSampler() {
+  heap_->new_space()->RemoveAllocationObserver(observer_.get());
+}
+
+void PretenuringSampler::SampleObject(Address soon_object, size_t size) {
+  DisallowGarbageCollection no_gc;
+  Isolate* isolate = heap_->isolate();
+  // Allocations are attributed to the bytecode that caused them, including
+  // allocations in builtins and runtime functions called from it. Frames of
+  // optimized code cannot be mapped back to a bytecode offset at arbitrary
+  // allocation points and are skipped.
+  JavaScriptFrameIterator it(isolate);
+  if (it.done() || !it.frame()->is_unoptimized()) return;
+  UnoptimizedFrame* frame = UnoptimizedFrame::cast(it.frame());
+  uint64_t site_key =
+      SiteKey(frame->function().shared().Hash(), frame->GetBytecodeOffset());
+
+  // The object is not initialized yet. Make the area iterable before it is
+  // referenced by a handle that the GC may visit.
+  heap_->CreateFillerObjectAt(soon_object, static_cast<int>(size),
+                              ClearRecordedSlots::kNo);
+  pending_samples_.push_back(std::make_unique<Sample>(
+      site_key, isolate, HeapObject::FromAddress(soon_object)));
+}
+
+void PretenuringSampler::RecordRedirectedAllocation() {
+  redirected_allocations_.fetch_add(1, std::memory_order_relaxed);
+  heap_->isolate()
+      ->counters()
+      ->sampled_pretenuring_redirected_allocations()
+      ->Increment();
+}
+
+void PretenuringSampler::ProcessSamples() {
+  int samples = 0;
+  int survived = 0;
+  int new_decisions = 0;
+  for (auto& sample : pending_samples_) {
+    SiteCounts& counts = site_counts_[sample->site_key];
+    counts.samples++;
+    samples++;
+    if (sample->object.IsAlive()) {
+      counts.survived++;
+      survived++;
+    }
+    if (counts.samples < kMinimumSamples) continue;
+    double ratio = static_cast<double>(counts.survived) / counts.samples;
+    if (ratio < AllocationSite::kPretenureRatio) continue;
+    {
+      base::MutexGuard guard(&mutex_);
+      if (!pretenured_sites_.insert(sample->site_key).second) continue;
+    }
+    heap_->isolate()->counters()->sampled_pretenured_sites()->Increment();
+    new_decisions++;
+    if (FLAG_trace_pretenuring) {
+      PrintIsolate(heap_->isolate(),
+                   "pretenuring-sampler: pretenure site function=0x%x "
+                   "offset=%d ratio=%.2f\n",
+                   static_cast<uint32_t>(sample->site_key >> 32),
+                   static_cast<int>(static_cast<uint32_t>(sample->site_key)),
+                   ratio);
+    }
+  }
+  pending_samples_.clear();
+
+  if (FLAG_trace_pretenuring_statistics && samples > 0) {
+    PrintIsolate(heap_->isolate(),
+                 "pretenuring-sampler: samples=%d survived=%d "
+                 "new_decisions=%d pretenured_sites=%zu "
+                 "redirected_allocations=%zu\n",
+                 samples, survived, new_decisions, pretenured_sites(),
+                 redirected_allocations());
+  }
+}
+
+AllocationType PretenuringSampler::GetAllocationType(uint64_t site_key) const {
+  base::MutexGuard guard(&mutex_);
+  return pretenured_sites_.count(site_key) ? AllocationType::kOld
+                                           : AllocationType::kYoung;
+}
+
+size_t PretenuringSampler::pretenured_sites() const {
+  base::MutexGuard guard(&mutex_);
+  return pretenured_sites_.size();
+}
+
+}  // namespace internal
+}  // namespace v8
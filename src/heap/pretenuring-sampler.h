@@ -0,0 +1,101 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_PRETENURING_SAMPLER_H_
+#define V8_HEAP_PRETENURING_SAMPLER_H_
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "src/base/platform/mutex.h"
+#include "src/common/globals.h"
+#include "src/handles/global-handles.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// Pretenuring feedback for allocations that are not tracked by an
+// AllocationSite, e.g. closures, contexts, or strings created by builtins.
+//
+// Young generation allocations are sampled every
+// --sampling-pretenuring-interval bytes and attributed to the bytecode that
+// the topmost unoptimized frame is executing. A site is keyed by the hash of
+// its SharedFunctionInfo and its bytecode offset, which stays stable across
+// GCs and can be computed by the compiler. After a GC, a sample counts as
+// survived if its object is still alive. Sites whose samples survive at
+// AllocationSite::kPretenureRatio or more are pretenured: optimized code
+// allocates their objects in old space directly, unless the bytecode already
+// requested old space allocation for them.
+class PretenuringSampler final {
+ public:
+  explicit PretenuringSampler(Heap* heap);
+  ~PretenuringSampler();
+
+  PretenuringSampler(const PretenuringSampler&) = delete;
+  PretenuringSampler& operator=(const PretenuringSampler&) = delete;
+
+  static uint64_t SiteKey(uint32_t function_hash, int bytecode_offset) {
+    return (static_cast<uint64_t>(function_hash) << 32) |
+           static_cast<uint32_t>(bytecode_offset);
+  }
+
+  // Digests the samples taken since the previous GC. Called after every GC.
+  void ProcessSamples();
+
+  // Can be called from background compile threads.
+  AllocationType GetAllocationType(uint64_t site_key) const;
+
+  size_t pretenured_sites() const;
+
+  // Called by the compiler for every allocation that it moved from young to
+  // old space because of a pretenuring decision. Can be called from
+  // background compile threads.
+  void RecordRedirectedAllocation();
+
+  size_t redirected_allocations() const {
+    return redirected_allocations_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  class Observer;
+
+  struct Sample {
+    Sample(uint64_t site_key, Isolate* isolate, HeapObject object)
+        : site_key(site_key), object(isolate, object) {}
+
+    uint64_t site_key;
+    PhantomGlobalHandle object;
+  };
+
+  struct SiteCounts {
+    int samples = 0;
+    int survived = 0;
+  };
+
+  // Minimum number of samples before a site is considered for pretenuring.
+  static const int kMinimumSamples = 8;
+
+  void SampleObject(Address soon_object, size_t size);
+
+  Heap* const heap_;
+  std::unique_ptr<Observer> observer_;
+
+  std::vector<std::unique_ptr<Sample>> pending_samples_;
+  std::unordered_map<uint64_t, SiteCounts> site_counts_;
+  std::atomic<size_t> redirected_allocations_{0};
+
+  // Guards |pretenured_sites_| which is read by concurrent compile jobs.
+  mutable base::Mutex mutex_;
+  std::unordered_set<uint64_t> pretenured_sites_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_PRETENURING_SAMPLER_H_
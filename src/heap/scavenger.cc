@@ -4,6 +4,9 @@
 
 #include "src/heap/scavenger.h"
 
+#include <algorithm>
+
+#include "src/base/platform/platform.h"
 #include "src/heap/array-buffer-sweeper.h"
 #include "src/heap/barrier.h"
 #include "src/heap/gc-tracer.h"
@@ -188,7 +191,23 @@ ScavengerCollector::JobTask::JobTask(
       remaining_memory_chunks_(memory_chunks_.size()),
       generator_(memory_chunks_.size()),
       copied_list_(copied_list),
-      promotion_list_(promotion_list) {}
+      promotion_list_(promotion_list) {
+  if (!FLAG_numa_aware_heap) return;
+  std::stable_sort(memory_chunks_.begin(), memory_chunks_.end(),
+                   [](const auto& a, const auto& b) {
+                     return a.second->numa_node() < b.second->numa_node();
+                   });
+  numa_node_ranges_.resize(base::OS::NumberOfNumaNodes(), {0, 0});
+  for (size_t i = 0; i < memory_chunks_.size(); ++i) {
+    const int node = memory_chunks_[i].second->numa_node();
+    if (node < 0 || static_cast<size_t>(node) >= numa_node_ranges_.size()) {
+      continue;
+    }
+    auto& range = numa_node_ranges_[node];
+    if (range.first == range.second) range.first = i;
+    range.second = i + 1;
+  }
+}
 
 void ScavengerCollector::JobTask::Run(JobDelegate* delegate) {
   DCHECK_LT(delegate->GetTaskId(), scavengers_->size());
@@ -234,6 +253,7 @@ void ScavengerCollector::JobTask::ProcessItems(JobDelegate* delegate,
 
 void ScavengerCollector::JobTask::ConcurrentScavengePages(
     Scavenger* scavenger) {
+  if (!numa_node_ranges_.empty()) ScavengeLocalPages(scavenger);
   while (remaining_memory_chunks_.load(std::memory_order_relaxed) > 0) {
     base::Optional<size_t> index = generator_.GetNext();
     if (!index) return;
@@ -249,6 +269,61 @@ void ScavengerCollector::JobTask::ConcurrentScavengePages(
   }
 }
 
+void ScavengerCollector::JobTask::ScavengeLocalPages(Scavenger* scavenger) {
+  const int node = base::OS::GetCurrentNumaNode();
+  if (node < 0 || static_cast<size_t>(node) >= numa_node_ranges_.size()) {
+    return;
+  }
+  const auto& range = numa_node_ranges_[node];
+  for (size_t i = range.first; i < range.second; ++i) {
+    auto& work_item = memory_chunks_[i];
+    if (!work_item.first.TryAcquire()) continue;
+    scavenger->ScavengePage(work_item.second);
+    if (remaining_memory_chunks_.fetch_sub(1, std::memory_order_relaxed) <= 1) {
+      return;
+    }
+  }
+}
+
+ScavengerCollector::FreeRememberedSetJobTask::FreeRememberedSetJobTask(
+    Heap* heap, Worklist<MemoryChunk*, 64>* empty_chunks)
+    : heap_(heap), empty_chunks_(empty_chunks) {}
+
+void ScavengerCollector::FreeRememberedSetJobTask::Run(JobDelegate* delegate) {
+  // The joining thread is accounted for by SCAVENGER_FREE_REMEMBERED_SET.
+  if (delegate->IsJoiningThread()) {
+    FreeEmptyBuckets(empty_chunks_, delegate->GetTaskId());
+  } else {
+    TRACE_GC_EPOCH(heap_->tracer(),
+                   GCTracer::Scope::SCAVENGER_BACKGROUND_FREE_REMEMBERED_SET,
+                   ThreadKind::kBackground);
+    FreeEmptyBuckets(empty_chunks_, delegate->GetTaskId());
+  }
+}
+
+size_t ScavengerCollector::FreeRememberedSetJobTask::GetMaxConcurrency(
+    size_t worker_count) const {
+  // Each task drains whole segments of the worklist, so no chunks are left
+  // behind in local segments once a task is done.
+  return std::min<size_t>(kMaxScavengerTasks,
+                          worker_count + empty_chunks_->GlobalPoolSize());
+}
+
+// static
+void ScavengerCollector::FreeEmptyBuckets(
+    Worklist<MemoryChunk*, 64>* empty_chunks, int task_id) {
+  MemoryChunk* chunk;
+  while (empty_chunks->Pop(task_id, &chunk)) {
+    // Since sweeping was already restarted only check chunks that already got
+    // swept.
+    if (chunk->SweepingDone()) {
+      RememberedSet<OLD_TO_NEW>::CheckPossiblyEmptyBuckets(chunk);
+    } else {
+      chunk->possibly_empty_buckets()->Release();
+    }
+  }
+}
+
 ScavengerCollector::ScavengerCollector(Heap* heap)
     : isolate_(heap->isolate()), heap_(heap) {}
 
@@ -393,6 +468,18 @@ void ScavengerCollector::CollectGarbage() {
     }
   }
 
+  // Empty remembered set buckets are released on worker threads while the
+  // main thread finalizes the scavenge. The job only touches old-to-new slot
+  // sets, which are not used by the steps below, and must be joined before
+  // the mutator resumes as the write barrier inserts into slot sets
+  // non-atomically.
+  std::unique_ptr<JobHandle> free_remembered_set_job;
+  if (FLAG_parallel_scavenge && !empty_chunks.IsEmpty()) {
+    free_remembered_set_job = V8::GetCurrentPlatform()->PostJob(
+        v8::TaskPriority::kUserBlocking,
+        std::make_unique<FreeRememberedSetJobTask>(heap_, &empty_chunks));
+  }
+
   {
     // Update references into new space
     TRACE_GC(heap_->tracer(), GCTracer::Scope::SCAVENGER_SCAVENGE_UPDATE_REFS);
@@ -427,17 +514,12 @@ void ScavengerCollector::CollectGarbage() {
 
   {
     TRACE_GC(heap_->tracer(), GCTracer::Scope::SCAVENGER_FREE_REMEMBERED_SET);
-    MemoryChunk* chunk;
-
-    while (empty_chunks.Pop(kMainThreadId, &chunk)) {
-      // Since sweeping was already restarted only check chunks that already got
-      // swept.
-      if (chunk->SweepingDone()) {
-        RememberedSet<OLD_TO_NEW>::CheckPossiblyEmptyBuckets(chunk);
-      } else {
-        chunk->possibly_empty_buckets()->Release();
-      }
+    if (free_remembered_set_job) {
+      free_remembered_set_job->Join();
+    } else {
+      FreeEmptyBuckets(&empty_chunks, kMainThreadId);
     }
+    DCHECK(empty_chunks.IsEmpty());
 
 #ifdef DEBUG
     RememberedSet<OLD_TO_NEW>::IterateMemoryChunks(
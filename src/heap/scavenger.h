@@ -12,6 +12,7 @@
 #include "src/heap/parallel-work-item.h"
 #include "src/heap/slot-set.h"
 #include "src/heap/worklist.h"
+#include "testing/gtest/include/gtest/gtest_prod.h"  // nogncheck
 
 namespace v8 {
 namespace internal {
@@ -288,6 +289,9 @@ class ScavengerCollector {
    private:
     void ProcessItems(JobDelegate* delegate, Scavenger* scavenger);
     void ConcurrentScavengePages(Scavenger* scavenger);
+    // With --numa-aware-heap, scavenges the pages on the NUMA node of the
+    // current thread before any other page.
+    void ScavengeLocalPages(Scavenger* scavenger);
 
     ScavengerCollector* outer_;
 
@@ -295,9 +299,28 @@ class ScavengerCollector {
     std::vector<std::pair<ParallelWorkItem, MemoryChunk*>> memory_chunks_;
     std::atomic<size_t> remaining_memory_chunks_{0};
     IndexGenerator generator_;
+    // Ranges of |memory_chunks_| per NUMA node, which are sorted by node.
+    std::vector<std::pair<size_t, size_t>> numa_node_ranges_;
 
     Scavenger::CopiedList* copied_list_;
     Scavenger::PromotionList* promotion_list_;
+
+    FRIEND_TEST(HeapTest, ScavengerJobOrdersPagesByNumaNode);
+  };
+
+  // Releases the empty old-to-new remembered set buckets found during
+  // scavenging, while the main thread finalizes the scavenge.
+  class FreeRememberedSetJobTask : public v8::JobTask {
+   public:
+    FreeRememberedSetJobTask(Heap* heap,
+                             Worklist<MemoryChunk*, 64>* empty_chunks);
+
+    void Run(JobDelegate* delegate) override;
+    size_t GetMaxConcurrency(size_t worker_count) const override;
+
+   private:
+    Heap* const heap_;
+    Worklist<MemoryChunk*, 64>* const empty_chunks_;
   };
 
   void MergeSurvivingNewLargeObjects(
@@ -312,6 +335,9 @@ class ScavengerCollector {
 
   void SweepArrayBufferExtensions();
 
+  static void FreeEmptyBuckets(Worklist<MemoryChunk*, 64>* empty_chunks,
+                               int task_id);
+
   void IterateStackAndScavenge(
       RootScavengeVisitor* root_scavenge_visitor,
       std::vector<std::unique_ptr<Scavenger>>* scavengers, int main_thread_id);
@@ -321,6 +347,7 @@ class ScavengerCollector {
   SurvivingNewLargeObjectsMap surviving_new_large_objects_;
 
   friend class Scavenger;
+  FRIEND_TEST(HeapTest, ScavengerJobOrdersPagesByNumaNode);
 };
 
 }  // namespace internal
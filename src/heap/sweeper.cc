@@ -4,6 +4,7 @@
 
 #include "src/heap/sweeper.h"
 
+#include "src/base/platform/elapsed-timer.h"
 #include "src/common/globals.h"
 #include "src/execution/vm-state-inl.h"
 #include "src/heap/code-object-registry.h"
@@ -96,16 +97,25 @@ class Sweeper::SweeperJob final : public JobTask {
   }
 
   size_t GetMaxConcurrency(size_t worker_count) const override {
-    const size_t kPagePerTask = 2;
     return std::min<size_t>(
-        kMaxSweeperTasks,
-        worker_count +
-            (sweeper_->ConcurrentSweepingPageCount() + kPagePerTask - 1) /
-                kPagePerTask);
+        sweeper_->MaxConcurrentSweeperTasks(),
+        worker_count + sweeper_->ConcurrentSweepingTaskCount());
   }
 
  private:
   void RunImpl(JobDelegate* delegate) {
+    base::ElapsedTimer timer;
+    timer.Start();
+    size_t swept_bytes = 0;
+    SweepSpaces(delegate, &swept_bytes);
+    if (swept_bytes == 0) return;
+    sweeper_->concurrent_swept_bytes_.fetch_add(swept_bytes,
+                                                std::memory_order_relaxed);
+    sweeper_->concurrent_sweeping_time_us_.fetch_add(
+        timer.Elapsed().InMicroseconds(), std::memory_order_relaxed);
+  }
+
+  void SweepSpaces(JobDelegate* delegate, size_t* swept_bytes) {
     const int offset = delegate->GetTaskId();
     for (int i = 0; i < kNumberOfSweepingSpaces; i++) {
       const AllocationSpace space_id = static_cast<AllocationSpace>(
@@ -114,7 +124,9 @@ class Sweeper::SweeperJob final : public JobTask {
       // Do not sweep code space concurrently.
       if (space_id == CODE_SPACE) continue;
       DCHECK(IsValidSweepingSpace(space_id));
-      if (!sweeper_->ConcurrentSweepSpace(space_id, delegate)) return;
+      if (!sweeper_->ConcurrentSweepSpace(space_id, delegate, swept_bytes)) {
+        return;
+      }
     }
   }
   Sweeper* const sweeper_;
@@ -182,6 +194,7 @@ void Sweeper::StartSweeperTasks() {
   DCHECK(!job_handle_ || !job_handle_->IsValid());
   if (FLAG_concurrent_sweeping && sweeping_in_progress_ &&
       !heap_->delay_sweeper_tasks_for_testing_) {
+    UpdatePagesPerTask();
     job_handle_ = V8::GetCurrentPlatform()->PostJob(
         TaskPriority::kUserVisible,
         std::make_unique<SweeperJob>(heap_->isolate(), this));
@@ -224,9 +237,36 @@ void Sweeper::EnsureCompleted() {
   ForAllSweepingSpaces([this](AllocationSpace space) {
     CHECK(sweeping_list_[GetSweepSpaceIndex(space)].empty());
   });
+  ReportConcurrentSweepingThroughput();
   sweeping_in_progress_ = false;
 }
 
+void Sweeper::UpdatePagesPerTask() {
+  const double speed =
+      heap_->tracer()->ConcurrentSweepingSpeedInBytesPerMillisecond();
+  if (speed == 0) {
+    pages_per_task_ = kDefaultPagesPerTask;
+    return;
+  }
+  // Fast sweeping needs more pages per task to amortize the cost of starting
+  // a task, while slow sweeping spreads out over more tasks.
+  const double pages = speed * kMinTaskDurationInMs /
+                       MemoryChunkLayout::AllocatableMemoryInDataPage();
+  pages_per_task_ = static_cast<size_t>(
+      std::max(1.0, std::min(pages, static_cast<double>(kMaxPagesPerTask))));
+}
+
+void Sweeper::ReportConcurrentSweepingThroughput() {
+  const size_t bytes =
+      concurrent_swept_bytes_.exchange(0, std::memory_order_relaxed);
+  const int64_t time_us =
+      concurrent_sweeping_time_us_.exchange(0, std::memory_order_relaxed);
+  if (bytes == 0 || time_us == 0) return;
+  heap_->tracer()->AddConcurrentSweepingEvent(
+      static_cast<double>(time_us) / base::Time::kMicrosecondsPerMillisecond,
+      bytes);
+}
+
 void Sweeper::DrainSweepingWorklistForSpace(AllocationSpace space) {
   if (!sweeping_in_progress_) return;
   ParallelSweepSpace(space, 0);
@@ -420,14 +460,26 @@ int Sweeper::RawSweep(
       p->owner()->free_list()->GuaranteedAllocatable(max_freed_bytes));
 }
 
-size_t Sweeper::ConcurrentSweepingPageCount() {
+size_t Sweeper::ConcurrentSweepingTaskCount() {
   base::MutexGuard guard(&mutex_);
-  return sweeping_list_[GetSweepSpaceIndex(OLD_SPACE)].size() +
-         sweeping_list_[GetSweepSpaceIndex(MAP_SPACE)].size();
+  size_t tasks = 0;
+  for (AllocationSpace space : {OLD_SPACE, MAP_SPACE}) {
+    const size_t pages = sweeping_list_[GetSweepSpaceIndex(space)].size();
+    tasks += (pages + pages_per_task_ - 1) / pages_per_task_;
+  }
+  return tasks;
+}
+
+size_t Sweeper::MaxConcurrentSweeperTasks() const {
+  if (FLAG_max_sweeper_tasks > 0) {
+    return static_cast<size_t>(FLAG_max_sweeper_tasks);
+  }
+  return V8::GetCurrentPlatform()->NumberOfWorkerThreads();
 }
 
 bool Sweeper::ConcurrentSweepSpace(AllocationSpace identity,
-                                   JobDelegate* delegate) {
+                                   JobDelegate* delegate,
+                                   size_t* swept_bytes) {
   while (!delegate->ShouldYield()) {
     Page* page = GetSweepingPageSafe(identity);
     if (page == nullptr) return true;
@@ -436,6 +488,7 @@ bool Sweeper::ConcurrentSweepSpace(AllocationSpace identity,
     DCHECK(!page->typed_slot_set<OLD_TO_NEW>() &&
            !page->typed_slot_set<OLD_TO_OLD>());
     ParallelSweepPage(page, identity);
+    *swept_bytes += page->area_size();
   }
   return false;
 }
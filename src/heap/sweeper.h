@@ -5,6 +5,7 @@
 #ifndef V8_HEAP_SWEEPER_H_
 #define V8_HEAP_SWEEPER_H_
 
+#include <atomic>
 #include <deque>
 #include <map>
 #include <vector>
@@ -131,7 +132,12 @@ class Sweeper {
 
   static const int kNumberOfSweepingSpaces =
       LAST_GROWABLE_PAGED_SPACE - FIRST_GROWABLE_PAGED_SPACE + 1;
-  static const int kMaxSweeperTasks = 3;
+  // Number of pages handed to each sweeper task when no sweeping throughput
+  // has been measured yet.
+  static const size_t kDefaultPagesPerTask = 2;
+  static const size_t kMaxPagesPerTask = 64;
+  // Sweeper tasks are sized to run for at least this long.
+  static constexpr double kMinTaskDurationInMs = 1.0;
 
   template <typename Callback>
   void ForAllSweepingSpaces(Callback callback) const {
@@ -176,11 +182,21 @@ class Sweeper {
     return is_done;
   }
 
-  size_t ConcurrentSweepingPageCount();
+  // Returns the number of tasks needed for the pages that are left to sweep
+  // concurrently, given |pages_per_task_| pages per task and space.
+  size_t ConcurrentSweepingTaskCount();
+  size_t MaxConcurrentSweeperTasks() const;
+
+  // Derives |pages_per_task_| from the throughput reported to the GCTracer.
+  void UpdatePagesPerTask();
+  // Reports the throughput of sweeper tasks since the last report.
+  void ReportConcurrentSweepingThroughput();
 
   // Concurrently sweeps many page from the given space. Returns true if there
-  // are no more pages to sweep in the given space.
-  bool ConcurrentSweepSpace(AllocationSpace identity, JobDelegate* delegate);
+  // are no more pages to sweep in the given space. Adds the area size of the
+  // swept pages to |swept_bytes|.
+  bool ConcurrentSweepSpace(AllocationSpace identity, JobDelegate* delegate,
+                            size_t* swept_bytes);
 
   // Sweeps incrementally one page from the given space. Returns true if
   // there are no more pages to sweep in the given space.
@@ -226,6 +242,13 @@ class Sweeper {
   bool iterability_in_progress_;
   bool iterability_task_started_;
   bool should_reduce_memory_;
+
+  // Written on the main thread before tasks are posted.
+  size_t pages_per_task_ = kDefaultPagesPerTask;
+  // Bytes swept by sweeper tasks and the time they took, not yet reported to
+  // the GCTracer.
+  std::atomic<size_t> concurrent_swept_bytes_{0};
+  std::atomic<int64_t> concurrent_sweeping_time_us_{0};
 };
 
 }  // namespace internal
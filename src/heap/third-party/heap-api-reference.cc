@@ -0,0 +1,141 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/execution/isolate.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/local-heap.h"
+#include "src/heap/third-party/heap-api.h"
+#include "src/heap/third-party/reference-heap.h"
+
+namespace v8 {
+namespace internal {
+namespace third_party_heap {
+
+// static
+std::unique_ptr<Heap> Heap::New(v8::internal::Isolate* isolate) {
+  std::unique_ptr<Heap> heap(new Heap());
+  heap->impl_ = new Impl(isolate);
+  return heap;
+}
+
+Heap::~Heap() { delete impl_; }
+
+// static
+v8::internal::Isolate* Heap::GetIsolate(Address address) {
+  Impl* impl = Impl::FromAddress(address);
+  return impl ? impl->isolate() : nullptr;
+}
+
+AllocationResult Heap::Allocate(size_t size_in_bytes, AllocationType type,
+                                AllocationAlignment align) {
+  return impl()->main_thread_allocator()->Allocate(
+      static_cast<int>(size_in_bytes), type, align);
+}
+
+LocalAllocator* Heap::NewLocalAllocator(LocalHeap* local_heap) {
+  if (local_heap->is_main_thread()) return impl()->main_thread_allocator();
+  return impl()->NewLocalAllocator();
+}
+
+void Heap::DisposeLocalAllocator(LocalAllocator* allocator) {
+  if (allocator->is_main_thread()) return;
+  impl()->DisposeLocalAllocator(allocator);
+}
+
+AllocationResult Heap::Allocate(LocalAllocator* allocator, size_t size_in_bytes,
+                                AllocationType type,
+                                AllocationAlignment align) {
+  return allocator->Allocate(static_cast<int>(size_in_bytes), type, align);
+}
+
+Address Heap::GetObjectFromInnerPointer(Address inner_pointer) {
+  return impl()->GetObjectFromInnerPointer(inner_pointer);
+}
+
+const base::AddressRegion& Heap::GetCodeRange() {
+  return impl()->code_region();
+}
+
+bool Heap::IsPendingAllocation(HeapObject object) {
+  return impl()->IsPendingAllocation(object.address());
+}
+
+// static
+bool Heap::InSpace(Address address, AllocationSpace space) {
+  Impl* impl = Impl::FromAddress(address);
+  return impl && impl->InSpace(address, space);
+}
+
+// static
+bool Heap::InOldSpace(Address address) {
+  return InSpace(address, OLD_SPACE);
+}
+
+// static
+bool Heap::InReadOnlySpace(Address address) {
+  return InSpace(address, RO_SPACE);
+}
+
+// static
+bool Heap::InLargeObjectSpace(Address address) {
+  return InSpace(address, LO_SPACE) || InSpace(address, CODE_LO_SPACE);
+}
+
+// static
+bool Heap::IsValidHeapObject(HeapObject object) {
+  Impl* impl = Impl::FromAddress(object.address());
+  return impl && impl->OwnerBlock(object.address()) != nullptr;
+}
+
+// static
+bool Heap::IsImmovable(HeapObject) {
+  // The reference heap never moves objects.
+  return true;
+}
+
+// static
+bool Heap::IsValidCodeObject(HeapObject object) {
+  return InSpace(object.address(), CODE_SPACE) ||
+         InSpace(object.address(), CODE_LO_SPACE);
+}
+
+void Heap::ResetIterator() { impl()->ResetIterator(); }
+
+HeapObject Heap::NextObject() { return impl()->NextObject(); }
+
+bool Heap::CollectGarbage() {
+  impl()->CollectGarbage();
+  return true;
+}
+
+bool Heap::CollectNurseryGarbage() {
+  impl()->CollectNurseryGarbage();
+  return true;
+}
+
+Address Heap::card_table_base() { return impl()->card_table_base(); }
+
+// static
+void Heap::WriteBarrier(HeapObject host, Address slot, HeapObject value) {
+  Impl* impl = Impl::FromAddress(host.address());
+  if (impl) impl->RecordWrite(host, slot, value);
+}
+
+// static
+void Heap::WriteBarrierForRange(HeapObject host, Address start, Address end) {
+  Impl* impl = Impl::FromAddress(host.address());
+  if (impl) impl->RecordWriteRange(host, start, end);
+}
+
+// static
+bool Heap::InYoungGeneration(HeapObject object) {
+  Impl* impl = Impl::FromAddress(object.address());
+  return impl && impl->InYoungGeneration(object.address());
+}
+
+size_t Heap::Capacity() { return impl()->Capacity(); }
+
+}  // namespace third_party_heap
+}  // namespace internal
+}  // namespace v8
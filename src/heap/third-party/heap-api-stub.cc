@@ -22,9 +22,13 @@ namespace third_party_heap {
 
 class Impl {};
 
+class LocalAllocator {};
+
 // static
 std::unique_ptr<Heap> Heap::New(v8::internal::Isolate*) { return nullptr; }
 
+Heap::~Heap() = default;
+
 // static
 v8::internal::Isolate* Heap::GetIsolate(Address) { return nullptr; }
 
@@ -32,6 +36,15 @@ AllocationResult Heap::Allocate(size_t, AllocationType, AllocationAlignment) {
   return AllocationResult();
 }
 
+LocalAllocator* Heap::NewLocalAllocator(LocalHeap*) { return nullptr; }
+
+void Heap::DisposeLocalAllocator(LocalAllocator*) {}
+
+AllocationResult Heap::Allocate(LocalAllocator*, size_t, AllocationType,
+                                AllocationAlignment) {
+  return AllocationResult();
+}
+
 Address Heap::GetObjectFromInnerPointer(Address) { return 0; }
 
 const base::AddressRegion& Heap::GetCodeRange() {
@@ -58,6 +71,19 @@ bool Heap::IsValidCodeObject(HeapObject) { return false; }
 
 bool Heap::CollectGarbage() { return false; }
 
+Address Heap::card_table_base() { return kNullAddress; }
+
+// static
+void Heap::WriteBarrier(HeapObject, Address, HeapObject) {}
+
+// static
+void Heap::WriteBarrierForRange(HeapObject, Address, Address) {}
+
+// static
+bool Heap::InYoungGeneration(HeapObject) { return false; }
+
+bool Heap::CollectNurseryGarbage() { return false; }
+
 }  // namespace third_party_heap
 }  // namespace internal
 }  // namespace v8
@@ -13,19 +13,34 @@ namespace v8 {
 class Isolate;
 
 namespace internal {
+
+class LocalHeap;
+
 namespace third_party_heap {
 
 class Impl;
+class LocalAllocator;
 
 class Heap {
  public:
   static std::unique_ptr<Heap> New(v8::internal::Isolate* isolate);
 
+  ~Heap();
+
   static v8::internal::Isolate* GetIsolate(Address address);
 
   AllocationResult Allocate(size_t size_in_bytes, AllocationType type,
                             AllocationAlignment align);
 
+  // Thread-local allocation state of a LocalHeap, created when the LocalHeap
+  // is set up and disposed when it is torn down. The allocator of the main
+  // thread LocalHeap is owned by the heap and backs Allocate() above.
+  LocalAllocator* NewLocalAllocator(LocalHeap* local_heap);
+  void DisposeLocalAllocator(LocalAllocator* allocator);
+
+  AllocationResult Allocate(LocalAllocator* allocator, size_t size_in_bytes,
+                            AllocationType type, AllocationAlignment align);
+
   Address GetObjectFromInnerPointer(Address inner_pointer);
 
   const base::AddressRegion& GetCodeRange();
@@ -51,6 +66,27 @@ class Heap {
 
   bool CollectGarbage();
 
+  // Generational mode (V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL). V8 keeps
+  // treating all objects as old, while young allocations are placed in a
+  // nursery. Stores into the heap mark a card table with one byte per
+  // 1 << kCardSizeLog2 bytes of heap: generated code stores kDirtyCard at
+  // card_table_base() + (slot_address >> kCardSizeLog2).
+  static constexpr int kCardSizeLog2 = 9;
+  static constexpr uint8_t kDirtyCard = 1;
+
+  Address card_table_base();
+
+  // Runtime write barriers recording a single slot and a range of slots of
+  // |host|.
+  static void WriteBarrier(HeapObject host, Address slot, HeapObject value);
+  static void WriteBarrierForRange(HeapObject host, Address start,
+                                   Address end);
+
+  static bool InYoungGeneration(HeapObject object);
+
+  // Collects the nursery, using the dirty cards as roots.
+  bool CollectNurseryGarbage();
+
   size_t Capacity();
 
   V8_INLINE Impl* impl() { return impl_; }
@@ -0,0 +1,691 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/third-party/reference-collector.h"
+
+#include <algorithm>
+
+#include "include/v8-platform.h"
+#include "src/base/bits.h"
+#include "src/codegen/assembler-inl.h"
+#include "src/execution/isolate.h"
+#include "src/handles/global-handles.h"
+#include "src/heap/gc-tracer.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/safepoint.h"
+#include "src/heap/third-party/reference-heap.h"
+#include "src/init/v8.h"
+#include "src/objects/code-inl.h"
+#include "src/objects/objects-body-descriptors-inl.h"
+#include "src/objects/string-table.h"
+#include "src/objects/visitors-inl.h"
+
+namespace v8 {
+namespace internal {
+namespace third_party_heap {
+
+namespace {
+
+// Number of objects processed between checks for yielding and sharing work.
+constexpr size_t kObjectsUntilInterruptCheck = 512;
+
+constexpr size_t kMarkBitsPerCell = 32;
+constexpr size_t kMarkBitCellsPerBlock =
+    Impl::kBlockSize / kTaggedSize / kMarkBitsPerCell;
+
+size_t MarkBitIndex(Address block_start, Address address) {
+  return (address - block_start) >> kTaggedSizeLog2;
+}
+
+// Calls |callback| with the address of every marked object of |block| in
+// ascending order.
+template <typename Callback>
+void IterateMarkedObjects(const Block* block, Address block_start,
+                          Callback callback) {
+  for (size_t cell_index = 0; cell_index < kMarkBitCellsPerBlock;
+       cell_index++) {
+    uint32_t cell = block->mark_bits[cell_index];
+    while (cell) {
+      const size_t bit = base::bits::CountTrailingZeros(cell);
+      callback(block_start +
+               ((cell_index * kMarkBitsPerCell + bit) << kTaggedSizeLog2));
+      cell &= cell - 1;
+    }
+  }
+}
+
+size_t MaxTasks() {
+  if (!FLAG_parallel_marking) return 1;
+  return V8::GetCurrentPlatform()->NumberOfWorkerThreads() + 1;
+}
+
+}  // namespace
+
+// With |dirty_cards_only|, only slots on dirty cards are visited, while
+// references from code objects are always visited. Weak references are
+// pushed to |weak_references| if given, and marked otherwise.
+class Collector::MarkingVisitor final : public ObjectVisitorWithCageBases {
+ public:
+  MarkingVisitor(Collector* collector, MarkingWorklist::Local* local,
+                 WeakReferenceWorklist::Local* weak_references,
+                 bool dirty_cards_only = false)
+      : ObjectVisitorWithCageBases(collector->impl_->heap()),
+        collector_(collector),
+        local_(local),
+        weak_references_(weak_references),
+        dirty_cards_only_(dirty_cards_only) {}
+
+  void VisitPointers(HeapObject host, ObjectSlot start,
+                     ObjectSlot end) final {
+    for (ObjectSlot p = start; p < end; ++p) {
+      if (!ShouldVisit(p.address())) continue;
+      Object object = p.Relaxed_Load(cage_base());
+      if (object.IsHeapObject()) {
+        collector_->MarkObject(HeapObject::cast(object), local_);
+      }
+    }
+  }
+
+  void VisitPointers(HeapObject host, MaybeObjectSlot start,
+                     MaybeObjectSlot end) final {
+    const bool record_weak =
+        weak_references_ != nullptr && !host.IsTransitionArray(cage_base());
+    for (MaybeObjectSlot p = start; p < end; ++p) {
+      if (!ShouldVisit(p.address())) continue;
+      MaybeObject object = p.Relaxed_Load(cage_base());
+      HeapObject heap_object;
+      if (record_weak && object.GetHeapObjectIfWeak(&heap_object)) {
+        weak_references_->Push({host, HeapObjectSlot(p)});
+      } else if (object.GetHeapObject(&heap_object)) {
+        collector_->MarkObject(heap_object, local_);
+      }
+    }
+  }
+
+  void VisitCodePointer(HeapObject host, CodeObjectSlot slot) final {
+    CHECK(V8_EXTERNAL_CODE_SPACE_BOOL);
+    if (!ShouldVisit(slot.address())) return;
+    Object object = slot.Relaxed_Load(code_cage_base());
+    if (object.IsHeapObject()) {
+      collector_->MarkObject(HeapObject::cast(object), local_);
+    }
+  }
+
+  void VisitCodeTarget(Code host, RelocInfo* rinfo) final {
+    collector_->MarkObject(
+        Code::GetCodeFromTargetAddress(rinfo->target_address()), local_);
+  }
+
+  void VisitEmbeddedPointer(Code host, RelocInfo* rinfo) final {
+    collector_->MarkObject(rinfo->target_object(cage_base()), local_);
+  }
+
+  void VisitMapPointer(HeapObject host) final {
+    collector_->MarkObject(host.map(cage_base()), local_);
+  }
+
+ private:
+  bool ShouldVisit(Address slot) const {
+    return !dirty_cards_only_ || collector_->impl_->IsCardDirty(slot);
+  }
+
+  Collector* const collector_;
+  MarkingWorklist::Local* const local_;
+  WeakReferenceWorklist::Local* const weak_references_;
+  const bool dirty_cards_only_;
+};
+
+class Collector::RootMarkingVisitor final : public RootVisitor {
+ public:
+  RootMarkingVisitor(Collector* collector, MarkingWorklist::Local* local)
+      : collector_(collector),
+        local_(local),
+        cage_base_(collector->impl_->isolate()) {}
+
+  void VisitRootPointers(Root root, const char* description,
+                         FullObjectSlot start, FullObjectSlot end) final {
+    for (FullObjectSlot p = start; p < end; ++p) {
+      Object object = *p;
+      if (object.IsHeapObject()) {
+        collector_->MarkObject(HeapObject::cast(object), local_);
+      }
+    }
+  }
+
+  void VisitRootPointers(Root root, const char* description,
+                         OffHeapObjectSlot start,
+                         OffHeapObjectSlot end) final {
+    for (OffHeapObjectSlot p = start; p < end; ++p) {
+      Object object = p.load(cage_base_);
+      if (object.IsHeapObject()) {
+        collector_->MarkObject(HeapObject::cast(object), local_);
+      }
+    }
+  }
+
+ private:
+  Collector* const collector_;
+  MarkingWorklist::Local* const local_;
+  const PtrComprCageBase cage_base_;
+};
+
+// Removes dead strings from the string table.
+class Collector::InternalizedStringTableCleaner final : public RootVisitor {
+ public:
+  explicit InternalizedStringTableCleaner(Collector* collector)
+      : collector_(collector) {}
+
+  void VisitRootPointers(Root root, const char* description,
+                         FullObjectSlot start, FullObjectSlot end) final {
+    UNREACHABLE();
+  }
+
+  void VisitRootPointers(Root root, const char* description,
+                         OffHeapObjectSlot start,
+                         OffHeapObjectSlot end) final {
+    DCHECK_EQ(root, Root::kStringTable);
+    Isolate* isolate = collector_->impl_->isolate();
+    for (OffHeapObjectSlot p = start; p < end; ++p) {
+      Object object = p.load(isolate);
+      if (object.IsHeapObject() &&
+          !collector_->IsMarked(HeapObject::cast(object))) {
+        pointers_removed_++;
+        p.store(StringTable::deleted_element());
+      }
+    }
+  }
+
+  int pointers_removed() const { return pointers_removed_; }
+
+ private:
+  Collector* const collector_;
+  int pointers_removed_ = 0;
+};
+
+// Finalizes dead external strings and removes them from the external string
+// table.
+class Collector::ExternalStringTableCleaner final : public RootVisitor {
+ public:
+  explicit ExternalStringTableCleaner(Collector* collector)
+      : collector_(collector) {}
+
+  void VisitRootPointers(Root root, const char* description,
+                         FullObjectSlot start, FullObjectSlot end) final {
+    v8::internal::Heap* heap = collector_->impl_->heap();
+    const Object the_hole = ReadOnlyRoots(heap).the_hole_value();
+    for (FullObjectSlot p = start; p < end; ++p) {
+      Object object = *p;
+      if (!object.IsHeapObject() ||
+          collector_->IsMarked(HeapObject::cast(object))) {
+        continue;
+      }
+      if (object.IsExternalString()) {
+        heap->FinalizeExternalString(String::cast(object));
+      } else {
+        // The original external string may have been internalized.
+        DCHECK(object.IsThinString());
+      }
+      p.store(the_hole);
+    }
+  }
+
+ private:
+  Collector* const collector_;
+};
+
+// Retains the marked objects of the heap's weak lists.
+class Collector::WeakObjectRetainer final
+    : public v8::internal::WeakObjectRetainer {
+ public:
+  explicit WeakObjectRetainer(Collector* collector) : collector_(collector) {}
+
+  Object RetainAs(Object object) final {
+    return collector_->IsMarked(HeapObject::cast(object)) ? object : Object();
+  }
+
+ private:
+  Collector* const collector_;
+};
+
+class Collector::MarkingJob final : public v8::JobTask {
+ public:
+  MarkingJob(Collector* collector, GCTracer::Scope::ScopeId scope,
+             GCTracer::Scope::ScopeId background_scope)
+      : collector_(collector),
+        scope_(scope),
+        background_scope_(background_scope) {}
+
+  MarkingJob(const MarkingJob&) = delete;
+  MarkingJob& operator=(const MarkingJob&) = delete;
+
+  void Run(JobDelegate* delegate) final {
+    GCTracer* tracer = collector_->impl_->heap()->tracer();
+    if (delegate->IsJoiningThread()) {
+      TRACE_GC(tracer, scope_);
+      collector_->ProcessMarkingWorklist(delegate);
+    } else {
+      TRACE_GC1(tracer, background_scope_, ThreadKind::kBackground);
+      collector_->ProcessMarkingWorklist(delegate);
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const final {
+    // Account for the local segments held by the running workers in addition
+    // to the segments in the global pool.
+    return std::min<size_t>(
+        MaxTasks(), worker_count + collector_->marking_worklist_.Size());
+  }
+
+ private:
+  Collector* const collector_;
+  const GCTracer::Scope::ScopeId scope_;
+  const GCTracer::Scope::ScopeId background_scope_;
+};
+
+class Collector::SweepingJob final : public v8::JobTask {
+ public:
+  SweepingJob(Collector* collector, GCTracer::Scope::ScopeId scope,
+              GCTracer::Scope::ScopeId background_scope)
+      : collector_(collector),
+        scope_(scope),
+        background_scope_(background_scope) {}
+
+  SweepingJob(const SweepingJob&) = delete;
+  SweepingJob& operator=(const SweepingJob&) = delete;
+
+  void Run(JobDelegate* delegate) final {
+    GCTracer* tracer = collector_->impl_->heap()->tracer();
+    if (delegate->IsJoiningThread()) {
+      TRACE_GC(tracer, scope_);
+      SweepBlocks(delegate);
+    } else {
+      TRACE_GC1(tracer, background_scope_, ThreadKind::kBackground);
+      SweepBlocks(delegate);
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const final {
+    const size_t remaining =
+        collector_->blocks_to_sweep_.size() -
+        std::min(collector_->blocks_to_sweep_.size(),
+                 collector_->next_block_to_sweep_.load(
+                     std::memory_order_relaxed));
+    return std::min<size_t>(MaxTasks(), remaining);
+  }
+
+ private:
+  void SweepBlocks(JobDelegate* delegate) {
+    const size_t count = collector_->blocks_to_sweep_.size();
+    while (!delegate->ShouldYield()) {
+      const size_t index = collector_->next_block_to_sweep_.fetch_add(
+          1, std::memory_order_relaxed);
+      if (index >= count) return;
+      collector_->SweepBlock(collector_->blocks_to_sweep_[index]);
+    }
+  }
+
+  Collector* const collector_;
+  const GCTracer::Scope::ScopeId scope_;
+  const GCTracer::Scope::ScopeId background_scope_;
+};
+
+Collector::Collector(Impl* impl) : impl_(impl) {}
+
+void Collector::CollectGarbage() {
+  v8::internal::Heap* heap = impl_->heap();
+  SafepointScope safepoint_scope(heap);
+  nursery_ = false;
+  Prepare();
+  {
+    TRACE_GC(heap->tracer(), GCTracer::Scope::MC_MARK_ROOTS);
+    MarkRoots();
+  }
+  Mark(GCTracer::Scope::MC_MARK, GCTracer::Scope::MC_BACKGROUND_MARKING);
+  ProcessWeakGlobalHandles();
+  ClearNonLiveReferences();
+  Sweep(GCTracer::Scope::MC_SWEEP, GCTracer::Scope::MC_BACKGROUND_SWEEPING);
+  // No old-to-young references are left once the nursery is promoted, and
+  // sweeping cleared the cards of all blocks.
+  impl_->PromoteNursery(blocks_to_sweep_);
+  impl_->UpdateAllocationLimit(live_bytes_);
+  {
+    TRACE_GC(heap->tracer(),
+             GCTracer::Scope::HEAP_EXTERNAL_WEAK_GLOBAL_HANDLES);
+    // Heap::PerformGarbageCollection() is bypassed for third-party heaps.
+    impl_->isolate()->global_handles()->InvokeFirstPassWeakCallbacks();
+  }
+}
+
+void Collector::CollectNurseryGarbage() {
+  DCHECK(V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL);
+  v8::internal::Heap* heap = impl_->heap();
+  SafepointScope safepoint_scope(heap);
+  nursery_ = true;
+  Prepare();
+  {
+    TRACE_GC(heap->tracer(), GCTracer::Scope::SCAVENGER_SCAVENGE_ROOTS);
+    MarkRoots();
+    MarkDirtyCards();
+  }
+  Mark(GCTracer::Scope::SCAVENGER_SCAVENGE_PARALLEL,
+       GCTracer::Scope::SCAVENGER_BACKGROUND_SCAVENGE_PARALLEL);
+  Sweep(GCTracer::Scope::SCAVENGER_SCAVENGE_FINALIZE,
+        GCTracer::Scope::SCAVENGER_BACKGROUND_SCAVENGE_PARALLEL);
+  impl_->PromoteNursery(blocks_to_sweep_);
+}
+
+void Collector::Prepare() {
+  // Buffers and size-class blocks are reassigned after sweeping, which
+  // rebuilds all free lists. Nursery collections do not sweep size-class
+  // blocks, so their free lists stay valid.
+  impl_->ReleaseLocalAllocators();
+  if (!nursery_) impl_->ClearAvailableBlocks();
+  blocks_to_sweep_.clear();
+  for (size_t i = 0; i < impl_->num_blocks_; i++) {
+    Block* block = &impl_->blocks_[i];
+    switch (block->kind) {
+      case Block::Kind::kFree:
+      case Block::Kind::kReadOnly:
+      case Block::Kind::kLargeObjectContinuation:
+        continue;
+      case Block::Kind::kBump:
+      case Block::Kind::kSizeClass:
+      case Block::Kind::kCode:
+      case Block::Kind::kLargeObject:
+        break;
+    }
+    if (nursery_ && !block->young) continue;
+    if (!block->mark_bits) {
+      block->mark_bits.reset(new uint32_t[kMarkBitCellsPerBlock]);
+    }
+    std::fill_n(block->mark_bits.get(), kMarkBitCellsPerBlock, 0);
+    blocks_to_sweep_.push_back(block);
+  }
+  next_block_to_sweep_ = 0;
+  swept_live_bytes_ = 0;
+}
+
+bool Collector::IsMarked(HeapObject object) {
+  const Address address = object.address();
+  Block* block = impl_->OwnerBlock(address);
+  if (block == nullptr || block->kind == Block::Kind::kReadOnly) return true;
+  if (nursery_ && !block->young) return true;
+  const size_t index = MarkBitIndex(impl_->BlockStart(block), address);
+  return block->mark_bits[index / kMarkBitsPerCell] &
+         (1u << (index % kMarkBitsPerCell));
+}
+
+// static
+bool Collector::IsUnmarkedHeapObject(v8::internal::Heap* heap,
+                                     FullObjectSlot p) {
+  Object object = *p;
+  if (!object.IsHeapObject()) return false;
+  Impl* impl = Impl::FromAddress(object.ptr());
+  return impl != nullptr &&
+         !impl->collector_->IsMarked(HeapObject::cast(object));
+}
+
+bool Collector::TryMark(HeapObject object) {
+  const Address address = object.address();
+  Block* block = impl_->OwnerBlock(address);
+  // Read-only objects are never collected and only point to other read-only
+  // objects. Objects outside of the heap are off-heap builtins.
+  if (block == nullptr || block->kind == Block::Kind::kReadOnly) return false;
+  // Old objects are implicitly live during nursery collections.
+  if (nursery_ && !block->young) return false;
+  DCHECK(block->mark_bits);
+  const size_t index = MarkBitIndex(impl_->BlockStart(block), address);
+  const uint32_t mask = 1u << (index % kMarkBitsPerCell);
+  return base::AsAtomic32::SetBits(&block->mark_bits[index / kMarkBitsPerCell],
+                                   mask, mask);
+}
+
+void Collector::MarkObject(HeapObject object, MarkingWorklist::Local* local) {
+  if (TryMark(object)) local->Push(object);
+}
+
+void Collector::MarkRoots() {
+  MarkingWorklist::Local local(&marking_worklist_);
+  RootMarkingVisitor visitor(this, &local);
+  base::EnumSet<SkipRoot> skip;
+  if (!nursery_) skip.Add(SkipRoot::kWeak);
+  impl_->heap()->IterateRoots(&visitor, skip);
+  local.Publish();
+}
+
+void Collector::MarkDirtyCards() {
+  MarkingWorklist::Local local(&marking_worklist_);
+  MarkingVisitor visitor(this, &local, nullptr, true);
+  size_t i = 0;
+  while (i < impl_->num_blocks_) {
+    Block* block = &impl_->blocks_[i];
+    const size_t count =
+        block->kind == Block::Kind::kLargeObject ? block->run_length : 1;
+    i += count;
+    if (block->IsFree() || block->young ||
+        block->kind == Block::Kind::kLargeObjectContinuation) {
+      continue;
+    }
+    const Address start = impl_->BlockStart(block);
+    if (!impl_->HasDirtyCard(start, start + count * Impl::kBlockSize)) {
+      continue;
+    }
+    // Objects are found by walking the block from its start. All buffers were
+    // closed by Prepare(), so the walk only encounters objects and fillers.
+    Address end;
+    switch (block->kind) {
+      case Block::Kind::kSizeClass:
+        end = block->cells_end;
+        break;
+      case Block::Kind::kLargeObject:
+        end = start + HeapObject::FromAddress(start).Size();
+        break;
+      case Block::Kind::kBump:
+      case Block::Kind::kCode:
+      case Block::Kind::kReadOnly:
+        end = impl_->BlockEnd(block);
+        break;
+      case Block::Kind::kFree:
+      case Block::Kind::kLargeObjectContinuation:
+        UNREACHABLE();
+    }
+    Address current = start;
+    while (current < end) {
+      HeapObject object = HeapObject::FromAddress(current);
+      const int size = object.Size();
+      if (!object.IsFreeSpaceOrFiller() &&
+          impl_->HasDirtyCard(current, current + size)) {
+        object.IterateFast(&visitor);
+      }
+      current += size;
+    }
+    impl_->ClearCards(block, count);
+  }
+  local.Publish();
+}
+
+void Collector::Mark(GCTracer::Scope::ScopeId scope,
+                     GCTracer::Scope::ScopeId background_scope) {
+  V8::GetCurrentPlatform()
+      ->PostJob(v8::TaskPriority::kUserBlocking,
+                std::make_unique<MarkingJob>(this, scope, background_scope))
+      ->Join();
+  DCHECK(marking_worklist_.IsEmpty());
+}
+
+void Collector::ProcessMarkingWorklist(JobDelegate* delegate) {
+  MarkingWorklist::Local local(&marking_worklist_);
+  WeakReferenceWorklist::Local weak_references(&weak_references_);
+  MarkingVisitor visitor(this, &local,
+                         nursery_ ? nullptr : &weak_references);
+  HeapObject object;
+  size_t objects_processed = 0;
+  while (local.Pop(&object)) {
+    object.IterateFast(&visitor);
+    if (++objects_processed % kObjectsUntilInterruptCheck != 0) continue;
+    if (delegate->ShouldYield()) break;
+    // Share work with idle workers that found the global pool empty.
+    if (local.IsGlobalEmpty() && !local.IsLocalEmpty()) local.Publish();
+  }
+  local.Publish();
+  weak_references.Publish();
+}
+
+void Collector::ProcessWeakGlobalHandles() {
+  GlobalHandles* global_handles = impl_->isolate()->global_handles();
+  {
+    TRACE_GC(impl_->heap()->tracer(),
+             GCTracer::Scope::MC_MARK_WEAK_CLOSURE_WEAK_HANDLES);
+    global_handles->IterateWeakRootsIdentifyFinalizers(&IsUnmarkedHeapObject);
+    MarkingWorklist::Local local(&marking_worklist_);
+    RootMarkingVisitor visitor(this, &local);
+    global_handles->IterateWeakRootsForFinalizers(&visitor);
+    local.Publish();
+  }
+  // Objects reachable from finalizers are kept alive until the next
+  // collection.
+  Mark(GCTracer::Scope::MC_MARK_WEAK_CLOSURE_WEAK_ROOTS,
+       GCTracer::Scope::MC_BACKGROUND_MARKING);
+  global_handles->IterateWeakRootsForPhantomHandles(&IsUnmarkedHeapObject);
+}
+
+void Collector::ClearNonLiveReferences() {
+  v8::internal::Heap* heap = impl_->heap();
+  Isolate* isolate = impl_->isolate();
+  TRACE_GC(heap->tracer(), GCTracer::Scope::MC_CLEAR);
+  if (isolate->OwnsStringTable()) {
+    TRACE_GC(heap->tracer(), GCTracer::Scope::MC_CLEAR_STRING_TABLE);
+    StringTable* string_table = isolate->string_table();
+    InternalizedStringTableCleaner internalized_visitor(this);
+    string_table->DropOldData();
+    string_table->IterateElements(&internalized_visitor);
+    string_table->NotifyElementsRemoved(
+        internalized_visitor.pointers_removed());
+
+    ExternalStringTableCleaner external_visitor(this);
+    heap->external_string_table_.IterateAll(&external_visitor);
+    heap->external_string_table_.CleanUpAll();
+  }
+  {
+    TRACE_GC(heap->tracer(), GCTracer::Scope::MC_CLEAR_WEAK_LISTS);
+    WeakObjectRetainer retainer(this);
+    heap->ProcessAllWeakReferences(&retainer);
+  }
+  {
+    TRACE_GC(heap->tracer(), GCTracer::Scope::MC_CLEAR_WEAK_REFERENCES);
+    ClearWeakReferences();
+  }
+}
+
+void Collector::ClearWeakReferences() {
+  WeakReferenceWorklist::Local local(&weak_references_);
+  const HeapObjectReference cleared =
+      HeapObjectReference::ClearedValue(impl_->isolate());
+  std::pair<HeapObject, HeapObjectSlot> slot;
+  while (local.Pop(&slot)) {
+    // The slot may have been overwritten since it was recorded.
+    MaybeObjectSlot location(slot.second);
+    HeapObject value;
+    if ((*location)->GetHeapObjectIfWeak(&value) && !IsMarked(value)) {
+      location.store(cleared);
+    }
+  }
+}
+
+void Collector::Sweep(GCTracer::Scope::ScopeId scope,
+                      GCTracer::Scope::ScopeId background_scope) {
+  V8::GetCurrentPlatform()
+      ->PostJob(v8::TaskPriority::kUserBlocking,
+                std::make_unique<SweepingJob>(this, scope, background_scope))
+      ->Join();
+  live_bytes_ = swept_live_bytes_.load(std::memory_order_relaxed);
+}
+
+void Collector::SweepBlock(Block* block) {
+  impl_->ClearCards(block, block->kind == Block::Kind::kLargeObject
+                               ? block->run_length
+                               : 1);
+  switch (block->kind) {
+    case Block::Kind::kSizeClass:
+      SweepSizeClassBlock(block);
+      return;
+    case Block::Kind::kBump:
+    case Block::Kind::kCode:
+      SweepBumpBlock(block);
+      return;
+    case Block::Kind::kLargeObject: {
+      const Address start = impl_->BlockStart(block);
+      if (block->mark_bits[0] & 1u) {
+        swept_live_bytes_.fetch_add(HeapObject::FromAddress(start).Size(),
+                                    std::memory_order_relaxed);
+      } else {
+        impl_->ReleaseBlocks(block);
+      }
+      return;
+    }
+    case Block::Kind::kFree:
+    case Block::Kind::kReadOnly:
+    case Block::Kind::kLargeObjectContinuation:
+      UNREACHABLE();
+  }
+}
+
+void Collector::SweepSizeClassBlock(Block* block) {
+  const Address start = impl_->BlockStart(block);
+  const int cell_size = SizeClasses::CellSize(block->size_class);
+  const size_t num_cells = (block->cells_end - start) / cell_size;
+  // A cell is live if any object within it is marked. Only marked objects
+  // are touched, as dead objects may refer to maps that are being freed.
+  std::vector<bool> live_cells(num_cells, false);
+  size_t live_bytes = 0;
+  IterateMarkedObjects(block, start, [&](Address address) {
+    live_cells[(address - start) / cell_size] = true;
+    live_bytes += HeapObject::FromAddress(address).Size();
+  });
+  swept_live_bytes_.fetch_add(live_bytes, std::memory_order_relaxed);
+  if (live_bytes == 0) {
+    impl_->ReleaseBlocks(block);
+    return;
+  }
+  block->free_list = kNullAddress;
+  block->free_cells = 0;
+  // Push in reverse order so that allocation proceeds in address order.
+  for (size_t i = num_cells; i > 0; i--) {
+    if (live_cells[i - 1]) continue;
+    impl_->PushFreeCell(block, start + (i - 1) * cell_size);
+  }
+  impl_->MakeAvailable(block);
+}
+
+void Collector::SweepBumpBlock(Block* block) {
+  const Address start = impl_->BlockStart(block);
+  const Address end = impl_->BlockEnd(block);
+  const bool is_code = block->kind == Block::Kind::kCode;
+  if (is_code) block->object_starts->Clear();
+  // Gaps between marked objects become fillers. The memory is reclaimed only
+  // once the whole block is empty.
+  Address current = start;
+  size_t live_bytes = 0;
+  IterateMarkedObjects(block, start, [&](Address address) {
+    if (address > current) {
+      impl_->CreateFiller(current, static_cast<int>(address - current));
+    }
+    const int size = HeapObject::FromAddress(address).Size();
+    if (is_code) block->object_starts->SetBit(address);
+    live_bytes += size;
+    current = address + size;
+  });
+  swept_live_bytes_.fetch_add(live_bytes, std::memory_order_relaxed);
+  if (live_bytes == 0) {
+    impl_->ReleaseBlocks(block);
+    return;
+  }
+  if (current < end) {
+    impl_->CreateFiller(current, static_cast<int>(end - current));
+  }
+}
+
+}  // namespace third_party_heap
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,114 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_THIRD_PARTY_REFERENCE_COLLECTOR_H_
+#define V8_HEAP_THIRD_PARTY_REFERENCE_COLLECTOR_H_
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "src/heap/base/worklist.h"
+#include "src/heap/gc-tracer.h"
+#include "src/objects/heap-object.h"
+#include "src/objects/slots.h"
+
+namespace v8 {
+
+class JobDelegate;
+
+namespace internal {
+namespace third_party_heap {
+
+class Impl;
+struct Block;
+
+// Parallel stop-the-world mark-sweep collector of the reference heap.
+//
+// Roots are marked on the main thread. The transitive closure is then computed
+// by JobTask workers sharing a heap::base::Worklist: a worker publishes full
+// segments to the global pool and, once its local segments run dry, steals
+// segments published by others. Idle workers are fed by busy workers that
+// publish their partially filled segments whenever the global pool is empty.
+// Sweeping is parallelized over blocks.
+//
+// Full collections skip weak roots while marking. Afterwards, weak global
+// handles are processed like MarkCompactCollector does, and dead entries are
+// removed from the string tables and the heap's weak lists. Weak references
+// of objects are recorded during marking and cleared if their target died.
+// Transition arrays keep their targets alive, as they cannot hold cleared
+// references.
+//
+// Nursery collections only mark and sweep young blocks. Old objects on dirty
+// cards are scanned as additional roots, and all survivors are promoted in
+// place afterwards. They treat all weak references, including weak roots, as
+// strong: V8 reports all objects as old, so global handles have no young
+// weak handles to process after a nursery collection.
+class Collector final {
+ public:
+  using MarkingWorklist = ::heap::base::Worklist<HeapObject, 64>;
+  using WeakReferenceWorklist =
+      ::heap::base::Worklist<std::pair<HeapObject, HeapObjectSlot>, 64>;
+
+  explicit Collector(Impl* impl);
+
+  Collector(const Collector&) = delete;
+  Collector& operator=(const Collector&) = delete;
+
+  void CollectGarbage();
+  void CollectNurseryGarbage();
+
+  size_t live_bytes() const { return live_bytes_; }
+
+ private:
+  class MarkingJob;
+  class MarkingVisitor;
+  class RootMarkingVisitor;
+  class SweepingJob;
+
+  class ExternalStringTableCleaner;
+  class InternalizedStringTableCleaner;
+  class WeakObjectRetainer;
+
+  // Returns whether |object| was unmarked and is now marked.
+  bool TryMark(HeapObject object);
+  // Returns whether |object| survives the current collection. Objects that
+  // are not collected by it count as marked.
+  bool IsMarked(HeapObject object);
+  void MarkObject(HeapObject object, MarkingWorklist::Local* local);
+  // Matches WeakSlotCallbackWithHeap.
+  static bool IsUnmarkedHeapObject(v8::internal::Heap* heap, FullObjectSlot p);
+
+  void Prepare();
+  void MarkRoots();
+  void MarkDirtyCards();
+  void Mark(GCTracer::Scope::ScopeId scope,
+            GCTracer::Scope::ScopeId background_scope);
+  void ProcessMarkingWorklist(JobDelegate* delegate);
+  // Keeps the targets of weak global handles with finalizers alive and
+  // resets phantom handles to dead objects.
+  void ProcessWeakGlobalHandles();
+  void ClearNonLiveReferences();
+  void ClearWeakReferences();
+  void Sweep(GCTracer::Scope::ScopeId scope,
+             GCTracer::Scope::ScopeId background_scope);
+  void SweepBlock(Block* block);
+  void SweepSizeClassBlock(Block* block);
+  void SweepBumpBlock(Block* block);
+
+  Impl* const impl_;
+  bool nursery_ = false;
+  MarkingWorklist marking_worklist_;
+  WeakReferenceWorklist weak_references_;
+  std::vector<Block*> blocks_to_sweep_;
+  std::atomic<size_t> next_block_to_sweep_{0};
+  std::atomic<size_t> swept_live_bytes_{0};
+  size_t live_bytes_ = 0;
+};
+
+}  // namespace third_party_heap
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_THIRD_PARTY_REFERENCE_COLLECTOR_H_
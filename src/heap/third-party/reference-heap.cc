@@ -0,0 +1,747 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/third-party/reference-heap.h"
+
+#include <algorithm>
+
+#include "src/base/lazy-instance.h"
+#include "src/execution/isolate.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/third-party/reference-collector.h"
+#include "src/objects/heap-object-inl.h"
+
+namespace v8 {
+namespace internal {
+namespace third_party_heap {
+
+namespace {
+
+// Code range size used when neither the embedder nor the platform asks for a
+// specific one.
+constexpr size_t kDefaultCodeRangeSize = 64 * MB;
+
+// Live heaps, looked up without locking by the static parts of the API.
+constexpr int kMaxHeaps = 128;
+std::atomic<Impl*> g_heaps[kMaxHeaps];
+std::atomic<int> g_heaps_high_water_mark{0};
+base::LazyMutex g_heaps_mutex = LAZY_MUTEX_INITIALIZER;
+
+void RegisterHeap(Impl* impl) {
+  base::MutexGuard guard(g_heaps_mutex.Pointer());
+  for (int i = 0; i < kMaxHeaps; i++) {
+    if (g_heaps[i].load(std::memory_order_relaxed) != nullptr) continue;
+    g_heaps[i].store(impl, std::memory_order_release);
+    if (i >= g_heaps_high_water_mark.load(std::memory_order_relaxed)) {
+      g_heaps_high_water_mark.store(i + 1, std::memory_order_release);
+    }
+    return;
+  }
+  FATAL("Too many live third-party heaps");
+}
+
+void UnregisterHeap(Impl* impl) {
+  base::MutexGuard guard(g_heaps_mutex.Pointer());
+  for (int i = 0; i < kMaxHeaps; i++) {
+    if (g_heaps[i].load(std::memory_order_relaxed) != impl) continue;
+    g_heaps[i].store(nullptr, std::memory_order_release);
+    return;
+  }
+  UNREACHABLE();
+}
+
+class SizeClassTable final {
+ public:
+  SizeClassTable() {
+    for (int size = SizeClasses::kMinCellSize;
+         size <= SizeClasses::kMaxExactSize; size += kTaggedSize) {
+      Add(size);
+    }
+    int size = SizeClasses::kMaxExactSize;
+    while (size < SizeClasses::kMaxCellSize) {
+      size = std::min(RoundUp(size + size / 8, kTaggedSize),
+                      SizeClasses::kMaxCellSize);
+      Add(size);
+    }
+  }
+
+  int Index(int size_in_bytes) const {
+    DCHECK_LE(size_in_bytes, SizeClasses::kMaxCellSize);
+    if (size_in_bytes <= SizeClasses::kMaxExactSize) {
+      size_in_bytes = std::max(size_in_bytes, SizeClasses::kMinCellSize);
+      return RoundUp(size_in_bytes, kTaggedSize) / kTaggedSize -
+             SizeClasses::kMinCellSize / kTaggedSize;
+    }
+    return static_cast<int>(
+        std::lower_bound(sizes_, sizes_ + count_, size_in_bytes) - sizes_);
+  }
+
+  int CellSize(int index) const {
+    DCHECK_LT(index, count_);
+    return sizes_[index];
+  }
+
+  int count() const { return count_; }
+
+ private:
+  void Add(int size) {
+    CHECK_LT(count_, SizeClasses::kMaxCount);
+    sizes_[count_++] = size;
+  }
+
+  int sizes_[SizeClasses::kMaxCount];
+  int count_ = 0;
+};
+
+const SizeClassTable& GetSizeClassTable() {
+  static const SizeClassTable table;
+  return table;
+}
+
+// Free cells of kSizeClass blocks link to each other through their last word.
+// The first word holds the filler map, so cells need at least two words.
+Address& FreeCellLink(Address cell, int cell_size) {
+  STATIC_ASSERT(SizeClasses::kMinCellSize >= 2 * kSystemPointerSize);
+  return base::Memory<Address>(cell + cell_size - kSystemPointerSize);
+}
+
+}  // namespace
+
+// static
+int SizeClasses::Index(int size_in_bytes) {
+  return GetSizeClassTable().Index(size_in_bytes);
+}
+
+// static
+int SizeClasses::CellSize(int index) {
+  return GetSizeClassTable().CellSize(index);
+}
+
+// static
+int SizeClasses::Count() { return GetSizeClassTable().count(); }
+
+LocalAllocator::LocalAllocator(Impl* impl, bool is_main_thread)
+    : impl_(impl), is_main_thread_(is_main_thread) {}
+
+LocalAllocator::~LocalAllocator() = default;
+
+AllocationResult LocalAllocator::Allocate(int size_in_bytes,
+                                          AllocationType type,
+                                          AllocationAlignment alignment) {
+  DCHECK(IsAligned(size_in_bytes, kTaggedSize));
+  if (size_in_bytes > impl_->heap()->MaxRegularHeapObjectSize(type)) {
+    return impl_->AllocateLargeObject(size_in_bytes, type);
+  }
+  switch (type) {
+    case AllocationType::kYoung:
+      // Young objects are bump allocated from their own buffer. Unless the
+      // heap is generational, they are treated as old right away.
+      return AllocateFromLab(&young_lab_, Block::Kind::kBump,
+                             V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL
+                                 ? NEW_SPACE
+                                 : OLD_SPACE,
+                             size_in_bytes, alignment);
+    case AllocationType::kOld:
+    case AllocationType::kMap:
+    case AllocationType::kSharedOld:
+    case AllocationType::kSharedMap:
+      if (size_in_bytes +
+              v8::internal::Heap::GetMaximumFillToAlign(alignment) <=
+          SizeClasses::kMaxCellSize) {
+        return AllocateFromSizeClass(size_in_bytes, alignment);
+      }
+      return AllocateFromLab(&old_lab_, Block::Kind::kBump, OLD_SPACE,
+                             size_in_bytes, alignment);
+    case AllocationType::kCode:
+      return AllocateFromLab(&code_lab_, Block::Kind::kCode, CODE_SPACE,
+                             size_in_bytes, alignment);
+    case AllocationType::kReadOnly:
+      DCHECK(is_main_thread());
+      return AllocateFromLab(&read_only_lab_, Block::Kind::kReadOnly, RO_SPACE,
+                             size_in_bytes, alignment);
+  }
+  UNREACHABLE();
+}
+
+AllocationResult LocalAllocator::AllocateFromLab(
+    LinearAllocationArea* lab, Block::Kind kind, AllocationSpace space,
+    int size_in_bytes, AllocationAlignment alignment) {
+  int filler_size = v8::internal::Heap::GetFillToAlign(lab->top(), alignment);
+  if (!lab->CanIncrementTop(filler_size + size_in_bytes)) {
+    CloseLab(lab);
+    Block* block = impl_->AcquireBlock(kind, space);
+    if (block == nullptr) return AllocationResult::Retry(space);
+    lab->Reset(impl_->BlockStart(block), impl_->BlockEnd(block));
+    filler_size = v8::internal::Heap::GetFillToAlign(lab->top(), alignment);
+    DCHECK(lab->CanIncrementTop(filler_size + size_in_bytes));
+  }
+  Address address = lab->IncrementTop(filler_size + size_in_bytes);
+  if (filler_size > 0) {
+    impl_->CreateFiller(address, filler_size);
+    address += filler_size;
+  }
+  if (kind == Block::Kind::kCode) {
+    impl_->BlockFor(address)->object_starts->SetBit(address);
+  }
+  return HeapObject::FromAddress(address);
+}
+
+AllocationResult LocalAllocator::AllocateFromSizeClass(
+    int size_in_bytes, AllocationAlignment alignment) {
+  const int index = SizeClasses::Index(
+      size_in_bytes + v8::internal::Heap::GetMaximumFillToAlign(alignment));
+  const int cell_size = SizeClasses::CellSize(index);
+  Block* block = size_class_blocks_[index];
+  Address cell = block ? impl_->TakeCell(block) : kNullAddress;
+  if (cell == kNullAddress) {
+    if (block) impl_->ReleaseSizeClassBlock(block);
+    block = impl_->AcquireSizeClassBlock(index);
+    size_class_blocks_[index] = block;
+    if (block == nullptr) return AllocationResult::Retry(OLD_SPACE);
+    cell = impl_->TakeCell(block);
+    DCHECK_NE(kNullAddress, cell);
+  }
+  // Cells are kept fully iterable: any part of the cell not covered by the
+  // object is turned into a filler.
+  const int pre_filler_size =
+      v8::internal::Heap::GetFillToAlign(cell, alignment);
+  if (pre_filler_size > 0) impl_->CreateFiller(cell, pre_filler_size);
+  const Address address = cell + pre_filler_size;
+  const int post_filler_size = cell_size - pre_filler_size - size_in_bytes;
+  if (post_filler_size > 0) {
+    impl_->CreateFiller(address + size_in_bytes, post_filler_size);
+  }
+  return HeapObject::FromAddress(address);
+}
+
+void LocalAllocator::CloseLab(LinearAllocationArea* lab) {
+  if (lab->top() != lab->limit()) {
+    impl_->CreateFiller(lab->top(),
+                        static_cast<int>(lab->limit() - lab->top()));
+  }
+  lab->Reset(kNullAddress, kNullAddress);
+}
+
+void LocalAllocator::MakeIterable() {
+  for (LinearAllocationArea* lab :
+       {&young_lab_, &old_lab_, &code_lab_, &read_only_lab_}) {
+    if (lab->top() != lab->limit()) {
+      impl_->CreateFiller(lab->top(),
+                          static_cast<int>(lab->limit() - lab->top()));
+    }
+  }
+}
+
+void LocalAllocator::Release() {
+  for (LinearAllocationArea* lab :
+       {&young_lab_, &old_lab_, &code_lab_, &read_only_lab_}) {
+    CloseLab(lab);
+  }
+  for (Block*& block : size_class_blocks_) {
+    if (block == nullptr) continue;
+    impl_->ReleaseSizeClassBlock(block);
+    block = nullptr;
+  }
+}
+
+bool LocalAllocator::IsPendingAllocation(Address address) const {
+  for (const LinearAllocationArea* lab :
+       {&young_lab_, &old_lab_, &code_lab_, &read_only_lab_}) {
+    if (lab->start() <= address && address < lab->top()) return true;
+  }
+  return false;
+}
+
+Address LocalAllocator::LabTop(Address block_start) const {
+  // Buffers always span a whole block.
+  for (const LinearAllocationArea* lab :
+       {&young_lab_, &old_lab_, &code_lab_, &read_only_lab_}) {
+    if (lab->start() == block_start) return lab->top();
+  }
+  return kNullAddress;
+}
+
+Impl::Impl(v8::internal::Isolate* isolate)
+    : isolate_(isolate), heap_(isolate->heap()) {
+  size_t code_range_size = heap_->code_range_size_;
+  if (code_range_size == 0) code_range_size = kMaximalCodeRangeSize;
+  if (code_range_size == 0) code_range_size = kDefaultCodeRangeSize;
+  code_range_size = RoundUp(code_range_size, kBlockSize);
+  const size_t heap_size = RoundUp(heap_->MaxReserved(), kBlockSize);
+
+  VirtualMemory reservation(GetPlatformPageAllocator(),
+                            code_range_size + heap_size, GetRandomMmapAddr(),
+                            kBlockSize, VirtualMemory::kMapAsJittable);
+  if (!reservation.IsReserved()) {
+    heap_->FatalProcessOutOfMemory("third-party heap reservation");
+  }
+  reservation_ = std::move(reservation);
+
+  region_begin_ = RoundUp(reservation_.address(), kBlockSize);
+  region_end_ = RoundDown(reservation_.end(), kBlockSize);
+  num_blocks_ = (region_end_ - region_begin_) / kBlockSize;
+  num_code_blocks_ = code_range_size / kBlockSize;
+  CHECK_LT(num_code_blocks_, num_blocks_);
+  code_region_ = base::AddressRegion(region_begin_, code_range_size);
+  blocks_.reset(new Block[num_blocks_]);
+  initial_limit_blocks_ = std::max<size_t>(
+      1, RoundUp(heap_->initial_old_generation_size_, kBlockSize) / kBlockSize);
+  limit_blocks_ = initial_limit_blocks_;
+  if (V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL) {
+    nursery_limit_blocks_ = std::max<size_t>(
+        1, RoundUp(heap_->max_semi_space_size_, kBlockSize) / kBlockSize);
+    // Card table pages are committed on first write.
+    v8::PageAllocator* page_allocator = GetPlatformPageAllocator();
+    const size_t card_table_size = RoundUp(num_blocks_ * kCardsPerBlock,
+                                           page_allocator->AllocatePageSize());
+    VirtualMemory card_table(page_allocator, card_table_size,
+                             GetRandomMmapAddr());
+    if (!card_table.IsReserved() ||
+        !card_table.SetPermissions(card_table.address(), card_table.size(),
+                                   PageAllocator::kReadWrite)) {
+      heap_->FatalProcessOutOfMemory("third-party heap card table");
+    }
+    card_table_ = std::move(card_table);
+    // Biased so that the card of |slot| is card_table_base_ + (slot >> 9).
+    card_table_base_ =
+        card_table_.address() - (region_begin_ >> Heap::kCardSizeLog2);
+  }
+  collector_ = std::make_unique<Collector>(this);
+
+  main_allocator_ = std::make_unique<LocalAllocator>(this, true);
+  allocators_.push_back(main_allocator_.get());
+  RegisterHeap(this);
+}
+
+Impl::~Impl() { UnregisterHeap(this); }
+
+// static
+Impl* Impl::FromAddress(Address address) {
+  const int count = g_heaps_high_water_mark.load(std::memory_order_acquire);
+  for (int i = 0; i < count; i++) {
+    Impl* impl = g_heaps[i].load(std::memory_order_acquire);
+    if (impl != nullptr && impl->Contains(address)) return impl;
+  }
+  return nullptr;
+}
+
+LocalAllocator* Impl::NewLocalAllocator() {
+  LocalAllocator* allocator = new LocalAllocator(this, false);
+  base::MutexGuard guard(&mutex_);
+  allocators_.push_back(allocator);
+  return allocator;
+}
+
+void Impl::DisposeLocalAllocator(LocalAllocator* allocator) {
+  DCHECK(!allocator->is_main_thread());
+  allocator->Release();
+  {
+    base::MutexGuard guard(&mutex_);
+    auto it = std::find(allocators_.begin(), allocators_.end(), allocator);
+    DCHECK(it != allocators_.end());
+    allocators_.erase(it);
+  }
+  delete allocator;
+}
+
+Block* Impl::AllocateBlocks(size_t count, bool executable) {
+  mutex_.AssertHeld();
+  const size_t begin = executable ? 0 : num_code_blocks_;
+  const size_t end = executable ? num_code_blocks_ : num_blocks_;
+  size_t run = 0;
+  for (size_t i = begin; i < end; i++) {
+    if (!blocks_[i].IsFree()) {
+      run = 0;
+      continue;
+    }
+    if (++run < count) continue;
+    Block* first = &blocks_[i + 1 - count];
+    if (!reservation_.SetPermissions(BlockStart(first), count * kBlockSize,
+                                     executable
+                                         ? PageAllocator::kReadWriteExecute
+                                         : PageAllocator::kReadWrite)) {
+      return nullptr;
+    }
+    committed_blocks_.fetch_add(count, std::memory_order_relaxed);
+    return first;
+  }
+  return nullptr;
+}
+
+Block* Impl::AcquireBlock(Block::Kind kind, AllocationSpace space) {
+  base::MutexGuard guard(&mutex_);
+  const bool young = space == NEW_SPACE;
+  if (kind != Block::Kind::kReadOnly && !CanGrow(1)) return nullptr;
+  if (young && !CanGrowNursery(1)) return nullptr;
+  Block* block = AllocateBlocks(1, kind == Block::Kind::kCode);
+  if (block == nullptr) return nullptr;
+  block->kind = kind;
+  block->space = young ? OLD_SPACE : space;
+  block->young = young;
+  if (young) young_blocks_++;
+  if (kind == Block::Kind::kCode) {
+    block->object_starts =
+        std::make_unique<ObjectStartBitmap>(BlockStart(block));
+  }
+  return block;
+}
+
+Block* Impl::AcquireSizeClassBlock(int size_class) {
+  base::MutexGuard guard(&mutex_);
+  std::vector<Block*>& available = available_blocks_[size_class];
+  Block* block;
+  if (!available.empty()) {
+    block = available.back();
+    available.pop_back();
+  } else {
+    if (!CanGrow(1)) return nullptr;
+    block = AllocateBlocks(1, false);
+    if (block == nullptr) return nullptr;
+    block->kind = Block::Kind::kSizeClass;
+    block->space = OLD_SPACE;
+    block->size_class = static_cast<uint8_t>(size_class);
+    block->cells_end = BlockStart(block);
+    block->free_list = kNullAddress;
+    block->free_cells = 0;
+  }
+  DCHECK_EQ(Block::Kind::kSizeClass, block->kind);
+  DCHECK(!block->owned);
+  block->owned = true;
+  return block;
+}
+
+void Impl::ReleaseSizeClassBlock(Block* block) {
+  base::MutexGuard guard(&mutex_);
+  DCHECK(block->owned);
+  block->owned = false;
+  if (HasFreeCells(block)) {
+    available_blocks_[block->size_class].push_back(block);
+  }
+}
+
+bool Impl::CanGrow(size_t count) {
+  mutex_.AssertHeld();
+  return heap_->always_allocate() ||
+         committed_blocks_.load(std::memory_order_relaxed) + count <=
+             limit_blocks_;
+}
+
+bool Impl::CanGrowNursery(size_t count) {
+  mutex_.AssertHeld();
+  // An empty nursery accepts any large object.
+  return heap_->always_allocate() || young_blocks_ == 0 ||
+         young_blocks_ + count <= nursery_limit_blocks_;
+}
+
+void Impl::PromoteNursery(const std::vector<Block*>& blocks) {
+  base::MutexGuard guard(&mutex_);
+  for (Block* block : blocks) block->young = false;
+  young_blocks_ = 0;
+}
+
+bool Impl::HasDirtyCard(Address start, Address end) const {
+  for (Address card = start >> Heap::kCardSizeLog2;
+       card <= (end - 1) >> Heap::kCardSizeLog2; card++) {
+    if (base::Memory<uint8_t>(card_table_base_ + card) == Heap::kDirtyCard) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Impl::ClearCards(const Block* block, size_t count) {
+  if (!V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL) return;
+  memset(CardsOf(block), 0, count * kCardsPerBlock);
+}
+
+void Impl::ReleaseBlocks(Block* first) {
+  base::MutexGuard guard(&mutex_);
+  DCHECK(!first->owned);
+  const size_t first_index = first - blocks_.get();
+  const size_t count =
+      first->kind == Block::Kind::kLargeObject ? first->run_length : 1;
+  CHECK(reservation_.SetPermissions(BlockStart(first), count * kBlockSize,
+                                    PageAllocator::kNoAccess));
+  if (first->young) young_blocks_ -= count;
+  for (size_t i = 0; i < count; i++) {
+    Block& block = blocks_[first_index + i];
+    block.kind = Block::Kind::kFree;
+    block.young = false;
+    block.space = OLD_SPACE;
+    block.run_length = 0;
+    block.run_start = 0;
+    block.cells_end = kNullAddress;
+    block.free_list = kNullAddress;
+    block.free_cells = 0;
+    block.object_starts.reset();
+  }
+  committed_blocks_.fetch_sub(count, std::memory_order_relaxed);
+}
+
+void Impl::PushFreeCell(Block* block, Address cell) {
+  const int cell_size = SizeClasses::CellSize(block->size_class);
+  CreateFiller(cell, cell_size);
+  FreeCellLink(cell, cell_size) = block->free_list;
+  block->free_list = cell;
+  block->free_cells++;
+}
+
+void Impl::MakeAvailable(Block* block) {
+  base::MutexGuard guard(&mutex_);
+  DCHECK_EQ(Block::Kind::kSizeClass, block->kind);
+  DCHECK(!block->owned);
+  if (HasFreeCells(block)) {
+    available_blocks_[block->size_class].push_back(block);
+  }
+}
+
+void Impl::ClearAvailableBlocks() {
+  base::MutexGuard guard(&mutex_);
+  for (std::vector<Block*>& available : available_blocks_) available.clear();
+}
+
+void Impl::ReleaseLocalAllocators() {
+  // Release() re-enters the mutex through ReleaseSizeClassBlock, so copy the
+  // set of allocators first.
+  std::vector<LocalAllocator*> allocators;
+  {
+    base::MutexGuard guard(&mutex_);
+    allocators = allocators_;
+  }
+  for (LocalAllocator* allocator : allocators) allocator->Release();
+}
+
+void Impl::UpdateAllocationLimit(size_t live_bytes) {
+  base::MutexGuard guard(&mutex_);
+  const size_t live_blocks = RoundUp(live_bytes, kBlockSize) / kBlockSize;
+  // Fragmented blocks stay committed, so always leave some headroom above the
+  // committed memory to avoid back-to-back collections.
+  const size_t committed = committed_blocks_.load(std::memory_order_relaxed);
+  limit_blocks_ = std::min(
+      num_blocks_, std::max({initial_limit_blocks_, 2 * live_blocks,
+                             committed + initial_limit_blocks_ / 2}));
+}
+
+void Impl::CollectGarbage() { collector_->CollectGarbage(); }
+
+void Impl::CollectNurseryGarbage() {
+  bool promotion_fits;
+  {
+    base::MutexGuard guard(&mutex_);
+    const size_t old_blocks =
+        committed_blocks_.load(std::memory_order_relaxed) - young_blocks_;
+    promotion_fits = old_blocks + nursery_limit_blocks_ <= limit_blocks_;
+  }
+  // Survivors are promoted in place, so the old generation must be able to
+  // absorb a full nursery.
+  if (promotion_fits) {
+    collector_->CollectNurseryGarbage();
+  } else {
+    collector_->CollectGarbage();
+  }
+}
+
+bool Impl::InYoungGeneration(Address address) {
+  Block* block = OwnerBlock(address);
+  return block != nullptr && block->young;
+}
+
+void Impl::RecordWrite(HeapObject host, Address slot, HeapObject value) {
+  if (!InYoungGeneration(value.address())) return;
+  if (InYoungGeneration(host.address())) return;
+  base::Memory<uint8_t>(card_table_base_ + (slot >> Heap::kCardSizeLog2)) =
+      Heap::kDirtyCard;
+}
+
+void Impl::RecordWriteRange(HeapObject host, Address start, Address end) {
+  if (start == end || InYoungGeneration(host.address())) return;
+  const Address first = card_table_base_ + (start >> Heap::kCardSizeLog2);
+  const Address last = card_table_base_ + ((end - 1) >> Heap::kCardSizeLog2);
+  memset(reinterpret_cast<void*>(first), Heap::kDirtyCard, last - first + 1);
+}
+
+bool Impl::HasFreeCells(const Block* block) const {
+  const int cell_size = SizeClasses::CellSize(block->size_class);
+  return block->free_list != kNullAddress ||
+         block->cells_end + cell_size <= BlockEnd(block);
+}
+
+Address Impl::TakeCell(Block* block) {
+  DCHECK_EQ(Block::Kind::kSizeClass, block->kind);
+  const int cell_size = SizeClasses::CellSize(block->size_class);
+  if (block->free_list != kNullAddress) {
+    const Address cell = block->free_list;
+    block->free_list = FreeCellLink(cell, cell_size);
+    block->free_cells--;
+    return cell;
+  }
+  if (block->cells_end + cell_size > BlockEnd(block)) return kNullAddress;
+  const Address cell = block->cells_end;
+  block->cells_end += cell_size;
+  return cell;
+}
+
+AllocationResult Impl::AllocateLargeObject(int size_in_bytes,
+                                           AllocationType type) {
+  DCHECK_NE(AllocationType::kReadOnly, type);
+  const bool executable = type == AllocationType::kCode;
+  const AllocationSpace space = executable ? CODE_LO_SPACE : LO_SPACE;
+  const bool young = V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL_BOOL &&
+                     type == AllocationType::kYoung;
+  const AllocationSpace retry_space = young ? NEW_LO_SPACE : space;
+  const size_t count = RoundUp(size_in_bytes, kBlockSize) / kBlockSize;
+  base::MutexGuard guard(&mutex_);
+  if (!CanGrow(count)) return AllocationResult::Retry(retry_space);
+  if (young && !CanGrowNursery(count)) {
+    return AllocationResult::Retry(retry_space);
+  }
+  Block* first = AllocateBlocks(count, executable);
+  if (first == nullptr) return AllocationResult::Retry(retry_space);
+  const size_t first_index = first - blocks_.get();
+  first->kind = Block::Kind::kLargeObject;
+  first->space = space;
+  first->young = young;
+  if (young) young_blocks_ += count;
+  first->run_length = static_cast<uint32_t>(count);
+  for (size_t i = 1; i < count; i++) {
+    Block& block = blocks_[first_index + i];
+    block.kind = Block::Kind::kLargeObjectContinuation;
+    block.space = space;
+    block.run_start = first_index;
+  }
+  return HeapObject::FromAddress(BlockStart(first));
+}
+
+Address Impl::FindObjectInRange(Address start, Address inner_pointer) {
+  Address current = start;
+  while (true) {
+    const Address next = current + HeapObject::FromAddress(current).Size();
+    if (inner_pointer < next) return current;
+    current = next;
+  }
+}
+
+Address Impl::GetObjectFromInnerPointer(Address inner_pointer) {
+  if (!Contains(inner_pointer)) return kNullAddress;
+  Block* block = BlockFor(inner_pointer);
+  const Address start = BlockStart(block);
+  switch (block->kind) {
+    case Block::Kind::kFree:
+      return kNullAddress;
+    case Block::Kind::kLargeObjectContinuation:
+      return BlockStart(&blocks_[block->run_start]);
+    case Block::Kind::kLargeObject:
+      return start;
+    case Block::Kind::kCode:
+      return block->object_starts->FindBasePtr(inner_pointer);
+    case Block::Kind::kSizeClass: {
+      const int cell_size = SizeClasses::CellSize(block->size_class);
+      if (inner_pointer >= block->cells_end) return kNullAddress;
+      const Address cell =
+          start + (inner_pointer - start) / cell_size * cell_size;
+      return FindObjectInRange(cell, inner_pointer);
+    }
+    case Block::Kind::kBump:
+    case Block::Kind::kReadOnly: {
+      // Memory above the top of an open buffer is not formatted yet.
+      const Address top = LabTop(block);
+      if (top != kNullAddress && inner_pointer >= top) return kNullAddress;
+      return FindObjectInRange(start, inner_pointer);
+    }
+  }
+  UNREACHABLE();
+}
+
+Address Impl::LabTop(const Block* block) {
+  const Address start = BlockStart(block);
+  base::MutexGuard guard(&mutex_);
+  for (LocalAllocator* allocator : allocators_) {
+    const Address top = allocator->LabTop(start);
+    if (top != kNullAddress) return top;
+  }
+  return kNullAddress;
+}
+
+bool Impl::IsPendingAllocation(Address address) {
+  base::MutexGuard guard(&mutex_);
+  for (LocalAllocator* allocator : allocators_) {
+    if (allocator->IsPendingAllocation(address)) return true;
+  }
+  return false;
+}
+
+Block* Impl::OwnerBlock(Address address) {
+  if (!Contains(address)) return nullptr;
+  Block* block = BlockFor(address);
+  if (block->kind == Block::Kind::kLargeObjectContinuation) {
+    block = &blocks_[block->run_start];
+  }
+  return block->IsFree() ? nullptr : block;
+}
+
+bool Impl::InSpace(Address address, AllocationSpace space) {
+  Block* block = OwnerBlock(address);
+  if (block == nullptr) return false;
+  // Maps share size-class blocks with other objects of the same size.
+  if (space == MAP_SPACE) {
+    return block->space == OLD_SPACE &&
+           HeapObject::FromAddress(address).IsMap();
+  }
+  return block->space == space;
+}
+
+void Impl::ResetIterator() {
+  {
+    base::MutexGuard guard(&mutex_);
+    for (LocalAllocator* allocator : allocators_) allocator->MakeIterable();
+  }
+  iterator_block_ = 0;
+  iterator_current_ = kNullAddress;
+  iterator_limit_ = kNullAddress;
+}
+
+HeapObject Impl::NextObject() {
+  while (true) {
+    while (iterator_current_ < iterator_limit_) {
+      HeapObject object = HeapObject::FromAddress(iterator_current_);
+      iterator_current_ += object.Size();
+      if (!object.IsFreeSpaceOrFiller()) return object;
+    }
+    if (iterator_block_ >= num_blocks_) return HeapObject();
+    Block* block = &blocks_[iterator_block_];
+    const Address start = BlockStart(block);
+    switch (block->kind) {
+      case Block::Kind::kFree:
+      case Block::Kind::kLargeObjectContinuation:
+        iterator_block_++;
+        continue;
+      case Block::Kind::kLargeObject:
+        iterator_current_ = start;
+        iterator_limit_ = start + HeapObject::FromAddress(start).Size();
+        iterator_block_ += block->run_length;
+        continue;
+      case Block::Kind::kSizeClass:
+        iterator_current_ = start;
+        iterator_limit_ = block->cells_end;
+        iterator_block_++;
+        continue;
+      case Block::Kind::kBump:
+      case Block::Kind::kCode:
+      case Block::Kind::kReadOnly:
+        iterator_current_ = start;
+        iterator_limit_ = BlockEnd(block);
+        iterator_block_++;
+        continue;
+    }
+  }
+}
+
+void Impl::CreateFiller(Address address, int size) {
+  heap_->CreateFillerObjectAtBackground(
+      address, size, ClearFreedMemoryMode::kDontClearFreedMemory);
+}
+
+}  // namespace third_party_heap
+}  // namespace internal
+}  // namespace v8
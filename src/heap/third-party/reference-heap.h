@@ -0,0 +1,315 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_THIRD_PARTY_REFERENCE_HEAP_H_
+#define V8_HEAP_THIRD_PARTY_REFERENCE_HEAP_H_
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "src/base/memory.h"
+#include "src/base/platform/mutex.h"
+#include "src/heap/linear-allocation-area.h"
+#include "src/heap/object-start-bitmap.h"
+#include "src/heap/third-party/heap-api.h"
+#include "src/utils/allocation.h"
+
+namespace v8 {
+namespace internal {
+
+class LocalHeap;
+
+namespace third_party_heap {
+
+class Collector;
+
+// Size classes of the segregated-fit old space. Sizes up to kMaxExactSize are
+// served in kTaggedSize steps, so that small objects always find an exact fit.
+// Larger sizes use geometrically growing classes that waste at most 1/8th of a
+// cell. Objects larger than kMaxCellSize are bump-allocated instead.
+class SizeClasses final {
+ public:
+  static constexpr int kMinCellSize = 2 * kTaggedSize;
+  static constexpr int kMaxExactSize = 32 * kTaggedSize;
+  static constexpr int kMaxCellSize = 32 * KB;
+  static constexpr int kMaxCount = 96;
+
+  // Returns the index of the smallest size class that fits |size_in_bytes|.
+  static int Index(int size_in_bytes);
+  static int CellSize(int index);
+  static int Count();
+};
+
+// Memory of the reference heap is handed out in blocks of the same size as
+// V8's regular pages. Block metadata lives off-heap in a table indexed by the
+// block number, so that blocks do not carry any header.
+struct Block final {
+  enum class Kind : uint8_t {
+    kFree,
+    // Bump-pointer allocated from thread-local allocation buffers.
+    kBump,
+    // Cells of a single size class, see SizeClasses.
+    kSizeClass,
+    // Bump-pointer allocated executable memory within the code range.
+    kCode,
+    kReadOnly,
+    // First block of a run holding a single large object.
+    kLargeObject,
+    // Remaining blocks of a large object run.
+    kLargeObjectContinuation,
+  };
+
+  bool IsFree() const { return kind == Kind::kFree; }
+
+  Kind kind = Kind::kFree;
+  AllocationSpace space = OLD_SPACE;
+  // Size class index of kSizeClass blocks.
+  uint8_t size_class = 0;
+  // Whether a kSizeClass block is currently owned by a LocalAllocator.
+  bool owned = false;
+  // Whether the block belongs to the nursery. Only kBump and kLargeObject
+  // blocks are young; they are promoted in place by the next collection.
+  bool young = false;
+  // Number of blocks in a large object run; stored on the first block.
+  uint32_t run_length = 0;
+  // Index of the first block of the run for kLargeObjectContinuation blocks.
+  size_t run_start = 0;
+  // kSizeClass blocks: cells below |cells_end| have been handed out at least
+  // once and are iterable. Cells in |free_list| are formatted as fillers and
+  // link to each other through their last word.
+  Address cells_end = kNullAddress;
+  Address free_list = kNullAddress;
+  uint32_t free_cells = 0;
+  // Object starts of kCode blocks, needed for inner pointer lookups from
+  // stack frames.
+  std::unique_ptr<ObjectStartBitmap> object_starts;
+  // One mark bit per tagged word, allocated by the collector on demand.
+  std::unique_ptr<uint32_t[]> mark_bits;
+};
+
+// Thread-local allocation state attached to a LocalHeap. Young objects and old
+// objects larger than SizeClasses::kMaxCellSize are bump allocated from
+// thread-local allocation buffers spanning whole blocks. Small old objects are
+// allocated from per-size-class blocks owned by the allocator, so that the
+// fast path never needs to synchronize with other threads.
+class LocalAllocator final {
+ public:
+  LocalAllocator(Impl* impl, bool is_main_thread);
+  ~LocalAllocator();
+
+  LocalAllocator(const LocalAllocator&) = delete;
+  LocalAllocator& operator=(const LocalAllocator&) = delete;
+
+  AllocationResult Allocate(int size_in_bytes, AllocationType type,
+                            AllocationAlignment alignment);
+
+  // Closes the current buffers with fillers so that the heap can be iterated.
+  // The buffers remain usable.
+  void MakeIterable();
+  // Returns all memory owned by the allocator to the heap.
+  void Release();
+
+  bool IsPendingAllocation(Address address) const;
+  // Returns the top of the buffer allocating in the block starting at
+  // |block_start|, or kNullAddress if the block has no open buffer.
+  Address LabTop(Address block_start) const;
+
+  bool is_main_thread() const { return is_main_thread_; }
+
+ private:
+  AllocationResult AllocateFromLab(LinearAllocationArea* lab, Block::Kind kind,
+                                   AllocationSpace space, int size_in_bytes,
+                                   AllocationAlignment alignment);
+  AllocationResult AllocateFromSizeClass(int size_in_bytes,
+                                         AllocationAlignment alignment);
+  void CloseLab(LinearAllocationArea* lab);
+
+  Impl* const impl_;
+  const bool is_main_thread_;
+
+  LinearAllocationArea young_lab_;
+  LinearAllocationArea old_lab_;
+  LinearAllocationArea code_lab_;
+  LinearAllocationArea read_only_lab_;
+  std::array<Block*, SizeClasses::kMaxCount> size_class_blocks_{};
+};
+
+// In-tree reference implementation of the third-party heap interface. The heap
+// is a single reservation carved into blocks. The first part of the
+// reservation is the code range. The heap is non-moving and collected by a
+// parallel mark-sweep Collector once the committed memory reaches a limit.
+//
+// In generational mode, young allocations go to nursery blocks. Stores into
+// older objects are recorded in a card table, which serves as the roots of
+// nursery collections together with the regular roots.
+class Impl final {
+ public:
+  static constexpr size_t kBlockSize = size_t{1} << kPageSizeBits;
+  static constexpr size_t kCardsPerBlock =
+      kBlockSize >> Heap::kCardSizeLog2;
+
+  explicit Impl(v8::internal::Isolate* isolate);
+  ~Impl();
+
+  Impl(const Impl&) = delete;
+  Impl& operator=(const Impl&) = delete;
+
+  // Returns the heap owning |address|, or nullptr.
+  static Impl* FromAddress(Address address);
+
+  v8::internal::Isolate* isolate() const { return isolate_; }
+  v8::internal::Heap* heap() const { return heap_; }
+
+  LocalAllocator* main_thread_allocator() { return main_allocator_.get(); }
+  LocalAllocator* NewLocalAllocator();
+  void DisposeLocalAllocator(LocalAllocator* allocator);
+
+  AllocationResult AllocateLargeObject(int size_in_bytes, AllocationType type);
+
+  // Acquires a fresh block of |kind| for the calling LocalAllocator. Blocks
+  // acquired for NEW_SPACE form the nursery. V8 runs with a single generation,
+  // so their objects are reported as old.
+  Block* AcquireBlock(Block::Kind kind, AllocationSpace space);
+  // Acquires a block of |size_class| with free cells, or a fresh one.
+  Block* AcquireSizeClassBlock(int size_class);
+  void ReleaseSizeClassBlock(Block* block);
+  // Takes a cell from a kSizeClass block owned by the caller. Returns
+  // kNullAddress if the block is full.
+  Address TakeCell(Block* block);
+
+  bool Contains(Address address) const {
+    return region_begin_ <= address && address < region_end_;
+  }
+  Block* BlockFor(Address address) {
+    DCHECK(Contains(address));
+    return &blocks_[BlockIndex(address)];
+  }
+  Address BlockStart(const Block* block) const {
+    return region_begin_ + (block - blocks_.get()) * kBlockSize;
+  }
+  Address BlockEnd(const Block* block) const {
+    return BlockStart(block) + kBlockSize;
+  }
+
+  // Returns the block owning the object at |address|, i.e. the first block of
+  // a large object run, or nullptr if |address| is not in use.
+  Block* OwnerBlock(Address address);
+
+  Address GetObjectFromInnerPointer(Address inner_pointer);
+  const base::AddressRegion& code_region() const { return code_region_; }
+  bool IsPendingAllocation(Address address);
+  bool InSpace(Address address, AllocationSpace space);
+
+  void ResetIterator();
+  HeapObject NextObject();
+
+  size_t Capacity() const { return region_end_ - region_begin_; }
+  size_t CommittedMemory() const {
+    return committed_blocks_.load(std::memory_order_relaxed) * kBlockSize;
+  }
+
+  void CreateFiller(Address address, int size);
+
+  // Performs a full stop-the-world garbage collection.
+  void CollectGarbage();
+  // Collects the nursery, or the full heap if the survivors might not fit.
+  void CollectNurseryGarbage();
+
+  bool InYoungGeneration(Address address);
+
+  // Card table of the generational mode, see Heap::card_table_base().
+  Address card_table_base() const { return card_table_base_; }
+  bool IsCardDirty(Address slot) const {
+    return base::Memory<uint8_t>(card_table_base_ +
+                                 (slot >> Heap::kCardSizeLog2)) ==
+           Heap::kDirtyCard;
+  }
+  // Returns whether any card overlapping [start, end) is dirty.
+  bool HasDirtyCard(Address start, Address end) const;
+  void RecordWrite(HeapObject host, Address slot, HeapObject value);
+  void RecordWriteRange(HeapObject host, Address start, Address end);
+
+ private:
+  size_t BlockIndex(Address address) const {
+    return (address - region_begin_) >> kPageSizeBits;
+  }
+
+  // Finds and commits |count| consecutive free blocks. Must be called with
+  // |mutex_| held.
+  Block* AllocateBlocks(size_t count, bool executable);
+  // Returns whether |count| more blocks may be committed before the next
+  // garbage collection. Must be called with |mutex_| held.
+  bool CanGrow(size_t count);
+  // Same for blocks of the nursery.
+  bool CanGrowNursery(size_t count);
+  // Clears the young flag of all surviving nursery blocks.
+  void PromoteNursery(const std::vector<Block*>& blocks);
+  uint8_t* CardsOf(const Block* block) {
+    return reinterpret_cast<uint8_t*>(card_table_.address()) +
+           (block - blocks_.get()) * kCardsPerBlock;
+  }
+  void ClearCards(const Block* block, size_t count);
+  // Decommits the block or large object run starting at |first|.
+  void ReleaseBlocks(Block* first);
+  // Formats |cell| as a filler and pushes it onto the free list of |block|.
+  void PushFreeCell(Block* block, Address cell);
+  // Makes a swept kSizeClass block available to allocators.
+  void MakeAvailable(Block* block);
+  void ClearAvailableBlocks();
+  void ReleaseLocalAllocators();
+  // Sets the number of committed blocks that triggers the next garbage
+  // collection.
+  void UpdateAllocationLimit(size_t live_bytes);
+  bool HasFreeCells(const Block* block) const;
+  // Walks objects from |start|, which must be an object start, up to the
+  // object containing |inner_pointer|.
+  Address FindObjectInRange(Address start, Address inner_pointer);
+  // Returns the top of the allocation buffer open in |block|, or kNullAddress.
+  Address LabTop(const Block* block);
+
+  v8::internal::Isolate* const isolate_;
+  v8::internal::Heap* const heap_;
+
+  VirtualMemory reservation_;
+  Address region_begin_ = kNullAddress;
+  Address region_end_ = kNullAddress;
+  base::AddressRegion code_region_;
+  size_t num_blocks_ = 0;
+  size_t num_code_blocks_ = 0;
+  std::unique_ptr<Block[]> blocks_;
+  std::atomic<size_t> committed_blocks_{0};
+  size_t initial_limit_blocks_ = 0;
+  size_t limit_blocks_ = 0;
+  size_t young_blocks_ = 0;
+  size_t nursery_limit_blocks_ = 0;
+
+  // One byte per card; only reserved in generational mode.
+  VirtualMemory card_table_;
+  Address card_table_base_ = kNullAddress;
+
+  std::unique_ptr<Collector> collector_;
+
+  // Guards block allocation, the allocation limit, the available size-class
+  // block lists and the set of live allocators.
+  base::Mutex mutex_;
+  std::array<std::vector<Block*>, SizeClasses::kMaxCount> available_blocks_;
+  std::vector<LocalAllocator*> allocators_;
+  std::unique_ptr<LocalAllocator> main_allocator_;
+
+  // State of the heap object iterator.
+  size_t iterator_block_ = 0;
+  Address iterator_current_ = kNullAddress;
+  Address iterator_limit_ = kNullAddress;
+
+  friend class Collector;
+  friend class LocalAllocator;
+};
+
+}  // namespace third_party_heap
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_THIRD_PARTY_REFERENCE_HEAP_H_
@@ -545,6 +545,7 @@
   F(MC_MARK_WEAK_CLOSURE_WEAK_HANDLES)               \
   F(MC_MARK_WEAK_CLOSURE_WEAK_ROOTS)                 \
   F(MC_MARK_WEAK_CLOSURE_HARMONY)                    \
+  F(MC_SAMPLE_OBJECT_STATS)                          \
   F(MC_SWEEP_CODE)                                   \
   F(MC_SWEEP_MAP)                                    \
   F(MC_SWEEP_OLD)                                    \
@@ -606,14 +607,16 @@
   F(MINOR_MC_BACKGROUND_EVACUATE_COPY)            \
   F(MINOR_MC_BACKGROUND_EVACUATE_UPDATE_POINTERS) \
   F(MINOR_MC_BACKGROUND_MARKING)                  \
+  F(SCAVENGER_BACKGROUND_FREE_REMEMBERED_SET)     \
   F(SCAVENGER_BACKGROUND_SCAVENGE_PARALLEL)
 
-#define TRACER_YOUNG_EPOCH_SCOPES(F)        \
-  F(BACKGROUND_YOUNG_ARRAY_BUFFER_SWEEP)    \
-  F(MINOR_MARK_COMPACTOR)                   \
-  F(MINOR_MC_COMPLETE_SWEEP_ARRAY_BUFFERS)  \
-  F(SCAVENGER)                              \
-  F(SCAVENGER_BACKGROUND_SCAVENGE_PARALLEL) \
+#define TRACER_YOUNG_EPOCH_SCOPES(F)          \
+  F(BACKGROUND_YOUNG_ARRAY_BUFFER_SWEEP)      \
+  F(MINOR_MARK_COMPACTOR)                     \
+  F(MINOR_MC_COMPLETE_SWEEP_ARRAY_BUFFERS)    \
+  F(SCAVENGER)                                \
+  F(SCAVENGER_BACKGROUND_FREE_REMEMBERED_SET) \
+  F(SCAVENGER_BACKGROUND_SCAVENGE_PARALLEL)   \
   F(SCAVENGER_COMPLETE_SWEEP_ARRAY_BUFFERS)
 
 #endif  // V8_INIT_HEAP_SYMBOLS_H_
@@ -119,6 +119,7 @@ void IsolateAllocator::InitializeOncePerProcess() {
         "Failed to reserve virtual memory for process-wide V8 "
         "pointer compression cage");
   }
+  AdviseHugePages(GetProcessWidePtrComprCage()->reservation()->region());
 #endif
 }
 
@@ -130,6 +131,7 @@ IsolateAllocator::IsolateAllocator() {
         nullptr,
         "Failed to reserve memory for Isolate V8 pointer compression cage");
   }
+  AdviseHugePages(isolate_ptr_compr_cage_.reservation()->region());
   page_allocator_ = isolate_ptr_compr_cage_.page_allocator();
   CommitPagesForIsolate();
 #elif defined(V8_COMPRESS_POINTERS_IN_SHARED_CAGE)
@@ -178,6 +178,8 @@ namespace internal {
      V8.TurboFanOptimizeNonConcurrentTotalTime, 10000000, MICROSECOND)         \
   HT(turbofan_optimize_concurrent_total_time,                                  \
      V8.TurboFanOptimizeConcurrentTotalTime, 10000000, MICROSECOND)            \
+  HT(turbofan_optimize_queue_latency, V8.TurboFanOptimizeQueueLatency,         \
+     10000000, MICROSECOND)                                                    \
   HT(turbofan_osr_prepare, V8.TurboFanOptimizeForOnStackReplacementPrepare,    \
      1000000, MICROSECOND)                                                     \
   HT(turbofan_osr_execute, V8.TurboFanOptimizeForOnStackReplacementExecute,    \
@@ -323,6 +325,7 @@ namespace internal {
   SC(stack_interrupts, V8.StackInterrupts)                                     \
   SC(runtime_profiler_ticks, V8.RuntimeProfilerTicks)                          \
   SC(soft_deopts_executed, V8.SoftDeoptsExecuted)                              \
+  SC(sampled_pretenured_sites, V8.SampledPretenuredSites)                      \
   SC(new_space_bytes_available, V8.MemoryNewSpaceBytesAvailable)               \
   SC(new_space_bytes_committed, V8.MemoryNewSpaceBytesCommitted)               \
   SC(new_space_bytes_used, V8.MemoryNewSpaceBytesUsed)                         \
@@ -341,12 +344,23 @@ namespace internal {
   /* Total code size (including metadata) of baseline code or bytecode. */     \
   SC(total_baseline_code_size, V8.TotalBaselineCodeSize)                       \
   /* Total count of functions compiled using the baseline compiler. */         \
-  SC(total_baseline_compile_count, V8.TotalBaselineCompileCount)
+  SC(total_baseline_compile_count, V8.TotalBaselineCompileCount)               \
+  /* Optimizing compile jobs dropped or evicted from a full queue. */          \
+  SC(concurrent_recompilation_dropped_jobs,                                    \
+     V8.ConcurrentRecompilationDroppedJobs)                                    \
+  /* Queued optimizing compile jobs cancelled due to feedback changes. */      \
+  SC(concurrent_recompilation_stale_jobs, V8.ConcurrentRecompilationStaleJobs) \
+  /* Allocation call site events dropped from a full queue. */                 \
+  SC(allocation_callsite_sampler_dropped_events,                               \
+     V8.AllocationCallsiteSamplerDroppedEvents)
 
-#define STATS_COUNTER_TS_LIST(SC)                         \
-  SC(wasm_generated_code_size, V8.WasmGeneratedCodeBytes) \
-  SC(wasm_reloc_size, V8.WasmRelocBytes)                  \
-  SC(wasm_lazily_compiled_functions, V8.WasmLazilyCompiledFunctions)
+#define STATS_COUNTER_TS_LIST(SC)                                    \
+  SC(wasm_generated_code_size, V8.WasmGeneratedCodeBytes)            \
+  SC(wasm_reloc_size, V8.WasmRelocBytes)                             \
+  SC(wasm_lazily_compiled_functions, V8.WasmLazilyCompiledFunctions) \
+  /* Allocations moved to old space by sampled pretenuring. */      \
+  SC(sampled_pretenuring_redirected_allocations,                     \
+     V8.SampledPretenuringRedirectedAllocations)
 
 // List of counters that can be incremented from generated code. We need them in
 // a separate list to be able to relocate them.
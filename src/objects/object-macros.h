@@ -432,7 +432,10 @@
 #define RELAXED_WRITE_WEAK_FIELD(p, offset, value) \
   TaggedField<MaybeObject>::Relaxed_Store(p, offset, value)
 
-#ifdef V8_DISABLE_WRITE_BARRIERS
+// The generational third-party heap relies on the generational barrier for
+// its card table even though V8's own write barriers are disabled.
+#if defined(V8_DISABLE_WRITE_BARRIERS) && \
+    !defined(V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL)
 #define WRITE_BARRIER(object, offset, value)
 #else
 #define WRITE_BARRIER(object, offset, value)                         \
@@ -443,7 +446,8 @@
   } while (false)
 #endif
 
-#ifdef V8_DISABLE_WRITE_BARRIERS
+#if defined(V8_DISABLE_WRITE_BARRIERS) && \
+    !defined(V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL)
 #define WEAK_WRITE_BARRIER(object, offset, value)
 #else
 #define WEAK_WRITE_BARRIER(object, offset, value)                             \
@@ -454,7 +458,8 @@
   } while (false)
 #endif
 
-#ifdef V8_DISABLE_WRITE_BARRIERS
+#if defined(V8_DISABLE_WRITE_BARRIERS) && \
+    !defined(V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL)
 #define EPHEMERON_KEY_WRITE_BARRIER(object, offset, value)
 #elif V8_ENABLE_UNCONDITIONAL_WRITE_BARRIERS
 #define EPHEMERON_KEY_WRITE_BARRIER(object, offset, value) \
@@ -469,7 +474,8 @@
   } while (false)
 #endif
 
-#ifdef V8_DISABLE_WRITE_BARRIERS
+#if defined(V8_DISABLE_WRITE_BARRIERS) && \
+    !defined(V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL)
 #define CONDITIONAL_WRITE_BARRIER(object, offset, value, mode)
 #elif V8_ENABLE_UNCONDITIONAL_WRITE_BARRIERS
 #define CONDITIONAL_WRITE_BARRIER(object, offset, value, mode) \
@@ -488,7 +494,8 @@
   } while (false)
 #endif
 
-#ifdef V8_DISABLE_WRITE_BARRIERS
+#if defined(V8_DISABLE_WRITE_BARRIERS) && \
+    !defined(V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL)
 #define CONDITIONAL_WEAK_WRITE_BARRIER(object, offset, value, mode)
 #elif V8_ENABLE_UNCONDITIONAL_WRITE_BARRIERS
 #define CONDITIONAL_WEAK_WRITE_BARRIER(object, offset, value, mode) \
@@ -508,7 +515,8 @@
   } while (false)
 #endif
 
-#ifdef V8_DISABLE_WRITE_BARRIERS
+#if defined(V8_DISABLE_WRITE_BARRIERS) && \
+    !defined(V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL)
 #define CONDITIONAL_EPHEMERON_KEY_WRITE_BARRIER(object, offset, value, mode)
 #else
 #define CONDITIONAL_EPHEMERON_KEY_WRITE_BARRIER(object, offset, value, mode) \
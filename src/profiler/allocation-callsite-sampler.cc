@@ -0,0 +1,264 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/profiler/allocation-callsite-sampler.h"
+
+#include <atomic>
+
+#include "include/v8-platform.h"
+#include "src/base/ieee754.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/utils/random-number-generator.h"
+#include "src/execution/frames-inl.h"
+#include "src/execution/isolate.h"
+#include "src/handles/global-handles.h"
+#include "src/heap/heap-inl.h"
+#include "src/init/v8.h"
+#include "src/logging/counters.h"
+#include "src/objects/shared-function-info.h"
+#include "src/profiler/circular-queue-inl.h"
+#include "src/profiler/sampling-heap-profiler.h"
+#include "src/profiler/strings-storage.h"
+
+namespace v8 {
+namespace internal {
+
+// Single producer (the main thread) and single consumer queue of events. The
+// consumer side is serialized by |mutex_|, so that aggregation tasks and
+// GetStatsDelta() can both drain the queue.
+class AllocationCallsiteSampler::Aggregator final {
+ public:
+  static const unsigned kQueueLength = 1024;
+
+  // Returns false if the queue is full and the event was dropped.
+  bool Enqueue(const Event& event) {
+    Event* entry = queue_.StartEnqueue();
+    if (!entry) return false;
+    *entry = event;
+    queue_.FinishEnqueue();
+    return true;
+  }
+
+  void Drain() {
+    base::MutexGuard guard(&mutex_);
+    DrainLocked();
+  }
+
+  void TakeStats(StatsMap* stats) {
+    base::MutexGuard guard(&mutex_);
+    DrainLocked();
+    stats->swap(stats_);
+    stats_.clear();
+  }
+
+  std::atomic<bool> task_pending{false};
+
+ private:
+  void DrainLocked() {
+    while (Event* event = queue_.Peek()) {
+      Stats& stats = stats_[event->callsite.key];
+      stats.function = event->callsite.function;
+      if (event->kind == Event::kAllocation) {
+        stats.allocation_samples++;
+        stats.allocation_bytes += event->size;
+      } else {
+        stats.surviving_samples++;
+        stats.surviving_bytes += event->size;
+      }
+      queue_.Remove();
+    }
+  }
+
+  SamplingCircularQueue<Event, kQueueLength> queue_;
+  base::Mutex mutex_;
+  StatsMap stats_;
+};
+
+class AllocationCallsiteSampler::AggregationTask final : public v8::Task {
+ public:
+  explicit AggregationTask(std::shared_ptr<Aggregator> aggregator)
+      : aggregator_(std::move(aggregator)) {}
+
+  void Run() override {
+    aggregator_->task_pending.store(false, std::memory_order_relaxed);
+    aggregator_->Drain();
+  }
+
+ private:
+  std::shared_ptr<Aggregator> aggregator_;
+};
+
+class AllocationCallsiteSampler::Observer final : public AllocationObserver {
+ public:
+  Observer(AllocationCallsiteSampler* sampler, uint64_t rate,
+           base::RandomNumberGenerator* random)
+      : AllocationObserver(static_cast<intptr_t>(rate)),
+        sampler_(sampler),
+        random_(random),
+        rate_(rate) {}
+
+  void Step(int bytes_allocated, Address soon_object, size_t size) override {
+    if (soon_object) sampler_->SampleObject(soon_object, size);
+  }
+
+  // Samples follow a Poisson process like in SamplingHeapProfiler.
+  intptr_t GetNextStepSize() override {
+    if (FLAG_sampling_heap_profiler_suppress_randomness) {
+      return static_cast<intptr_t>(rate_);
+    }
+    double next = (-base::ieee754::log(random_->NextDouble())) * rate_;
+    return next < kTaggedSize
+               ? kTaggedSize
+               : (next > INT_MAX ? INT_MAX : static_cast<intptr_t>(next));
+  }
+
+ private:
+  AllocationCallsiteSampler* const sampler_;
+  base::RandomNumberGenerator* const random_;
+  const uint64_t rate_;
+};
+
+AllocationCallsiteSampler::AllocationCallsiteSampler(Heap* heap,
+                                                     StringsStorage* names,
+                                                     uint64_t rate,
+                                                     int survival_gc_count)
+    : isolate_(Isolate::FromHeap(heap)),
+      heap_(heap),
+      names_(names),
+      survival_gc_count_(survival_gc_count),
+      observer_(new Observer(this, rate, isolate_->random_number_generator())),
+      aggregator_(std::make_shared<Aggregator>()) {
+  CHECK_GT(rate, 0u);
+  CHECK_GT(survival_gc_count_, 0);
+  heap_->AddAllocationObserversToAllSpaces(observer_.get(), observer_.get());
+  heap_->AddGCEpilogueCallback(OnGCEpilogue, kGCTypeAll, this);
+}
+
+AllocationCallsiteSampler::~AllocationCallsiteSampler() {
+  heap_->RemoveGCEpilogueCallback(OnGCEpilogue, this);
+  heap_->RemoveAllocationObserversFromAllSpaces(observer_.get(),
+                                                observer_.get());
+}
+
+AllocationCallsiteSampler::Callsite
+AllocationCallsiteSampler::CurrentCallsite() {
+  JavaScriptFrameIterator it(isolate_);
+  // Closures that are being materialized during deoptimization are not
+  // JSFunctions yet, see SamplingHeapProfiler::AddStack().
+  if (it.done() || !it.frame()->unchecked_function().IsJSFunction()) {
+    const char* name = names_->GetCopy("(root)");
+    uint64_t function_id = SamplingHeapProfiler::AllocationNode::function_id(
+        v8::UnboundScript::kNoScriptId, 0, name);
+    return {{function_id, -1},
+            FunctionInfo{name, v8::UnboundScript::kNoScriptId, 0}};
+  }
+
+  JavaScriptFrame* frame = it.frame();
+  SharedFunctionInfo shared = frame->function().shared();
+  int script_id = v8::UnboundScript::kNoScriptId;
+  if (shared.script().IsScript()) {
+    script_id = Script::cast(shared.script()).id();
+  }
+  const int start_position = shared.StartPosition();
+  // Functions without a script are identified by their name, which is only
+  // looked up for functions seen for the first time otherwise.
+  const char* name = nullptr;
+  if (script_id == v8::UnboundScript::kNoScriptId) {
+    name = names_->GetCopy(shared.DebugNameCStr().get());
+  }
+  uint64_t function_id = SamplingHeapProfiler::AllocationNode::function_id(
+      script_id, start_position, name);
+  auto function = functions_.find(function_id);
+  if (function == functions_.end()) {
+    // Names are owned by |names_|, so dropping the cache loses nothing but
+    // the lookups it saves.
+    if (functions_.size() >= kMaxCachedFunctions) functions_.clear();
+    if (!name) name = names_->GetCopy(shared.DebugNameCStr().get());
+    function = functions_
+                   .emplace(function_id,
+                            FunctionInfo{name, script_id, start_position})
+                   .first;
+  }
+
+  int bytecode_offset = -1;
+  if (frame->is_unoptimized()) {
+    bytecode_offset = UnoptimizedFrame::cast(frame)->GetBytecodeOffset();
+  }
+  return {{function_id, bytecode_offset}, function->second};
+}
+
+void AllocationCallsiteSampler::SampleObject(Address soon_object,
+                                             size_t size) {
+  DisallowGarbageCollection no_gc;
+  // The object is not initialized yet. Make the area iterable before it is
+  // referenced by a handle that the GC may visit.
+  heap_->CreateFillerObjectAt(soon_object, static_cast<int>(size),
+                              ClearRecordedSlots::kNo);
+  Callsite callsite = CurrentCallsite();
+  Enqueue(Event::kAllocation, callsite, size);
+  samples_.push_back(std::make_unique<Sample>(
+      callsite, size, isolate_, HeapObject::FromAddress(soon_object)));
+}
+
+void AllocationCallsiteSampler::Enqueue(Event::Kind kind,
+                                        const Callsite& callsite, size_t size) {
+  // A full queue means the worker thread fell behind. The event is dropped as
+  // blocking the main thread would defeat the purpose of the sampler.
+  if (!aggregator_->Enqueue({kind, callsite, size})) {
+    dropped_events_++;
+    isolate_->counters()->allocation_callsite_sampler_dropped_events()
+        ->Increment();
+    return;
+  }
+  if (++events_since_aggregation_ < kAggregationInterval) return;
+  events_since_aggregation_ = 0;
+  if (aggregator_->task_pending.exchange(true, std::memory_order_relaxed)) {
+    return;
+  }
+  V8::GetCurrentPlatform()->CallOnWorkerThread(
+      std::make_unique<AggregationTask>(aggregator_));
+}
+
+void AllocationCallsiteSampler::ProcessSamplesAfterGC() {
+  auto it = samples_.begin();
+  for (auto& sample : samples_) {
+    if (sample->object.IsAlive() &&
+        ++sample->gcs_survived >= survival_gc_count_) {
+      Enqueue(Event::kSurvival, sample->callsite, sample->size);
+      sample->object.Reset();
+    }
+    if (sample->object.IsAlive()) *it++ = std::move(sample);
+  }
+  samples_.erase(it, samples_.end());
+}
+
+// static
+void AllocationCallsiteSampler::OnGCEpilogue(v8::Isolate* isolate,
+                                             v8::GCType type,
+                                             v8::GCCallbackFlags flags,
+                                             void* data) {
+  static_cast<AllocationCallsiteSampler*>(data)->ProcessSamplesAfterGC();
+}
+
+void AllocationCallsiteSampler::GetStatsDelta(
+    std::vector<v8::AllocationCallsiteStats>* stats) {
+  StatsMap delta;
+  aggregator_->TakeStats(&delta);
+  for (const auto& entry : delta) {
+    const FunctionInfo& function = entry.second.function;
+    v8::AllocationCallsiteStats callsite;
+    callsite.function_name = function.name;
+    callsite.script_id = function.script_id;
+    callsite.start_position = function.start_position;
+    callsite.bytecode_offset = entry.first.bytecode_offset;
+    callsite.allocation_samples = entry.second.allocation_samples;
+    callsite.allocation_bytes = entry.second.allocation_bytes;
+    callsite.surviving_samples = entry.second.surviving_samples;
+    callsite.surviving_bytes = entry.second.surviving_bytes;
+    stats->push_back(callsite);
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
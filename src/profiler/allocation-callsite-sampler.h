@@ -0,0 +1,142 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PROFILER_ALLOCATION_CALLSITE_SAMPLER_H_
+#define V8_PROFILER_ALLOCATION_CALLSITE_SAMPLER_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "include/v8-profiler.h"
+#include "src/common/globals.h"
+#include "src/handles/global-handles.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+class Isolate;
+class StringsStorage;
+
+// Low-overhead allocation sampler that is cheap enough to stay enabled in
+// production. Unlike SamplingHeapProfiler, which symbolizes the full stack of
+// every sample, only the (function, bytecode offset) pair of the top
+// JavaScript frame is recorded. Samples are handed to a worker thread through
+// a lock-free queue and aggregated into per-call-site statistics there.
+//
+// Sampled objects are additionally tracked through phantom handles. Objects
+// that are still alive after |survival_gc_count| GCs are reported as
+// survivors of their call site, pointing at potential leaks.
+//
+// Events that do not fit into the queue are dropped rather than blocking the
+// main thread, and counted in dropped_events().
+class AllocationCallsiteSampler final {
+ public:
+  AllocationCallsiteSampler(Heap* heap, StringsStorage* names, uint64_t rate,
+                            int survival_gc_count);
+  ~AllocationCallsiteSampler();
+  AllocationCallsiteSampler(const AllocationCallsiteSampler&) = delete;
+  AllocationCallsiteSampler& operator=(const AllocationCallsiteSampler&) =
+      delete;
+
+  // Appends the statistics accumulated since the previous call, one entry per
+  // call site with new samples or survivors.
+  void GetStatsDelta(std::vector<v8::AllocationCallsiteStats>* stats);
+
+  size_t dropped_events() const { return dropped_events_; }
+
+  struct CallsiteKey {
+    uint64_t function_id;
+    int bytecode_offset;
+
+    bool operator==(const CallsiteKey& other) const {
+      return function_id == other.function_id &&
+             bytecode_offset == other.bytecode_offset;
+    }
+  };
+
+  struct CallsiteKeyHash {
+    size_t operator()(const CallsiteKey& key) const {
+      return static_cast<size_t>(key.function_id * 31 +
+                                 static_cast<uint32_t>(key.bytecode_offset));
+    }
+  };
+
+  struct FunctionInfo {
+    const char* name;
+    int script_id;
+    int start_position;
+  };
+
+  struct Callsite {
+    CallsiteKey key;
+    FunctionInfo function;
+  };
+
+  struct Event {
+    enum Kind : uint8_t { kAllocation, kSurvival };
+    Kind kind;
+    Callsite callsite;
+    size_t size;
+  };
+
+  struct Stats {
+    FunctionInfo function;
+    size_t allocation_samples = 0;
+    size_t allocation_bytes = 0;
+    size_t surviving_samples = 0;
+    size_t surviving_bytes = 0;
+  };
+
+  using StatsMap = std::unordered_map<CallsiteKey, Stats, CallsiteKeyHash>;
+
+ private:
+  class AggregationTask;
+  class Aggregator;
+  class Observer;
+
+  struct Sample {
+    Sample(const Callsite& callsite, size_t size, Isolate* isolate,
+           HeapObject object)
+        : callsite(callsite), size(size), object(isolate, object) {}
+
+    Callsite callsite;
+    size_t size;
+    int gcs_survived = 0;
+    PhantomGlobalHandle object;
+  };
+
+  // Number of events after which aggregation is posted to a worker thread.
+  static const size_t kAggregationInterval = 128;
+  // Bounds the cache of function infos. Events carry their function info, so
+  // the cache can be cleared at any time.
+  static const size_t kMaxCachedFunctions = 4096;
+
+  void SampleObject(Address soon_object, size_t size);
+  Callsite CurrentCallsite();
+  void Enqueue(Event::Kind kind, const Callsite& callsite, size_t size);
+  void ProcessSamplesAfterGC();
+  static void OnGCEpilogue(v8::Isolate* isolate, v8::GCType type,
+                           v8::GCCallbackFlags flags, void* data);
+
+  Isolate* const isolate_;
+  Heap* const heap_;
+  StringsStorage* const names_;
+  const int survival_gc_count_;
+  std::unique_ptr<Observer> observer_;
+  // Shared with aggregation tasks, which may outlive the sampler.
+  std::shared_ptr<Aggregator> aggregator_;
+  size_t events_since_aggregation_ = 0;
+
+  // Only accessed on the main thread.
+  size_t dropped_events_ = 0;
+  std::unordered_map<uint64_t, FunctionInfo> functions_;
+  std::vector<std::unique_ptr<Sample>> samples_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PROFILER_ALLOCATION_CALLSITE_SAMPLER_H_
@@ -4,16 +4,19 @@
 
 #include "src/profiler/cpu-profiler.h"
 
+#include <algorithm>
 #include <unordered_map>
 #include <utility>
 
 #include "include/v8-locker.h"
+#include "include/v8-platform.h"
 #include "src/base/lazy-instance.h"
 #include "src/base/template-utils.h"
 #include "src/debug/debug.h"
 #include "src/execution/frames-inl.h"
 #include "src/execution/v8threads.h"
 #include "src/execution/vm-state-inl.h"
+#include "src/init/v8.h"
 #include "src/libsampler/sampler.h"
 #include "src/logging/counters.h"
 #include "src/logging/log.h"
@@ -126,6 +129,8 @@ SamplingEventsProcessor::SamplingEventsProcessor(
       sampler_(new CpuSampler(isolate, this)),
       period_(period),
       use_precise_sampling_(use_precise_sampling) {
+  batch_.reserve(kSymbolizationBatchSize);
+  symbolized_batch_.reserve(kSymbolizationBatchSize);
   sampler_->Start();
 }
 
@@ -228,14 +233,94 @@ void ProfilerEventsProcessor::CodeEventHandler(
   }
 }
 
+class SamplingEventsProcessor::SymbolizationJob final : public JobTask {
+ public:
+  SymbolizationJob(Symbolizer* symbolizer,
+                   const std::vector<TickSampleEventRecord>* records,
+                   std::vector<Symbolizer::SymbolizedSample>* results)
+      : symbolizer_(symbolizer), records_(records), results_(results) {}
+
+  void Run(JobDelegate* delegate) override {
+    while (!delegate->ShouldYield()) {
+      size_t start = next_.fetch_add(kChunkSize, std::memory_order_relaxed);
+      if (start >= records_->size()) return;
+      size_t end = std::min(start + kChunkSize, records_->size());
+      for (size_t i = start; i < end; i++) {
+        (*results_)[i] =
+            symbolizer_->SymbolizeTickSample((*records_)[i].sample);
+      }
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const override {
+    size_t next = next_.load(std::memory_order_relaxed);
+    if (next >= records_->size()) return 0;
+    return (records_->size() - next + kChunkSize - 1) / kChunkSize;
+  }
+
+ private:
+  static const size_t kChunkSize = 4;
+
+  Symbolizer* const symbolizer_;
+  const std::vector<TickSampleEventRecord>* const records_;
+  std::vector<Symbolizer::SymbolizedSample>* const results_;
+  std::atomic<size_t> next_{0};
+};
+
 void SamplingEventsProcessor::SymbolizeAndAddToProfiles(
     const TickSampleEventRecord* record) {
-  Symbolizer::SymbolizedSample symbolized =
-      symbolizer_->SymbolizeTickSample(record->sample);
+  AddToProfiles(*record, symbolizer_->SymbolizeTickSample(record->sample));
+}
+
+void SamplingEventsProcessor::AddToProfiles(
+    const TickSampleEventRecord& record,
+    const Symbolizer::SymbolizedSample& symbolized) {
+  const TickSample& sample = record.sample;
+  if (!sample.timestamp.IsNull() &&
+      base::TimeTicks::HighResolutionNow() - sample.timestamp >
+          period_ * kLateSamplePeriods) {
+    ProfilerStats::Instance()->AddReason(ProfilerStats::Reason::kLateTick);
+  }
   profiles_->AddPathToCurrentProfiles(
-      record->sample.timestamp, symbolized.stack_trace, symbolized.src_line,
-      record->sample.update_stats, record->sample.sampling_interval,
-      reinterpret_cast<Address>(record->sample.context));
+      sample.timestamp, symbolized.stack_trace, symbolized.src_line,
+      sample.update_stats, sample.sampling_interval,
+      reinterpret_cast<Address>(sample.context));
+}
+
+void SamplingEventsProcessor::ProcessSampleBatch() {
+  DCHECK(batch_.empty());
+  while (batch_.size() < kSymbolizationBatchSize) {
+    const TickSampleEventRecord* record = ticks_buffer_.Peek();
+    if (record == nullptr || record->order != last_processed_code_event_id_) {
+      break;
+    }
+    batch_.push_back(*record);
+    ticks_buffer_.Remove();
+  }
+  DCHECK(!batch_.empty());
+
+  symbolized_batch_.resize(batch_.size());
+  if (FLAG_cpu_profiler_parallel_symbolization &&
+      batch_.size() >= kParallelSymbolizationThreshold) {
+    // Joining lets this thread participate and waits for all workers, so the
+    // code map is not modified while it is being read.
+    V8::GetCurrentPlatform()
+        ->PostJob(TaskPriority::kUserBlocking,
+                  std::make_unique<SymbolizationJob>(symbolizer_, &batch_,
+                                                     &symbolized_batch_))
+        ->Join();
+  } else {
+    for (size_t i = 0; i < batch_.size(); i++) {
+      symbolized_batch_[i] = symbolizer_->SymbolizeTickSample(batch_[i].sample);
+    }
+  }
+
+  // Samples are added in the order in which they were taken.
+  for (size_t i = 0; i < batch_.size(); i++) {
+    AddToProfiles(batch_[i], symbolized_batch_[i]);
+  }
+  batch_.clear();
+  symbolized_batch_.clear();
 }
 
 ProfilerEventsProcessor::SampleProcessingResult
@@ -257,8 +342,7 @@ SamplingEventsProcessor::ProcessOneSample() {
   if (record->order != last_processed_code_event_id_) {
     return FoundSampleForNextCodeEvent;
   }
-  SymbolizeAndAddToProfiles(record);
-  ticks_buffer_.Remove();
+  ProcessSampleBatch();
   return OneSampleProcessed;
 }
 
@@ -7,12 +7,14 @@
 
 #include <atomic>
 #include <memory>
+#include <vector>
 
 #include "src/base/platform/condition-variable.h"
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/time.h"
 #include "src/profiler/circular-queue.h"
 #include "src/profiler/profiler-listener.h"
+#include "src/profiler/symbolizer.h"
 #include "src/profiler/tick-sample.h"
 #include "src/utils/locked-queue.h"
 
@@ -27,7 +29,6 @@ class CodeEntry;
 class CodeMap;
 class CpuProfilesCollection;
 class Isolate;
-class Symbolizer;
 
 #define CODE_EVENTS_TYPE_LIST(V)                 \
   V(CODE_CREATION, CodeCreateEventRecord)        \
@@ -242,14 +243,34 @@ class V8_EXPORT_PRIVATE SamplingEventsProcessor
   base::TimeDelta period() const { return period_; }
 
  private:
+  class SymbolizationJob;
+
   SampleProcessingResult ProcessOneSample() override;
   void SymbolizeAndAddToProfiles(const TickSampleEventRecord* record);
+  void AddToProfiles(const TickSampleEventRecord& record,
+                     const Symbolizer::SymbolizedSample& symbolized);
+  // Moves the samples recorded before the next code event out of the ticks
+  // buffer, which frees the buffer for the sampler early, and symbolizes them
+  // as a batch. Large batches are symbolized in parallel if
+  // --cpu-profiler-parallel-symbolization is set. This is safe as the code map
+  // is only updated by this thread between batches.
+  void ProcessSampleBatch();
 
   static const size_t kTickSampleBufferSize = 512 * KB;
   static const size_t kTickSampleQueueLength =
       kTickSampleBufferSize / sizeof(TickSampleEventRecord);
+  // Maximum number of samples that are taken out of the ticks buffer at once.
+  static const size_t kSymbolizationBatchSize = 64;
+  // Minimum batch size for symbolizing on worker threads.
+  static const size_t kParallelSymbolizationThreshold = 16;
+  // Samples that are added to the profile more than this many sampling
+  // periods after they were taken are counted as late in ProfilerStats.
+  static const int kLateSamplePeriods = 64;
+
   SamplingCircularQueue<TickSampleEventRecord,
                         kTickSampleQueueLength> ticks_buffer_;
+  std::vector<TickSampleEventRecord> batch_;
+  std::vector<Symbolizer::SymbolizedSample> symbolized_batch_;
   std::unique_ptr<sampler::Sampler> sampler_;
   base::TimeDelta period_;           // Samples & code events processing period.
   const bool use_precise_sampling_;  // Whether or not busy-waiting is used for
@@ -9,6 +9,7 @@
 #include "src/heap/combined-heap.h"
 #include "src/heap/heap-inl.h"
 #include "src/objects/js-array-buffer-inl.h"
+#include "src/profiler/allocation-callsite-sampler.h"
 #include "src/profiler/allocation-tracker.h"
 #include "src/profiler/heap-snapshot-generator-inl.h"
 #include "src/profiler/sampling-heap-profiler.h"
@@ -31,7 +32,7 @@ void HeapProfiler::DeleteAllSnapshots() {
 
 void HeapProfiler::MaybeClearStringsStorage() {
   if (snapshots_.empty() && !sampling_heap_profiler_ && !allocation_tracker_ &&
-      !is_taking_snapshot_) {
+      !allocation_callsite_sampler_ && !is_taking_snapshot_) {
     names_.reset(new StringsStorage());
   }
 }
@@ -130,6 +131,26 @@ v8::AllocationProfile* HeapProfiler::GetAllocationProfile() {
   }
 }
 
+bool HeapProfiler::StartAllocationCallsiteSampling(uint64_t sample_interval,
+                                                   int survival_gc_count) {
+  if (allocation_callsite_sampler_) return false;
+  allocation_callsite_sampler_ = std::make_unique<AllocationCallsiteSampler>(
+      heap(), names_.get(), sample_interval, survival_gc_count);
+  return true;
+}
+
+void HeapProfiler::StopAllocationCallsiteSampling() {
+  allocation_callsite_sampler_.reset();
+  MaybeClearStringsStorage();
+}
+
+bool HeapProfiler::GetAllocationCallsiteStats(
+    std::vector<v8::AllocationCallsiteStats>* stats) {
+  if (!allocation_callsite_sampler_) return false;
+  allocation_callsite_sampler_->GetStatsDelta(stats);
+  return true;
+}
+
 
 void HeapProfiler::StartHeapObjectsTracking(bool track_allocations) {
   ids_->UpdateHeapObjectsMap();
@@ -18,6 +18,7 @@ namespace v8 {
 namespace internal {
 
 // Forward declarations.
+class AllocationCallsiteSampler;
 class AllocationTracker;
 class HeapObjectsMap;
 class HeapSnapshot;
@@ -42,6 +43,12 @@ class HeapProfiler : public HeapObjectAllocationTracker {
   bool is_sampling_allocations() { return !!sampling_heap_profiler_; }
   AllocationProfile* GetAllocationProfile();
 
+  bool StartAllocationCallsiteSampling(uint64_t sample_interval,
+                                       int survival_gc_count);
+  void StopAllocationCallsiteSampling();
+  bool GetAllocationCallsiteStats(
+      std::vector<v8::AllocationCallsiteStats>* stats);
+
   void StartHeapObjectsTracking(bool track_allocations);
   void StopHeapObjectsTracking();
   AllocationTracker* allocation_tracker() const {
@@ -108,6 +115,7 @@ class HeapProfiler : public HeapObjectAllocationTracker {
   bool is_taking_snapshot_;
   base::Mutex profiler_mutex_;
   std::unique_ptr<SamplingHeapProfiler> sampling_heap_profiler_;
+  std::unique_ptr<AllocationCallsiteSampler> allocation_callsite_sampler_;
   std::vector<std::pair<v8::HeapProfiler::BuildEmbedderGraphCallback, void*>>
       build_embedder_graph_callbacks_;
   std::pair<v8::HeapProfiler::GetDetachednessCallback, void*>
@@ -4,8 +4,11 @@
 
 #include "src/profiler/heap-snapshot-generator.h"
 
+#include <algorithm>
+#include <atomic>
 #include <utility>
 
+#include "include/v8-platform.h"
 #include "src/api/api-inl.h"
 #include "src/base/optional.h"
 #include "src/base/vector.h"
@@ -15,6 +18,7 @@
 #include "src/handles/global-handles.h"
 #include "src/heap/combined-heap.h"
 #include "src/heap/safepoint.h"
+#include "src/init/v8.h"
 #include "src/numbers/conversions.h"
 #include "src/objects/allocation-site-inl.h"
 #include "src/objects/api-callbacks.h"
@@ -718,17 +722,18 @@ int V8HeapExplorer::EstimateObjectsCount() {
   return objects_count;
 }
 
-class IndexedReferencesExtractor : public ObjectVisitorWithCageBases {
+// Records the references held in the fields of an object in the order in
+// which they are visited. Only reads the heap, so that it can run on worker
+// threads. V8HeapExplorer::SetIndexedReferences() turns them into edges.
+class IndexedReferencesCollector : public ObjectVisitorWithCageBases {
  public:
-  IndexedReferencesExtractor(V8HeapExplorer* generator, HeapObject parent_obj,
-                             HeapEntry* parent)
-      : ObjectVisitorWithCageBases(generator->isolate()),
-        generator_(generator),
-        parent_obj_(parent_obj),
-        parent_start_(parent_obj_.RawMaybeWeakField(0)),
-        parent_end_(parent_obj_.RawMaybeWeakField(parent_obj_.Size())),
-        parent_(parent),
-        next_index_(0) {}
+  IndexedReferencesCollector(
+      Isolate* isolate, HeapObject parent_obj,
+      std::vector<V8HeapExplorer::IndexedReference>* references)
+      : ObjectVisitorWithCageBases(isolate),
+        parent_start_(parent_obj.RawMaybeWeakField(0)),
+        parent_end_(parent_obj.RawMaybeWeakField(parent_obj.Size())),
+        references_(references) {}
   void VisitPointers(HeapObject host, ObjectSlot start,
                      ObjectSlot end) override {
     VisitPointers(host, MaybeObjectSlot(start), MaybeObjectSlot(end));
@@ -754,16 +759,12 @@ class IndexedReferencesExtractor : public ObjectVisitorWithCageBases {
 
   void VisitCodeTarget(Code host, RelocInfo* rinfo) override {
     Code target = Code::GetCodeFromTargetAddress(rinfo->target_address());
-    VisitHeapObjectImpl(target, -1);
+    references_->push_back({target, -1, false});
   }
 
   void VisitEmbeddedPointer(Code host, RelocInfo* rinfo) override {
     HeapObject object = rinfo->target_object(cage_base());
-    if (host.IsWeakObject(object)) {
-      generator_->SetWeakReference(parent_, next_index_++, object, {});
-    } else {
-      VisitHeapObjectImpl(object, -1);
-    }
+    references_->push_back({object, -1, host.IsWeakObject(object)});
   }
 
  private:
@@ -771,36 +772,80 @@ class IndexedReferencesExtractor : public ObjectVisitorWithCageBases {
   V8_INLINE void VisitSlotImpl(PtrComprCageBase cage_base, TSlot slot) {
     int field_index =
         static_cast<int>(MaybeObjectSlot(slot.address()) - parent_start_);
-    if (generator_->visited_fields_[field_index]) {
-      generator_->visited_fields_[field_index] = false;
-    } else {
-      HeapObject heap_object;
-      auto loaded_value = slot.load(cage_base);
-      if (loaded_value.GetHeapObjectIfStrong(&heap_object)) {
-        VisitHeapObjectImpl(heap_object, field_index);
-      } else if (loaded_value.GetHeapObjectIfWeak(&heap_object)) {
-        generator_->SetWeakReference(parent_, next_index_++, heap_object, {});
+    HeapObject heap_object;
+    auto loaded_value = slot.load(cage_base);
+    if (loaded_value.GetHeapObjectIfStrong(&heap_object)) {
+      references_->push_back({heap_object, field_index, false});
+    } else if (loaded_value.GetHeapObjectIfWeak(&heap_object)) {
+      references_->push_back({heap_object, field_index, true});
+    }
+  }
+
+  MaybeObjectSlot parent_start_;
+  MaybeObjectSlot parent_end_;
+  std::vector<V8HeapExplorer::IndexedReference>* references_;
+};
+
+// Collects the indexed references of a batch of objects on worker threads.
+class V8HeapExplorer::IndexedReferencesJob final : public JobTask {
+ public:
+  explicit IndexedReferencesJob(V8HeapExplorer* explorer)
+      : explorer_(explorer) {}
+
+  void Run(JobDelegate* delegate) override {
+    const size_t size = explorer_->batch_.size();
+    while (!delegate->ShouldYield()) {
+      size_t start = next_.fetch_add(kChunkSize, std::memory_order_relaxed);
+      if (start >= size) return;
+      size_t end = std::min(start + kChunkSize, size);
+      for (size_t i = start; i < end; i++) {
+        explorer_->CollectIndexedReferences(i);
       }
     }
   }
 
-  V8_INLINE void VisitHeapObjectImpl(HeapObject heap_object, int field_index) {
-    DCHECK_LE(-1, field_index);
-    // The last parameter {field_offset} is only used to check some well-known
-    // skipped references, so passing -1 * kTaggedSize for objects embedded
-    // into code is fine.
-    generator_->SetHiddenReference(parent_obj_, parent_, next_index_++,
-                                   heap_object, field_index * kTaggedSize);
+  size_t GetMaxConcurrency(size_t worker_count) const override {
+    const size_t size = explorer_->batch_.size();
+    size_t next = next_.load(std::memory_order_relaxed);
+    if (next >= size) return 0;
+    return (size - next + kChunkSize - 1) / kChunkSize;
   }
 
-  V8HeapExplorer* generator_;
-  HeapObject parent_obj_;
-  MaybeObjectSlot parent_start_;
-  MaybeObjectSlot parent_end_;
-  HeapEntry* parent_;
-  int next_index_;
+ private:
+  static const size_t kChunkSize = 64;
+
+  V8HeapExplorer* const explorer_;
+  std::atomic<size_t> next_{0};
 };
 
+void V8HeapExplorer::CollectIndexedReferences(size_t index) {
+  HeapObject obj = batch_[index];
+  IndexedReferencesCollector collector(isolate(), obj,
+                                       &batch_references_[index]);
+  obj.Iterate(&collector);
+}
+
+void V8HeapExplorer::SetIndexedReferences(
+    HeapObject obj, HeapEntry* entry,
+    const std::vector<IndexedReference>& references) {
+  int next_index = 0;
+  for (const IndexedReference& reference : references) {
+    // Fields visited by ExtractReferences() already got a named edge.
+    if (reference.field_index >= 0 && visited_fields_[reference.field_index]) {
+      continue;
+    }
+    if (reference.is_weak) {
+      SetWeakReference(entry, next_index++, reference.object, {});
+    } else {
+      // The last parameter {field_offset} is only used to check some
+      // well-known skipped references, so passing -1 * kTaggedSize for
+      // objects embedded into code is fine.
+      SetHiddenReference(obj, entry, next_index++, reference.object,
+                         reference.field_index * kTaggedSize);
+    }
+  }
+}
+
 void V8HeapExplorer::ExtractReferences(HeapEntry* entry, HeapObject obj) {
   if (obj.IsJSGlobalProxy()) {
     ExtractJSGlobalProxyReferences(entry, JSGlobalProxy::cast(obj));
@@ -1629,11 +1674,45 @@ bool V8HeapExplorer::IterateAndExtractReferences(
 
   CombinedHeapObjectIterator iterator(heap_,
                                       HeapObjectIterator::kFilterUnreachable);
-  // Heap iteration with filtering must be finished in any case.
+  // Heap iteration with filtering must be finished in any case. The iterator
+  // also keeps the batched objects from moving.
   for (HeapObject obj = iterator.Next(); !obj.is_null();
-       obj = iterator.Next(), progress_->ProgressStep()) {
+       obj = iterator.Next()) {
     if (interrupted) continue;
+    batch_.push_back(obj);
+    if (batch_.size() == kExtractionBatchSize && !ExtractBatchReferences()) {
+      interrupted = true;
+    }
+  }
+  if (!interrupted && !batch_.empty() && !ExtractBatchReferences()) {
+    interrupted = true;
+  }
+  batch_.clear();
+  batch_references_.clear();
 
+  generator_ = nullptr;
+  return interrupted ? false : progress_->ProgressReport(true);
+}
+
+bool V8HeapExplorer::ExtractBatchReferences() {
+  batch_references_.resize(batch_.size());
+  if (FLAG_heap_snapshot_parallel_extraction) {
+    // Joining lets this thread participate and waits for all workers. Edges
+    // are only added below, so entries are created in the same order as in
+    // a single-threaded walk.
+    V8::GetCurrentPlatform()
+        ->PostJob(TaskPriority::kUserBlocking,
+                  std::make_unique<IndexedReferencesJob>(this))
+        ->Join();
+  } else {
+    for (size_t i = 0; i < batch_.size(); i++) {
+      CollectIndexedReferences(i);
+    }
+  }
+
+  bool interrupted = false;
+  for (size_t i = 0; i < batch_.size(); i++) {
+    HeapObject obj = batch_[i];
     size_t max_pointer = obj.Size() / kTaggedSize;
     if (max_pointer > visited_fields_.size()) {
       // Clear the current bits.
@@ -1645,24 +1724,25 @@ bool V8HeapExplorer::IterateAndExtractReferences(
     HeapEntry* entry = GetEntry(obj);
     ExtractReferences(entry, obj);
     SetInternalReference(entry, "map", obj.map(), HeapObject::kMapOffset);
-    // Extract unvisited fields as hidden references and restore tags
-    // of visited fields.
-    IndexedReferencesExtractor refs_extractor(this, obj, entry);
-    obj.Iterate(&refs_extractor);
+    // Extract unvisited fields as hidden references.
+    SetIndexedReferences(obj, entry, batch_references_[i]);
 
     // Ensure visited_fields_ doesn't leak to the next object.
-    for (size_t i = 0; i < max_pointer; ++i) {
-      DCHECK(!visited_fields_[i]);
-    }
+    std::fill(visited_fields_.begin(), visited_fields_.begin() + max_pointer,
+              false);
 
     // Extract location for specific object types
     ExtractLocation(entry, obj);
 
-    if (!progress_->ProgressReport(false)) interrupted = true;
+    progress_->ProgressStep();
+    if (!progress_->ProgressReport(false)) {
+      interrupted = true;
+      break;
+    }
   }
-
-  generator_ = nullptr;
-  return interrupted ? false : progress_->ProgressReport(true);
+  batch_.clear();
+  batch_references_.clear();
+  return !interrupted;
 }
 
 bool V8HeapExplorer::IsEssentialObject(Object object) {
@@ -2341,6 +2421,19 @@ class OutputStreamWriter {
     }
   }
   void AddNumber(unsigned n) { AddNumberImpl<unsigned>(n, "%u"); }
+  void AddByte(uint8_t byte) {
+    DCHECK(chunk_pos_ < chunk_size_);
+    chunk_[chunk_pos_++] = static_cast<char>(byte);
+    MaybeWriteChunk();
+  }
+  // Writes |value| as an unsigned LEB128 varint.
+  void AddVarint(uint64_t value) {
+    while (value >= 0x80) {
+      AddByte(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    AddByte(static_cast<uint8_t>(value));
+  }
   void Finalize() {
     if (aborted_) return;
     DCHECK(chunk_pos_ < chunk_size_);
@@ -2510,40 +2603,32 @@ static int utoa(T value, const base::Vector<char>& buffer, int buffer_pos) {
   return utoa_impl(unsigned_value, buffer, buffer_pos);
 }
 
-void HeapSnapshotJSONSerializer::SerializeEdge(HeapGraphEdge* edge,
-                                               bool first_edge) {
+// The JSON writers below are shared by HeapSnapshotJSONSerializer and
+// HeapSnapshotBinaryConverter, which must produce identical output.
+static void WriteJSONEdge(OutputStreamWriter* writer, bool first_edge,
+                          unsigned type, int name_or_index, int to_node) {
   // The buffer needs space for 3 unsigned ints, 3 commas, \n and \0
   static const int kBufferSize =
       MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned * 3 + 3 + 2;
   base::EmbeddedVector<char, kBufferSize> buffer;
-  int edge_name_or_index = edge->type() == HeapGraphEdge::kElement
-      || edge->type() == HeapGraphEdge::kHidden
-      ? edge->index() : GetStringId(edge->name());
   int buffer_pos = 0;
   if (!first_edge) {
     buffer[buffer_pos++] = ',';
   }
-  buffer_pos = utoa(edge->type(), buffer, buffer_pos);
+  buffer_pos = utoa(type, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(edge_name_or_index, buffer, buffer_pos);
+  buffer_pos = utoa(name_or_index, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(to_node_index(edge->to()), buffer, buffer_pos);
+  buffer_pos = utoa(to_node, buffer, buffer_pos);
   buffer[buffer_pos++] = '\n';
   buffer[buffer_pos++] = '\0';
-  writer_->AddString(buffer.begin());
+  writer->AddString(buffer.begin());
 }
 
-void HeapSnapshotJSONSerializer::SerializeEdges() {
-  std::vector<HeapGraphEdge*>& edges = snapshot_->children();
-  for (size_t i = 0; i < edges.size(); ++i) {
-    DCHECK(i == 0 ||
-           edges[i - 1]->from()->index() <= edges[i]->from()->index());
-    SerializeEdge(edges[i], i == 0);
-    if (writer_->aborted()) return;
-  }
-}
-
-void HeapSnapshotJSONSerializer::SerializeNode(const HeapEntry* entry) {
+static void WriteJSONNode(OutputStreamWriter* writer, bool first_node,
+                          unsigned type, int name, SnapshotObjectId id,
+                          size_t self_size, int edge_count,
+                          unsigned trace_node_id, uint8_t detachedness) {
   // The buffer needs space for 5 unsigned ints, 1 size_t, 1 uint8_t, 7 commas,
   // \n and \0
   static const int kBufferSize =
@@ -2552,25 +2637,70 @@ void HeapSnapshotJSONSerializer::SerializeNode(const HeapEntry* entry) {
       MaxDecimalDigitsIn<sizeof(uint8_t)>::kUnsigned + 7 + 1 + 1;
   base::EmbeddedVector<char, kBufferSize> buffer;
   int buffer_pos = 0;
-  if (to_node_index(entry) != 0) {
+  if (!first_node) {
     buffer[buffer_pos++] = ',';
   }
-  buffer_pos = utoa(entry->type(), buffer, buffer_pos);
+  buffer_pos = utoa(type, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(GetStringId(entry->name()), buffer, buffer_pos);
+  buffer_pos = utoa(name, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(entry->id(), buffer, buffer_pos);
+  buffer_pos = utoa(id, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(entry->self_size(), buffer, buffer_pos);
+  buffer_pos = utoa(self_size, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(entry->children_count(), buffer, buffer_pos);
+  buffer_pos = utoa(edge_count, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(entry->trace_node_id(), buffer, buffer_pos);
+  buffer_pos = utoa(trace_node_id, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(entry->detachedness(), buffer, buffer_pos);
+  buffer_pos = utoa(detachedness, buffer, buffer_pos);
   buffer[buffer_pos++] = '\n';
   buffer[buffer_pos++] = '\0';
-  writer_->AddString(buffer.begin());
+  writer->AddString(buffer.begin());
+}
+
+static void WriteJSONLocation(OutputStreamWriter* writer, int object_index,
+                              int script_id, int line, int col) {
+  // The buffer needs space for 4 unsigned ints, 3 commas, \n and \0
+  static const int kBufferSize =
+      MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned * 4 + 3 + 2;
+  base::EmbeddedVector<char, kBufferSize> buffer;
+  int buffer_pos = 0;
+  buffer_pos = utoa(object_index, buffer, buffer_pos);
+  buffer[buffer_pos++] = ',';
+  buffer_pos = utoa(script_id, buffer, buffer_pos);
+  buffer[buffer_pos++] = ',';
+  buffer_pos = utoa(line, buffer, buffer_pos);
+  buffer[buffer_pos++] = ',';
+  buffer_pos = utoa(col, buffer, buffer_pos);
+  buffer[buffer_pos++] = '\n';
+  buffer[buffer_pos++] = '\0';
+  writer->AddString(buffer.begin());
+}
+
+void HeapSnapshotJSONSerializer::SerializeEdge(HeapGraphEdge* edge,
+                                               bool first_edge) {
+  int edge_name_or_index = edge->type() == HeapGraphEdge::kElement
+      || edge->type() == HeapGraphEdge::kHidden
+      ? edge->index() : GetStringId(edge->name());
+  WriteJSONEdge(writer_, first_edge, edge->type(), edge_name_or_index,
+                to_node_index(edge->to()));
+}
+
+void HeapSnapshotJSONSerializer::SerializeEdges() {
+  std::vector<HeapGraphEdge*>& edges = snapshot_->children();
+  for (size_t i = 0; i < edges.size(); ++i) {
+    DCHECK(i == 0 ||
+           edges[i - 1]->from()->index() <= edges[i]->from()->index());
+    SerializeEdge(edges[i], i == 0);
+    if (writer_->aborted()) return;
+  }
+}
+
+void HeapSnapshotJSONSerializer::SerializeNode(const HeapEntry* entry) {
+  WriteJSONNode(writer_, to_node_index(entry) == 0, entry->type(),
+                GetStringId(entry->name()), entry->id(), entry->self_size(),
+                entry->children_count(), entry->trace_node_id(),
+                entry->detachedness());
 }
 
 void HeapSnapshotJSONSerializer::SerializeNodes() {
@@ -2581,8 +2711,10 @@ void HeapSnapshotJSONSerializer::SerializeNodes() {
   }
 }
 
-void HeapSnapshotJSONSerializer::SerializeSnapshot() {
-  writer_->AddString("\"meta\":");
+static void WriteJSONSnapshotInfo(OutputStreamWriter* writer,
+                                  unsigned node_count, unsigned edge_count,
+                                  uint32_t trace_function_count) {
+  writer->AddString("\"meta\":");
   // The object describing node serialization layout.
   // We use a set of macros to improve readability.
 
@@ -2590,7 +2722,7 @@ void HeapSnapshotJSONSerializer::SerializeSnapshot() {
 #define JSON_A(s) "[" s "]"
 #define JSON_O(s) "{" s "}"
 #define JSON_S(s) "\"" s "\""
-  writer_->AddString(JSON_O(
+  writer->AddString(JSON_O(
     JSON_S("node_fields") ":" JSON_A(
         JSON_S("type") ","
         JSON_S("name") ","
@@ -2661,17 +2793,24 @@ void HeapSnapshotJSONSerializer::SerializeSnapshot() {
 #undef JSON_S
 #undef JSON_O
 #undef JSON_A
-  writer_->AddString(",\"node_count\":");
-  writer_->AddNumber(static_cast<unsigned>(snapshot_->entries().size()));
-  writer_->AddString(",\"edge_count\":");
-  writer_->AddNumber(static_cast<double>(snapshot_->edges().size()));
-  writer_->AddString(",\"trace_function_count\":");
+  writer->AddString(",\"node_count\":");
+  writer->AddNumber(node_count);
+  writer->AddString(",\"edge_count\":");
+  writer->AddNumber(edge_count);
+  writer->AddString(",\"trace_function_count\":");
+  writer->AddNumber(trace_function_count);
+}
+
+void HeapSnapshotJSONSerializer::SerializeSnapshot() {
   uint32_t count = 0;
   AllocationTracker* tracker = snapshot_->profiler()->allocation_tracker();
   if (tracker) {
     count = static_cast<uint32_t>(tracker->function_info_list().size());
   }
-  writer_->AddNumber(count);
+  WriteJSONSnapshotInfo(writer_,
+                        static_cast<unsigned>(snapshot_->entries().size()),
+                        static_cast<unsigned>(snapshot_->edges().size()),
+                        count);
 }
 
 
@@ -2795,53 +2934,58 @@ void HeapSnapshotJSONSerializer::SerializeSamples() {
 }
 
 
-void HeapSnapshotJSONSerializer::SerializeString(const unsigned char* s) {
-  writer_->AddCharacter('\n');
-  writer_->AddCharacter('\"');
+static void WriteJSONString(OutputStreamWriter* writer,
+                            const unsigned char* s) {
+  writer->AddCharacter('\n');
+  writer->AddCharacter('\"');
   for ( ; *s != '\0'; ++s) {
     switch (*s) {
       case '\b':
-        writer_->AddString("\\b");
+        writer->AddString("\\b");
         continue;
       case '\f':
-        writer_->AddString("\\f");
+        writer->AddString("\\f");
         continue;
       case '\n':
-        writer_->AddString("\\n");
+        writer->AddString("\\n");
         continue;
       case '\r':
-        writer_->AddString("\\r");
+        writer->AddString("\\r");
         continue;
       case '\t':
-        writer_->AddString("\\t");
+        writer->AddString("\\t");
         continue;
       case '\"':
       case '\\':
-        writer_->AddCharacter('\\');
-        writer_->AddCharacter(*s);
+        writer->AddCharacter('\\');
+        writer->AddCharacter(*s);
         continue;
       default:
         if (*s > 31 && *s < 128) {
-          writer_->AddCharacter(*s);
+          writer->AddCharacter(*s);
         } else if (*s <= 31) {
           // Special character with no dedicated literal.
-          WriteUChar(writer_, *s);
+          WriteUChar(writer, *s);
         } else {
           // Convert UTF-8 into \u UTF-16 literal.
           size_t length = 1, cursor = 0;
           for ( ; length <= 4 && *(s + length) != '\0'; ++length) { }
           unibrow::uchar c = unibrow::Utf8::CalculateValue(s, length, &cursor);
           if (c != unibrow::Utf8::kBadChar) {
-            WriteUChar(writer_, c);
+            WriteUChar(writer, c);
             DCHECK_NE(cursor, 0);
             s += cursor - 1;
           } else {
-            writer_->AddCharacter('?');
+            writer->AddCharacter('?');
           }
         }
     }
   }
-  writer_->AddCharacter('\"');
+  writer->AddCharacter('\"');
+}
+
+void HeapSnapshotJSONSerializer::SerializeString(const unsigned char* s) {
+  WriteJSONString(writer_, s);
 }
 
 
@@ -2863,21 +3007,8 @@ void HeapSnapshotJSONSerializer::SerializeStrings() {
 
 void HeapSnapshotJSONSerializer::SerializeLocation(
     const SourceLocation& location) {
-  // The buffer needs space for 4 unsigned ints, 3 commas, \n and \0
-  static const int kBufferSize =
-      MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned * 4 + 3 + 2;
-  base::EmbeddedVector<char, kBufferSize> buffer;
-  int buffer_pos = 0;
-  buffer_pos = utoa(to_node_index(location.entry_index), buffer, buffer_pos);
-  buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(location.scriptId, buffer, buffer_pos);
-  buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(location.line, buffer, buffer_pos);
-  buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(location.col, buffer, buffer_pos);
-  buffer[buffer_pos++] = '\n';
-  buffer[buffer_pos++] = '\0';
-  writer_->AddString(buffer.begin());
+  WriteJSONLocation(writer_, to_node_index(location.entry_index),
+                    location.scriptId, location.line, location.col);
 }
 
 void HeapSnapshotJSONSerializer::SerializeLocations() {
@@ -2889,5 +3020,232 @@ void HeapSnapshotJSONSerializer::SerializeLocations() {
   }
 }
 
+const char HeapSnapshotBinarySerializer::kMagic[] = {'V', '8', 'H', 'S'};
+
+void HeapSnapshotBinarySerializer::Serialize(v8::OutputStream* stream) {
+  DCHECK_EQ(0, snapshot_->root()->index());
+  OutputStreamWriter writer(stream);
+  writer_ = &writer;
+  SerializeImpl();
+  writer_ = nullptr;
+}
+
+void HeapSnapshotBinarySerializer::SerializeImpl() {
+  for (char c : kMagic) writer_->AddByte(static_cast<uint8_t>(c));
+  writer_->AddVarint(kVersion);
+  writer_->AddVarint(snapshot_->entries().size());
+  writer_->AddVarint(snapshot_->children().size());
+  writer_->AddVarint(snapshot_->locations().size());
+
+  for (const HeapEntry& entry : snapshot_->entries()) {
+    writer_->AddVarint(entry.type());
+    SerializeString(entry.name());
+    writer_->AddVarint(entry.id());
+    writer_->AddVarint(entry.self_size());
+    writer_->AddVarint(entry.children_count());
+    writer_->AddVarint(entry.trace_node_id());
+    writer_->AddVarint(entry.detachedness());
+    if (writer_->aborted()) return;
+  }
+
+  for (HeapGraphEdge* edge : snapshot_->children()) {
+    writer_->AddVarint(edge->type());
+    if (edge->type() == HeapGraphEdge::kElement ||
+        edge->type() == HeapGraphEdge::kHidden) {
+      writer_->AddVarint(edge->index());
+    } else {
+      SerializeString(edge->name());
+    }
+    writer_->AddVarint(edge->to()->index());
+    if (writer_->aborted()) return;
+  }
+
+  for (const SourceLocation& location : snapshot_->locations()) {
+    // Lines and columns may be -1, which the JSON format writes as unsigned.
+    writer_->AddVarint(location.entry_index);
+    writer_->AddVarint(static_cast<uint32_t>(location.scriptId));
+    writer_->AddVarint(static_cast<uint32_t>(location.line));
+    writer_->AddVarint(static_cast<uint32_t>(location.col));
+    if (writer_->aborted()) return;
+  }
+  writer_->Finalize();
+}
+
+void HeapSnapshotBinarySerializer::SerializeString(const char* s) {
+  base::HashMap::Entry* cache_entry = strings_.LookupOrInsert(
+      const_cast<char*>(s), HeapSnapshotJSONSerializer::StringHash(s));
+  if (cache_entry->value != nullptr) {
+    writer_->AddVarint(reinterpret_cast<uintptr_t>(cache_entry->value));
+    return;
+  }
+  cache_entry->value = reinterpret_cast<void*>(next_string_id_++);
+  size_t length = strlen(s);
+  writer_->AddVarint(0);
+  writer_->AddVarint(length);
+  writer_->AddSubstring(s, static_cast<int>(length));
+}
+
+HeapSnapshotBinaryConverter::HeapSnapshotBinaryConverter(const char* data,
+                                                         size_t length)
+    : pos_(reinterpret_cast<const uint8_t*>(data)),
+      end_(reinterpret_cast<const uint8_t*>(data) + length) {
+  // String ids start at 1, matching the JSON format.
+  strings_.emplace_back("<dummy>");
+}
+
+bool HeapSnapshotBinaryConverter::ReadVarint(uint64_t* value) {
+  uint64_t result = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (pos_ == end_) return false;
+    uint8_t byte = *pos_++;
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool HeapSnapshotBinaryConverter::ReadInt(int* value) {
+  uint64_t result;
+  if (!ReadVarint(&result) || result > static_cast<uint64_t>(kMaxInt)) {
+    return false;
+  }
+  *value = static_cast<int>(result);
+  return true;
+}
+
+bool HeapSnapshotBinaryConverter::ReadUint32(uint32_t* value) {
+  uint64_t result;
+  if (!ReadVarint(&result) || result > kMaxUInt32) return false;
+  *value = static_cast<uint32_t>(result);
+  return true;
+}
+
+bool HeapSnapshotBinaryConverter::ReadString(int* id) {
+  if (!ReadInt(id) || static_cast<size_t>(*id) >= strings_.size()) {
+    return false;
+  }
+  if (*id != 0) return true;
+  uint64_t length;
+  if (!ReadVarint(&length) || length > static_cast<uint64_t>(end_ - pos_)) {
+    return false;
+  }
+  strings_.emplace_back(reinterpret_cast<const char*>(pos_),
+                        static_cast<size_t>(length));
+  pos_ += length;
+  *id = static_cast<int>(strings_.size() - 1);
+  return true;
+}
+
+bool HeapSnapshotBinaryConverter::Convert(v8::OutputStream* stream) {
+  if (static_cast<size_t>(end_ - pos_) <
+          sizeof(HeapSnapshotBinarySerializer::kMagic) ||
+      memcmp(pos_, HeapSnapshotBinarySerializer::kMagic,
+             sizeof(HeapSnapshotBinarySerializer::kMagic)) != 0) {
+    return false;
+  }
+  pos_ += sizeof(HeapSnapshotBinarySerializer::kMagic);
+  int version, node_count, edge_count, location_count;
+  if (!ReadInt(&version) ||
+      version != HeapSnapshotBinarySerializer::kVersion ||
+      !ReadInt(&node_count) ||
+      node_count > kMaxInt / HeapSnapshotJSONSerializer::kNodeFieldsCount ||
+      !ReadInt(&edge_count) || !ReadInt(&location_count)) {
+    return false;
+  }
+  OutputStreamWriter writer(stream);
+  writer_ = &writer;
+  bool result = ConvertImpl(node_count, edge_count, location_count);
+  writer_ = nullptr;
+  return result;
+}
+
+bool HeapSnapshotBinaryConverter::ConvertImpl(int node_count, int edge_count,
+                                              int location_count) {
+  const int kNodeFieldsCount = HeapSnapshotJSONSerializer::kNodeFieldsCount;
+  writer_->AddCharacter('{');
+  writer_->AddString("\"snapshot\":{");
+  // Allocation tracking data is not part of the binary format.
+  WriteJSONSnapshotInfo(writer_, node_count, edge_count, 0);
+  writer_->AddString("},\n");
+
+  writer_->AddString("\"nodes\":[");
+  int total_edge_count = 0;
+  for (int i = 0; i < node_count; ++i) {
+    int type, name, children_count;
+    uint64_t id, self_size, trace_node_id, detachedness;
+    if (!ReadInt(&type) || !ReadString(&name) || !ReadVarint(&id) ||
+        !ReadVarint(&self_size) || !ReadInt(&children_count) ||
+        !ReadVarint(&trace_node_id) || !ReadVarint(&detachedness)) {
+      return false;
+    }
+    total_edge_count += children_count;
+    if (total_edge_count > edge_count) return false;
+    WriteJSONNode(writer_, i == 0, type, name,
+                  static_cast<SnapshotObjectId>(id),
+                  static_cast<size_t>(self_size), children_count,
+                  static_cast<unsigned>(trace_node_id),
+                  static_cast<uint8_t>(detachedness));
+    if (writer_->aborted()) return true;
+  }
+  if (total_edge_count != edge_count) return false;
+  writer_->AddString("],\n");
+
+  writer_->AddString("\"edges\":[");
+  for (int i = 0; i < edge_count; ++i) {
+    int type, name_or_index, to_node;
+    if (!ReadInt(&type)) return false;
+    if (type == HeapGraphEdge::kElement || type == HeapGraphEdge::kHidden) {
+      if (!ReadInt(&name_or_index)) return false;
+    } else {
+      if (!ReadString(&name_or_index)) return false;
+    }
+    if (!ReadInt(&to_node) || to_node >= node_count) return false;
+    WriteJSONEdge(writer_, i == 0, type, name_or_index,
+                  to_node * kNodeFieldsCount);
+    if (writer_->aborted()) return true;
+  }
+  writer_->AddString("],\n");
+
+  writer_->AddString("\"trace_function_infos\":[");
+  writer_->AddString("],\n");
+  writer_->AddString("\"trace_tree\":[");
+  writer_->AddString("],\n");
+  writer_->AddString("\"samples\":[");
+  writer_->AddString("],\n");
+
+  writer_->AddString("\"locations\":[");
+  for (int i = 0; i < location_count; ++i) {
+    int node;
+    uint32_t script_id, line, col;
+    if (!ReadInt(&node) || node >= node_count || !ReadUint32(&script_id) ||
+        !ReadUint32(&line) || !ReadUint32(&col)) {
+      return false;
+    }
+    if (i > 0) writer_->AddCharacter(',');
+    WriteJSONLocation(writer_, node * kNodeFieldsCount,
+                      static_cast<int>(script_id), static_cast<int>(line),
+                      static_cast<int>(col));
+    if (writer_->aborted()) return true;
+  }
+  writer_->AddString("],\n");
+  if (pos_ != end_) return false;
+
+  writer_->AddString("\"strings\":[");
+  writer_->AddString("\"<dummy>\"");
+  for (size_t i = 1; i < strings_.size(); ++i) {
+    writer_->AddCharacter(',');
+    WriteJSONString(writer_, reinterpret_cast<const unsigned char*>(
+                                 strings_[i].c_str()));
+    if (writer_->aborted()) return true;
+  }
+  writer_->AddCharacter(']');
+  writer_->AddCharacter('}');
+  writer_->Finalize();
+  return true;
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -7,6 +7,7 @@
 
 #include <deque>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -368,6 +369,25 @@ class V8_EXPORT_PRIVATE V8HeapExplorer : public HeapEntriesAllocator {
   static String GetConstructorName(JSObject object);
 
  private:
+  // A reference held in a field of an object, found by walking its body.
+  // |field_index| is -1 for references embedded into code.
+  struct IndexedReference {
+    HeapObject object;
+    int field_index;
+    bool is_weak;
+  };
+
+  class IndexedReferencesJob;
+
+  // Number of objects whose fields are walked in one go, possibly on worker
+  // threads, before their edges are added to the snapshot.
+  static const size_t kExtractionBatchSize = 4096;
+
+  bool ExtractBatchReferences();
+  void CollectIndexedReferences(size_t index);
+  void SetIndexedReferences(HeapObject obj, HeapEntry* entry,
+                            const std::vector<IndexedReference>& references);
+
   void MarkVisitedField(int offset);
 
   HeapEntry* AddEntry(HeapObject object);
@@ -475,8 +495,10 @@ class V8_EXPORT_PRIVATE V8HeapExplorer : public HeapEntriesAllocator {
   v8::HeapProfiler::ObjectNameResolver* global_object_name_resolver_;
 
   std::vector<bool> visited_fields_;
+  std::vector<HeapObject> batch_;
+  std::vector<std::vector<IndexedReference>> batch_references_;
 
-  friend class IndexedReferencesExtractor;
+  friend class IndexedReferencesCollector;
   friend class RootsReferencesExtractor;
 };
 
@@ -627,6 +649,69 @@ class HeapSnapshotJSONSerializer {
 
   friend class HeapSnapshotJSONSerializerEnumerator;
   friend class HeapSnapshotJSONSerializerIterator;
+  friend class HeapSnapshotBinarySerializer;
+  friend class HeapSnapshotBinaryConverter;
+};
+
+// Serializes a snapshot into a compact binary format that is streamed to the
+// OutputStream as it is produced. All integers are unsigned LEB128 varints:
+//  - header: the magic bytes "V8HS", the format version, and the node, edge,
+//    and location counts,
+//  - nodes: type, name, id, self_size, edge_count, trace_node_id,
+//    detachedness,
+//  - edges: type, name or index, index of the target node,
+//  - locations: node index, script id, line, column.
+// A string is written as its id. Id 0 introduces a new string, followed by
+// its length and UTF-8 bytes, which gets the next id starting from 1.
+// Strings are numbered in the same order as in the JSON format, so that
+// HeapSnapshotBinaryConverter reproduces the JSON serializer's output.
+// Allocation tracking data (trace tree and samples) is not included.
+class HeapSnapshotBinarySerializer {
+ public:
+  static const char kMagic[4];
+  static const int kVersion = 1;
+
+  explicit HeapSnapshotBinarySerializer(HeapSnapshot* snapshot)
+      : snapshot_(snapshot),
+        strings_(HeapSnapshotJSONSerializer::StringsMatch) {}
+  HeapSnapshotBinarySerializer(const HeapSnapshotBinarySerializer&) = delete;
+  HeapSnapshotBinarySerializer& operator=(
+      const HeapSnapshotBinarySerializer&) = delete;
+  void Serialize(v8::OutputStream* stream);
+
+ private:
+  void SerializeImpl();
+  void SerializeString(const char* s);
+
+  HeapSnapshot* snapshot_;
+  base::CustomMatcherHashMap strings_;
+  int next_string_id_ = 1;
+  OutputStreamWriter* writer_ = nullptr;
+};
+
+// Converts the output of HeapSnapshotBinarySerializer into the JSON format.
+class HeapSnapshotBinaryConverter {
+ public:
+  HeapSnapshotBinaryConverter(const char* data, size_t length);
+  HeapSnapshotBinaryConverter(const HeapSnapshotBinaryConverter&) = delete;
+  HeapSnapshotBinaryConverter& operator=(const HeapSnapshotBinaryConverter&) =
+      delete;
+
+  // Returns false if the input is malformed, in which case the stream is not
+  // finalized.
+  bool Convert(v8::OutputStream* stream);
+
+ private:
+  bool ConvertImpl(int node_count, int edge_count, int location_count);
+  bool ReadVarint(uint64_t* value);
+  bool ReadInt(int* value);
+  bool ReadUint32(uint32_t* value);
+  bool ReadString(int* id);
+
+  const uint8_t* pos_;
+  const uint8_t* const end_;
+  std::vector<std::string> strings_;
+  OutputStreamWriter* writer_ = nullptr;
 };
 
 
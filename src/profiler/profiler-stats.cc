@@ -15,6 +15,10 @@ void ProfilerStats::AddReason(Reason reason) {
   counts_[reason].fetch_add(1, std::memory_order_relaxed);
 }
 
+int ProfilerStats::GetCount(Reason reason) const {
+  return counts_[reason].load(std::memory_order_relaxed);
+}
+
 void ProfilerStats::Clear() {
   for (int i = 0; i < Reason::kNumberOfReasons; i++) {
     counts_[i].store(0, std::memory_order_relaxed);
@@ -46,6 +50,8 @@ const char* ProfilerStats::ReasonToString(Reason reason) {
       return "kNoSymbolizedFrames";
     case kNullPC:
       return "kNullPC";
+    case kLateTick:
+      return "kLateTick";
     case kNumberOfReasons:
       return "kNumberOfReasons";
   }
@@ -23,6 +23,9 @@ class ProfilerStats {
     kInCallOrApply,
     kNoSymbolizedFrames,
     kNullPC,
+    // Not a failure: the TickSample was recorded and attributed, but the
+    // processor thread fell behind and added it to the profile late.
+    kLateTick,
 
     kNumberOfReasons,
   };
@@ -33,6 +36,7 @@ class ProfilerStats {
   }
 
   void AddReason(Reason reason);
+  int GetCount(Reason reason) const;
   void Clear();
   void Print() const;
 
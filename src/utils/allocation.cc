@@ -222,6 +222,14 @@ bool SetPermissions(v8::PageAllocator* page_allocator, void* address,
   return page_allocator->SetPermissions(address, size, access);
 }
 
+void AdviseHugePages(base::AddressRegion region) {
+  if (!FLAG_huge_page_heap) return;
+  const Address begin = RoundUp(region.begin(), base::OS::kHugePageSize);
+  const Address end = RoundDown(region.end(), base::OS::kHugePageSize);
+  if (begin >= end) return;
+  USE(base::OS::AdviseHugePages(reinterpret_cast<void*>(begin), end - begin));
+}
+
 bool OnCriticalMemoryPressure(size_t length) {
   // TODO(bbudge) Rework retry logic once embedders implement the more
   // informative overload.
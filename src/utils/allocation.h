@@ -181,6 +181,11 @@ inline bool SetPermissions(v8::PageAllocator* page_allocator, Address address,
                         access);
 }
 
+// Advises the OS to back the huge page aligned part of |region| with
+// transparent huge pages when --huge-page-heap is set. Pages committed in the
+// region later on inherit the advice.
+V8_EXPORT_PRIVATE void AdviseHugePages(base::AddressRegion region);
+
 // Function that may release reserved memory regions to allow failed allocations
 // to succeed. |length| is the amount of memory needed. Returns |true| if memory
 // could be released, false otherwise.
@@ -0,0 +1,153 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <utility>
+
+#include "include/v8-array-buffer.h"
+#include "include/v8-isolate.h"
+#include "src/base/utils/random-number-generator.h"
+#include "src/execution/isolate.h"
+#include "src/heap/free-list.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/memory-allocator.h"
+#include "src/heap/paged-spaces.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace v8 {
+namespace internal {
+namespace {
+
+// Indexed by --gc-freelist-strategy.
+constexpr const char* kStrategyNames[] = {
+    "FreeListManyCachedOrigin", "FreeListManyCachedFastPath",
+    "FreeListManyCached", "FreeListMany", "FreeListSizeClasses"};
+constexpr int kNumberOfStrategies = arraysize(kStrategyNames);
+
+// The free list starts out with the areas of kPages freshly allocated pages,
+// cut into blocks of the sizes requested by the workload.
+constexpr int kPages = 64;
+// Number of allocated blocks kept alive before the oldest one is freed again.
+constexpr size_t kLiveBlocks = 1024;
+constexpr size_t kMinBlockSize = 3 * kTaggedSize;
+
+enum class Workload {
+  // 3 to 32 words, the bulk of the objects on a typical old space.
+  kSmallObjects,
+  // Mostly small objects, every tenth object is 512 bytes to 4KB.
+  kMixedObjects,
+};
+
+class FreeListBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State& state) override {
+    FLAG_gc_freelist_strategy = static_cast<int>(state.range(0));
+    allocator_.reset(v8::ArrayBuffer::Allocator::NewDefaultAllocator());
+    v8::Isolate::CreateParams create_params;
+    create_params.array_buffer_allocator = allocator_.get();
+    isolate_ = v8::Isolate::New(create_params);
+  }
+
+  void TearDown(const benchmark::State& state) override {
+    isolate_->Dispose();
+    isolate_ = nullptr;
+  }
+
+ protected:
+  void Run(benchmark::State& state, Workload workload);
+
+ private:
+  std::unique_ptr<v8::ArrayBuffer::Allocator> allocator_;
+  v8::Isolate* isolate_ = nullptr;
+};
+
+void FreeListBenchmark::Run(benchmark::State& state, Workload workload) {
+  v8::Isolate::Scope isolate_scope(isolate_);
+  Isolate* isolate = reinterpret_cast<Isolate*>(isolate_);
+  Heap* heap = isolate->heap();
+  // The space is not registered with the heap, so neither the allocator nor
+  // the GC ever look at its pages. Its free list is created according to
+  // --gc-freelist-strategy and only holds memory of the pages below.
+  OldSpace space(heap);
+  FreeList* free_list = space.free_list();
+  base::RandomNumberGenerator rng(42);
+  state.SetLabel(kStrategyNames[state.range(0)]);
+
+  auto next_size = [&rng, workload]() -> size_t {
+    if (workload == Workload::kMixedObjects && rng.NextInt(10) == 0) {
+      return RoundDown(512 + rng.NextInt(4 * KB - 512), kTaggedSize);
+    }
+    return (3 + rng.NextInt(30)) * kTaggedSize;
+  };
+  auto free_block = [heap, free_list](Address start, size_t size) {
+    heap->CreateFillerObjectAt(start, static_cast<int>(size),
+                               ClearRecordedSlots::kNo);
+    free_list->Free(start, size, kLinkCategory);
+  };
+
+  for (int i = 0; i < kPages; i++) {
+    Page* page = heap->memory_allocator()->AllocatePage(
+        space.AreaSize(), static_cast<PagedSpace*>(&space), NOT_EXECUTABLE);
+    if (page == nullptr) {
+      state.SkipWithError("Page allocation failed");
+      return;
+    }
+    // The space's destructor releases the pages again.
+    space.memory_chunk_list().PushBack(page);
+    Address current = page->area_start();
+    const Address end = page->area_end();
+    while (current < end) {
+      const size_t size =
+          std::min(next_size(), static_cast<size_t>(end - current));
+      free_block(current, size);
+      current += size;
+    }
+  }
+
+  std::deque<std::pair<Address, size_t>> live_blocks;
+  for (auto _ : state) {
+    USE(_);
+    size_t size = next_size();
+    size_t node_size = 0;
+    FreeSpace node =
+        free_list->Allocate(size, &node_size, AllocationOrigin::kRuntime);
+    if (node.is_null()) {
+      state.SkipWithError("Free list exhausted");
+      break;
+    }
+    // Remainders that are too small for the free list stay with the block so
+    // that no memory is lost over the run.
+    if (node_size - size < kMinBlockSize) {
+      size = node_size;
+    } else {
+      free_block(node.address() + size, node_size - size);
+    }
+    heap->CreateFillerObjectAt(node.address(), static_cast<int>(size),
+                               ClearRecordedSlots::kNo);
+    live_blocks.emplace_back(node.address(), size);
+    if (live_blocks.size() > kLiveBlocks) {
+      free_block(live_blocks.front().first, live_blocks.front().second);
+      live_blocks.pop_front();
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_DEFINE_F(FreeListBenchmark, SmallObjects)(benchmark::State& state) {
+  Run(state, Workload::kSmallObjects);
+}
+BENCHMARK_REGISTER_F(FreeListBenchmark, SmallObjects)
+    ->DenseRange(0, kNumberOfStrategies - 1);
+
+BENCHMARK_DEFINE_F(FreeListBenchmark, MixedObjects)(benchmark::State& state) {
+  Run(state, Workload::kMixedObjects);
+}
+BENCHMARK_REGISTER_F(FreeListBenchmark, MixedObjects)
+    ->DenseRange(0, kNumberOfStrategies - 1);
+
+}  // namespace
+}  // namespace internal
+}  // namespace v8
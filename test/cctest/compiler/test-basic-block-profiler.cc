@@ -3,6 +3,13 @@
 // found in the LICENSE file.
 
 #include "src/diagnostics/basic-block-profiler.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "src/builtins/profile-data-reader.h"
+#include "src/logging/log.h"
 #include "src/objects/objects-inl.h"
 #include "test/cctest/cctest.h"
 #include "test/cctest/compiler/codegen-tester.h"
@@ -136,6 +143,114 @@ TEST(ProfileLoop) {
   }
 }
 
+namespace {
+
+// The optimized code of f is only run with positive arguments, often enough
+// for the profile to mark the other branch as unlikely.
+void RunProfiledFunction(v8::Isolate* isolate) {
+  v8::Isolate::Scope isolate_scope(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+  CompileRun(
+      "function f(x) { return x < 0 ? 1 : 2; }"
+      "function g() { for (var i = 0; i < 200000; i++) f(1); }"
+      "%NeverOptimizeFunction(g);"
+      "%PrepareFunctionForOptimization(f);"
+      "f(1); f(-1);"
+      "%OptimizeFunctionOnNextCall(f);"
+      "g();");
+}
+
+// Returns the printed schedule and counts of the most recently compiled code.
+std::string LastProfile() {
+  const BasicBlockProfiler::DataList* l =
+      BasicBlockProfiler::Get()->data_list();
+  CHECK(!l->empty());
+  std::ostringstream os;
+  os << *l->back();
+  return os.str();
+}
+
+int CountOccurrences(const std::string& text, const char* pattern) {
+  int count = 0;
+  for (size_t pos = text.find(pattern); pos != std::string::npos;
+       pos = text.find(pattern, pos + 1)) {
+    count++;
+  }
+  return count;
+}
+
+}  // namespace
+
+UNINITIALIZED_TEST(ProfileJSFunctionRecordAndReplay) {
+  if (!FLAG_opt || FLAG_always_opt) return;
+  static const char kLogFile[] = "turbo-profiling-log-js.log";
+  FLAG_allow_natives_syntax = true;
+  FLAG_turbo_profiling = true;
+  FLAG_turbo_profiling_verbose = true;
+  FLAG_turbo_profiling_log_js = true;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+
+  // Record the block counts of f to a log file.
+  FLAG_log = true;
+  FLAG_logfile = kLogFile;
+  FLAG_logfile_per_isolate = false;
+  std::string recorded;
+  {
+    v8::Isolate* isolate = v8::Isolate::New(create_params);
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+    RunProfiledFunction(isolate);
+    recorded = LastProfile();
+    {
+      v8::Isolate::Scope isolate_scope(isolate);
+      std::ostringstream os;
+      BasicBlockProfiler::Get()->Print(os, i_isolate);
+    }
+    FILE* log_file = i_isolate->logger()->TearDownAndGetLogFile();
+    CHECK_NOT_NULL(log_file);
+    fclose(log_file);
+    isolate->Dispose();
+  }
+
+  // Find the name under which f was logged.
+  std::string profile_name;
+  {
+    std::ifstream log(kLogFile);
+    const std::string hash_marker =
+        std::string(ProfileDataFromFileConstants::kBuiltinHashMarker) + ",";
+    const std::string js_hash_marker =
+        hash_marker + ProfileDataFromFileConstants::kJSFunctionPrefix;
+    for (std::string line; std::getline(log, line);) {
+      if (line.rfind(js_hash_marker, 0) != 0) continue;
+      size_t start = hash_marker.size();
+      profile_name = line.substr(start, line.find(',', start) - start);
+    }
+  }
+  CHECK(!profile_name.empty());
+  CHECK_NE(std::string::npos, recorded.find(profile_name));
+
+  // Compile f again in a fresh isolate, using the recorded counts.
+  FLAG_log = false;
+  FLAG_turbo_profiling_log_file = kLogFile;
+  std::string replayed;
+  {
+    v8::Isolate* isolate = v8::Isolate::New(create_params);
+    RunProfiledFunction(isolate);
+    replayed = LastProfile();
+    isolate->Dispose();
+  }
+  std::remove(kLogFile);
+
+  // The graph is unchanged, so the profile is found under the same name and
+  // the branch that was never taken while recording is deferred.
+  CHECK_NOT_NULL(ProfileDataFromFile::TryRead(profile_name.c_str()));
+  CHECK_NE(std::string::npos, replayed.find(profile_name));
+  CHECK_GT(CountOccurrences(replayed, "(deferred)"),
+           CountOccurrences(recorded, "(deferred)"));
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
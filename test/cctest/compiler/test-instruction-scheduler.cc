@@ -2,6 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <set>
+#include <vector>
+
+#include "src/codegen/register-configuration.h"
 #include "src/compiler/backend/instruction-scheduler.h"
 #include "src/compiler/backend/instruction-selector-impl.h"
 #include "src/compiler/backend/instruction.h"
@@ -51,6 +55,7 @@ class InstructionSchedulerTester {
   }
 
   Zone* zone() { return scope_.main_zone(); }
+  InstructionSequence* sequence() { return &sequence_; }
 
  private:
   InstructionScheduler::ScheduleGraphNode* GetNode(Instruction* instr) {
@@ -107,6 +112,50 @@ TEST(DeoptInMiddleOfBasicBlock) {
   tester.EndBlock();
 }
 
+TEST(RegisterPressureLimitsLiveValues) {
+  InstructionSchedulerTester tester;
+  Zone* zone = tester.zone();
+  const int registers =
+      RegisterConfiguration::Default()->num_allocatable_general_registers();
+
+  // Each definition is used once, but as definitions are longer than uses on
+  // the critical path, they would all be scheduled first.
+  tester.StartBlock();
+  std::vector<int> vregs;
+  for (int i = 0; i < 2 * registers; ++i) {
+    vregs.push_back(tester.sequence()->NextVirtualRegister());
+    InstructionOperand output =
+        UnallocatedOperand(UnallocatedOperand::MUST_HAVE_REGISTER, vregs[i]);
+    tester.AddInstruction(
+        Instruction::New(zone, kArchNop, 1, &output, 0, nullptr, 0, nullptr));
+  }
+  for (int vreg : vregs) {
+    InstructionOperand input =
+        UnallocatedOperand(UnallocatedOperand::MUST_HAVE_REGISTER, vreg);
+    tester.AddInstruction(
+        Instruction::New(zone, kArchNop, 0, nullptr, 1, &input, 0, nullptr));
+  }
+  tester.AddTerminator(Instruction::New(zone, kArchRet));
+  tester.EndBlock();
+
+  // Check that the scheduler interleaved definitions and uses so that no more
+  // values are live than there are registers.
+  std::set<int> live;
+  size_t max_live = 0;
+  for (Instruction* instr : tester.sequence()->instructions()) {
+    for (size_t i = 0; i < instr->InputCount(); ++i) {
+      live.erase(
+          UnallocatedOperand::cast(instr->InputAt(i))->virtual_register());
+    }
+    for (size_t i = 0; i < instr->OutputCount(); ++i) {
+      live.insert(
+          UnallocatedOperand::cast(instr->OutputAt(i))->virtual_register());
+    }
+    max_live = std::max(max_live, live.size());
+  }
+  CHECK_LE(max_live, static_cast<size_t>(registers));
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -20,6 +20,8 @@
   V(CompactionPartiallyAbortedPageWithRememberedSetEntries) \
   V(CompactionSpaceDivideMultiplePages)                     \
   V(CompactionSpaceDivideSinglePage)                        \
+  V(IncrementalCompactionSkipsPageOverBudget)               \
+  V(IncrementalCompactionWithinBudget)                      \
   V(InvalidatedSlotsAfterTrimming)                          \
   V(InvalidatedSlotsAllInvalidatedRanges)                   \
   V(InvalidatedSlotsCleanupEachObject)                      \
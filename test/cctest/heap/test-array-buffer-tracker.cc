@@ -436,6 +436,73 @@ TEST(ArrayBuffer_ExternalBackingStoreSizeDecreases) {
   CHECK_EQ(0, backing_store_after - backing_store_before);
 }
 
+TEST(ArrayBuffer_ParallelFullSweepReleasesExternalMemory) {
+  if (FLAG_single_generation) return;
+  ManualGCScope manual_gc_scope;
+  FLAG_concurrent_array_buffer_sweeping = true;
+  CcTest::InitializeVM();
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  Heap* heap = reinterpret_cast<Isolate*>(isolate)->heap();
+  heap::GcAndSweep(heap, OLD_SPACE);
+
+  const size_t backing_store_before = heap->backing_store_bytes();
+  const int64_t external_memory_before = heap->external_memory();
+  const size_t kArraybufferSize = 117;
+  {
+    v8::HandleScope handle_scope(isolate);
+    // One buffer on the old list and one on the young list, so that a full
+    // sweep processes both lists.
+    Local<v8::ArrayBuffer> old_ab =
+        v8::ArrayBuffer::New(isolate, kArraybufferSize);
+    Handle<JSArrayBuffer> old_buf = v8::Utils::OpenHandle(*old_ab);
+    heap::GcAndSweep(heap, NEW_SPACE);
+    heap::GcAndSweep(heap, NEW_SPACE);
+    CHECK(!Heap::InYoungGeneration(*old_buf));
+    CHECK(IsTracked(heap, *old_buf));
+    Local<v8::ArrayBuffer> young_ab =
+        v8::ArrayBuffer::New(isolate, kArraybufferSize);
+    USE(young_ab);
+    CHECK_EQ(2 * kArraybufferSize,
+             heap->backing_store_bytes() - backing_store_before);
+  }
+
+  CcTest::CollectAllGarbage();
+  heap->array_buffer_sweeper()->EnsureFinished();
+  CHECK_EQ(backing_store_before, heap->backing_store_bytes());
+  CHECK_EQ(external_memory_before, heap->external_memory());
+}
+
+TEST(ArrayBuffer_ChunkedSweepReleasesExternalMemory) {
+  if (FLAG_single_generation) return;
+  ManualGCScope manual_gc_scope;
+  FLAG_concurrent_array_buffer_sweeping = true;
+  CcTest::InitializeVM();
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  Heap* heap = reinterpret_cast<Isolate*>(isolate)->heap();
+  heap::GcAndSweep(heap, OLD_SPACE);
+
+  const size_t backing_store_before = heap->backing_store_bytes();
+  const int64_t external_memory_before = heap->external_memory();
+  const size_t kArraybufferSize = 17;
+  // Enough buffers for the sweeper to split the list into several chunks.
+  const int kArrayBuffers = 5000;
+  {
+    v8::HandleScope handle_scope(isolate);
+    for (int i = 0; i < kArrayBuffers; i++) {
+      v8::ArrayBuffer::New(isolate, kArraybufferSize);
+    }
+    CHECK_EQ(kArrayBuffers * kArraybufferSize,
+             heap->backing_store_bytes() - backing_store_before);
+  }
+
+  CcTest::CollectAllGarbage();
+  heap->array_buffer_sweeper()->EnsureFinished();
+  CHECK_EQ(backing_store_before, heap->backing_store_bytes());
+  CHECK_EQ(external_memory_before, heap->external_memory());
+}
+
 TEST(ArrayBuffer_ExternalBackingStoreSizeIncreasesMarkCompact) {
   if (FLAG_never_compact) return;
   ManualGCScope manual_gc_scope;
@@ -491,6 +491,152 @@ HEAP_TEST(CompactionPartiallyAbortedPageWithRememberedSetEntries) {
   heap->RemoveNearHeapLimitCallback(reset_oom, 0u);
 }
 
+HEAP_TEST(IncrementalCompactionWithinBudget) {
+  if (FLAG_never_compact) return;
+  // Test that --incremental-compaction evacuates fragmented pages over several
+  // GCs, bounded by --compaction-pause-budget.
+  ManualGCScope manual_gc_scope;
+  FLAG_incremental_compaction = true;
+
+  const int kPages = 4;
+  const int objects_per_page = 20;
+  const int object_size = GetObjectSize(objects_per_page);
+
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  HandleScope scope1(isolate);
+
+  heap::SealCurrentObjects(heap);
+
+  // Keeps one object alive on each of the pages.
+  Handle<FixedArray> live_objects = isolate->factory()->NewFixedArray(kPages);
+  Page* pages[kPages];
+  for (int i = 0; i < kPages; i++) {
+    HandleScope scope2(isolate);
+    CHECK(heap->old_space()->Expand());
+    auto page_handles = heap::CreatePadding(
+        heap,
+        static_cast<int>(MemoryChunkLayout::AllocatableMemoryInDataPage()),
+        AllocationType::kOld, object_size);
+    pages[i] = Page::FromHeapObject(*page_handles.front());
+    CheckAllObjectsOnPage(page_handles, pages[i]);
+    live_objects->set(i, *page_handles.front());
+  }
+  // Sweeps the pages so that their allocated bytes reflect the live object.
+  CcTest::CollectAllGarbage();
+  heap->mark_compact_collector()->EnsureSweepingCompleted();
+
+  auto count_evacuated = [&live_objects, &pages]() {
+    int evacuated = 0;
+    for (int i = 0; i < kPages; i++) {
+      HeapObject object = HeapObject::cast(live_objects->get(i));
+      if (Page::FromHeapObject(object) != pages[i]) evacuated++;
+    }
+    return evacuated;
+  };
+  auto collect_with_budget = [heap, object_size]() {
+    // At 1 MB/ms the budget covers the live objects of two of the pages.
+    const size_t kCompactionSpeed = 1 * MB;
+    heap->tracer()->ResetForTesting();
+    heap->tracer()->AddCompactionEvent(1, kCompactionSpeed);
+    FLAG_compaction_pause_budget = 2.5 * object_size / kCompactionSpeed;
+    CcTest::CollectAllGarbage();
+    heap->mark_compact_collector()->EnsureSweepingCompleted();
+  };
+
+  collect_with_budget();
+  CHECK_EQ(2, count_evacuated());
+  // The remaining pages are evacuated by the following GCs.
+  for (int gc = 0; gc < kPages && count_evacuated() < kPages; gc++) {
+    collect_with_budget();
+  }
+  CHECK_EQ(kPages, count_evacuated());
+}
+
+HEAP_TEST(IncrementalCompactionSkipsPageOverBudget) {
+  if (FLAG_never_compact) return;
+  // Test that a fragmented page whose live bytes alone exceed the budget does
+  // not stop --incremental-compaction at the cursor.
+  ManualGCScope manual_gc_scope;
+  FLAG_incremental_compaction = true;
+
+  // One dense page followed by sparse ones.
+  const int kPages = 5;
+  const int objects_per_page = 20;
+  // Still fragmented enough to be considered, but over the budget below.
+  const int kDenseLiveObjects = 5;
+  const int object_size = GetObjectSize(objects_per_page);
+
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  HandleScope scope1(isolate);
+
+  heap::SealCurrentObjects(heap);
+
+  Handle<FixedArray> live_objects = isolate->factory()->NewFixedArray(kPages);
+  Handle<FixedArray> dense_objects =
+      isolate->factory()->NewFixedArray(kDenseLiveObjects);
+  std::vector<Page*> pages;
+  {
+    HandleScope scope2(isolate);
+    std::vector<std::vector<Handle<FixedArray>>> page_handles;
+    for (int i = 0; i < kPages; i++) {
+      CHECK(heap->old_space()->Expand());
+      page_handles.push_back(heap::CreatePadding(
+          heap,
+          static_cast<int>(MemoryChunkLayout::AllocatableMemoryInDataPage()),
+          AllocationType::kOld, object_size));
+      CheckAllObjectsOnPage(page_handles.back(),
+                            Page::FromHeapObject(*page_handles.back().front()));
+    }
+    // The first GC starts at the lowest address, so the dense page goes there.
+    std::sort(page_handles.begin(), page_handles.end(),
+              [](const std::vector<Handle<FixedArray>>& a,
+                 const std::vector<Handle<FixedArray>>& b) {
+                return a.front()->address() < b.front()->address();
+              });
+    for (int i = 0; i < kPages; i++) {
+      pages.push_back(Page::FromHeapObject(*page_handles[i].front()));
+      live_objects->set(i, *page_handles[i].front());
+    }
+    for (int i = 1; i < kDenseLiveObjects; i++) {
+      dense_objects->set(i, *page_handles[0][i]);
+    }
+  }
+  CcTest::CollectAllGarbage();
+  heap->mark_compact_collector()->EnsureSweepingCompleted();
+
+  auto is_evacuated = [&live_objects, &pages](int i) {
+    HeapObject object = HeapObject::cast(live_objects->get(i));
+    return Page::FromHeapObject(object) != pages[i];
+  };
+  auto collect_with_budget = [heap, object_size]() {
+    // At 1 MB/ms the budget covers the live objects of two sparse pages.
+    const size_t kCompactionSpeed = 1 * MB;
+    heap->tracer()->ResetForTesting();
+    heap->tracer()->AddCompactionEvent(1, kCompactionSpeed);
+    FLAG_compaction_pause_budget = 2.5 * object_size / kCompactionSpeed;
+    CcTest::CollectAllGarbage();
+    heap->mark_compact_collector()->EnsureSweepingCompleted();
+  };
+
+  auto count_sparse_evacuated = [&is_evacuated]() {
+    int evacuated = 0;
+    for (int i = 1; i < kPages; i++) {
+      if (is_evacuated(i)) evacuated++;
+    }
+    return evacuated;
+  };
+  for (int gc = 0; gc < 2 * kPages && count_sparse_evacuated() < kPages - 1;
+       gc++) {
+    collect_with_budget();
+    CHECK(!is_evacuated(0));
+  }
+  CHECK_EQ(kPages - 1, count_sparse_evacuated());
+}
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
@@ -51,9 +51,11 @@
 #include "src/heap/memory-chunk.h"
 #include "src/heap/memory-reducer.h"
 #include "src/heap/parked-scope.h"
+#include "src/heap/pretenuring-sampler.h"
 #include "src/heap/remembered-set-inl.h"
 #include "src/heap/safepoint.h"
 #include "src/ic/ic.h"
+#include "src/interpreter/bytecode-array-iterator.h"
 #include "src/numbers/hash-seed-inl.h"
 #include "src/objects/elements.h"
 #include "src/objects/field-type.h"
@@ -2008,6 +2010,84 @@ TEST(TestSizeOfObjectsVsHeapObjectIteratorPrecision) {
   }
 }
 
+TEST(UncommitFromSpaceAfterGC) {
+  // Heap::ReduceNewSpaceSize() returns early in predictable mode.
+  if (FLAG_single_generation || FLAG_predictable) return;
+  FLAG_uncommit_from_space = true;
+  ManualGCScope manual_gc_scope;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = CcTest::heap();
+  NewSpace* new_space = heap->new_space();
+  HandleScope scope(isolate);
+
+  Handle<FixedArray> survivor = isolate->factory()->NewFixedArray(16);
+  CHECK(Heap::InYoungGeneration(*survivor));
+  CcTest::CollectGarbage(NEW_SPACE);
+  // Only the to-space holding the survivors stays committed.
+  CHECK(!new_space->IsFromSpaceCommitted());
+  CHECK_EQ(new_space->to_space().CommittedMemory(),
+           new_space->CommittedMemory());
+
+  // The next scavenge recommits the from-space before copying.
+  CcTest::CollectGarbage(NEW_SPACE);
+  CHECK(!new_space->IsFromSpaceCommitted());
+  CHECK_EQ(16, survivor->length());
+
+  CcTest::CollectAllGarbage();
+  CHECK(!new_space->IsFromSpaceCommitted());
+  CHECK_EQ(16, survivor->length());
+}
+
+TEST(HeapObjectStatisticsDelta) {
+  ManualGCScope manual_gc_scope;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  v8::Isolate* v8_isolate = CcTest::isolate();
+  Heap* heap = CcTest::heap();
+  HandleScope scope(isolate);
+  std::vector<v8::HeapObjectStatisticsDelta> stats;
+
+  v8_isolate->SetHeapObjectStatisticsSamplingInterval(1);
+  CHECK(!v8_isolate->GetHeapObjectStatisticsDelta(&stats));
+  CcTest::CollectAllGarbage();
+  int gc_count = 0;
+  CHECK(v8_isolate->GetHeapObjectStatisticsDelta(&stats, &gc_count));
+  CHECK(!stats.empty());
+  CHECK_EQ(heap->ms_count(), gc_count);
+  // A sample is only reported once.
+  CHECK(!v8_isolate->GetHeapObjectStatisticsDelta(&stats));
+
+  const int kNumbers = 1000;
+  Handle<FixedArray> holder = isolate->factory()->NewFixedArray(kNumbers);
+  for (int i = 0; i < kNumbers; i++) {
+    holder->set(i, *isolate->factory()->NewHeapNumber(i + 0.5));
+  }
+  CcTest::CollectAllGarbage();
+  stats.clear();
+  CHECK(v8_isolate->GetHeapObjectStatisticsDelta(&stats));
+  bool found = false;
+  for (const auto& entry : stats) {
+    if (strcmp(entry.object_type, "HEAP_NUMBER_TYPE") != 0) continue;
+    found = true;
+    CHECK_GE(entry.object_count_delta, kNumbers);
+    CHECK_GE(entry.object_size_delta, kNumbers * HeapNumber::kSize);
+    CHECK_GE(entry.object_count, static_cast<size_t>(kNumbers));
+  }
+  CHECK(found);
+
+  v8_isolate->SetHeapObjectStatisticsSamplingInterval(2);
+  CcTest::CollectAllGarbage();
+  CcTest::CollectAllGarbage();
+  CHECK(v8_isolate->GetHeapObjectStatisticsDelta(&stats, &gc_count));
+  CHECK_EQ(0, gc_count % 2);
+  CHECK(!v8_isolate->GetHeapObjectStatisticsDelta(&stats));
+
+  v8_isolate->SetHeapObjectStatisticsSamplingInterval(0);
+  CcTest::CollectAllGarbage();
+  CHECK(!v8_isolate->GetHeapObjectStatisticsDelta(&stats));
+}
+
 TEST(GrowAndShrinkNewSpace) {
   if (FLAG_single_generation) return;
   // Avoid shrinking new space in GC epilogue. This can happen if allocation
@@ -7383,6 +7463,79 @@ TEST(LongTaskStatsYoung) {
       v8::metrics::LongTaskStats::Get(isolate).gc_young_wall_clock_duration_us);
 }
 
+namespace {
+
+bool CreateClosureSiteKey(Isolate* isolate, const char* name, uint64_t* key) {
+  Handle<JSFunction> function = Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*CompileRun(name)));
+  Handle<BytecodeArray> bytecode(
+      function->shared().GetBytecodeArray(isolate), isolate);
+  for (interpreter::BytecodeArrayIterator it(bytecode); !it.done();
+       it.Advance()) {
+    if (it.current_bytecode() == interpreter::Bytecode::kCreateClosure) {
+      *key = PretenuringSampler::SiteKey(function->shared().Hash(),
+                                         it.current_offset());
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+UNINITIALIZED_TEST(SamplingPretenuringOfRetainedClosures) {
+  if (FLAG_single_generation || V8_ENABLE_THIRD_PARTY_HEAP_BOOL) return;
+  FLAG_sampling_pretenuring = true;
+  FLAG_sampling_pretenuring_interval = 256;
+  // Samples are only taken in unoptimized frames.
+  FLAG_opt = false;
+  FLAG_always_opt = false;
+  FLAG_allow_natives_syntax = true;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::New(isolate)->Enter();
+    CompileRun(
+        "var retained = [];"
+        "function retain() {"
+        "  for (var i = 0; i < 1000; i++) retained.push(function() {});"
+        "}"
+        "function drop() {"
+        "  for (var i = 0; i < 1000; i++) { var f = function() {}; }"
+        "}");
+    for (int i = 0; i < 10; i++) {
+      CompileRun("retain(); drop();");
+      CcTest::CollectGarbage(NEW_SPACE, i_isolate);
+    }
+
+    PretenuringSampler* sampler = i_isolate->heap()->pretenuring_sampler();
+    CHECK_NOT_NULL(sampler);
+    uint64_t retained_site;
+    uint64_t dropped_site;
+    CHECK(CreateClosureSiteKey(i_isolate, "retain", &retained_site));
+    CHECK(CreateClosureSiteKey(i_isolate, "drop", &dropped_site));
+    CHECK_EQ(AllocationType::kOld, sampler->GetAllocationType(retained_site));
+    CHECK_EQ(AllocationType::kYoung, sampler->GetAllocationType(dropped_site));
+    CHECK_LE(1u, sampler->pretenured_sites());
+
+    // Optimized code allocates the closures of the pretenured site in old
+    // space directly.
+    CHECK_EQ(0u, sampler->redirected_allocations());
+    FLAG_opt = true;
+    CompileRun(
+        "%PrepareFunctionForOptimization(retain);"
+        "retain();"
+        "%OptimizeFunctionOnNextCall(retain);"
+        "retain();");
+    CHECK_LE(1u, sampler->redirected_allocations());
+  }
+  isolate->Dispose();
+}
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
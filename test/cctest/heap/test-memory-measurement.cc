@@ -285,6 +285,63 @@ TEST(PartiallyInitializedContext) {
   isolate->RegisterDeserializerFinished();
 }
 
+namespace {
+struct BudgetExceeded {
+  int calls = 0;
+  size_t size = 0;
+};
+
+void OnContextMemoryBudgetExceeded(v8::Isolate* isolate,
+                                   v8::Local<v8::Context> context,
+                                   size_t size_in_bytes, size_t budget_in_bytes,
+                                   void* data) {
+  CHECK_GT(size_in_bytes, budget_in_bytes);
+  BudgetExceeded* exceeded = static_cast<BudgetExceeded*>(data);
+  exceeded->calls++;
+  exceeded->size = size_in_bytes;
+}
+}  // namespace
+
+TEST(ContextMemoryBudget) {
+  LocalContext env;
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  const int kObjects = 10000;
+  CompileRun(
+      "var retained = [];"
+      "for (let i = 0; i < 10000; i++) retained.push({x: i});");
+
+  CHECK_EQ(0, isolate->GetContextMemoryUsage(env.local()));
+  BudgetExceeded exceeded;
+  isolate->SetContextMemoryBudget(env.local(), 1024,
+                                  OnContextMemoryBudgetExceeded, &exceeded);
+  // Accounting is folded into regular full GCs.
+  CcTest::CollectAllGarbage();
+  size_t usage = isolate->GetContextMemoryUsage(env.local());
+  CHECK_GT(usage, kObjects * 2 * kTaggedSize);
+
+  // The callback is invoked from a task.
+  CHECK_EQ(0, exceeded.calls);
+  while (v8::platform::PumpMessageLoop(v8::internal::V8::GetCurrentPlatform(),
+                                       isolate)) {
+  }
+  CHECK_EQ(1, exceeded.calls);
+  CHECK_EQ(usage, exceeded.size);
+
+  // No callback within budget.
+  isolate->SetContextMemoryBudget(env.local(), usage * 2,
+                                  OnContextMemoryBudgetExceeded, &exceeded);
+  CcTest::CollectAllGarbage();
+  while (v8::platform::PumpMessageLoop(v8::internal::V8::GetCurrentPlatform(),
+                                       isolate)) {
+  }
+  CHECK_EQ(1, exceeded.calls);
+  CHECK_GT(isolate->GetContextMemoryUsage(env.local()), 0);
+
+  isolate->ClearContextMemoryBudget(env.local());
+  CHECK_EQ(0, isolate->GetContextMemoryUsage(env.local()));
+}
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
@@ -37,6 +37,7 @@
 #include "src/api/api-inl.h"
 #include "src/codegen/compilation-cache.h"
 #include "src/codegen/compiler.h"
+#include "src/codegen/optimization-hints.h"
 #include "src/codegen/script-details.h"
 #include "src/diagnostics/disasm.h"
 #include "src/heap/factory.h"
@@ -46,6 +47,7 @@
 #include "src/objects/allocation-site-inl.h"
 #include "src/objects/objects-inl.h"
 #include "src/objects/shared-function-info.h"
+#include "src/utils/utils.h"
 #include "test/cctest/cctest.h"
 
 namespace v8 {
@@ -828,6 +830,81 @@ TEST(InvocationCount) {
   CHECK_EQ(4, foo->feedback_vector().invocation_count());
 }
 
+TEST(OptimizationHints) {
+  if (FLAG_lite_mode || !FLAG_opt) return;
+  const char* kHintsFile = "optimization-hints-test.txt";
+  const char* kTraceFile = "optimization-hints-test.trace";
+  base::OS::Remove(kHintsFile);
+  base::OS::Remove(kTraceFile);
+  FLAG_optimization_hints_file = kHintsFile;
+  FLAG_allow_natives_syntax = true;
+  FLAG_always_opt = false;
+  FLAG_sparkplug = false;
+  // Only a hint can trigger optimization on the first profiler tick.
+  FLAG_ticks_before_optimization = 100;
+  FLAG_max_bytecode_size_for_early_opt = 0;
+  FLAG_trace_opt = true;
+  FLAG_redirect_code_traces = true;
+  FLAG_redirect_code_traces_to = kTraceFile;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  // Passing |tick| runs the profiler on the frame of add().
+  const char* kFunction =
+      "function add(o, tick) {"
+      "  if (tick) %BytecodeBudgetInterruptFromBytecode(add);"
+      "  return o.x + 1;"
+      "};"
+      "%PrepareFunctionForOptimization(add);";
+  const char* kWarmUp = "add({x: 1}); add({x: 2});";
+
+  {
+    LocalContext env;
+    CompileRun(kFunction);
+    CompileRun(kWarmUp);
+    Handle<JSFunction> add = Handle<JSFunction>::cast(GetGlobalProperty("add"));
+    CHECK(!OptimizationHints::ShouldOptimizeEarly(*add));
+    CompileRun("%OptimizeFunctionOnNextCall(add); add({x: 3});");
+    CHECK(add->HasAttachedOptimizedCode());
+    CHECK(OptimizationHints::ShouldOptimizeEarly(*add));
+  }
+
+  OptimizationHints::Flush();
+  // Start over from the file, as a new process would.
+  OptimizationHints::ResetForTesting();
+
+  {
+    // A new copy of the same source is optimized early once its feedback has
+    // the shape recorded above.
+    LocalContext env;
+    CompileRun(kFunction);
+    Handle<JSFunction> add = Handle<JSFunction>::cast(GetGlobalProperty("add"));
+    CHECK(!OptimizationHints::ShouldOptimizeEarly(*add));
+    CompileRun(kWarmUp);
+    CHECK(OptimizationHints::ShouldOptimizeEarly(*add));
+    CHECK_EQ(0, add->feedback_vector().profiler_ticks());
+    CompileRun("add({x: 3}, true);");
+    CHECK_EQ(1, add->feedback_vector().profiler_ticks());
+    CHECK(add->IsMarkedForOptimization() ||
+          add->IsMarkedForConcurrentOptimization());
+
+    CompileRun(
+        "function sub(o) { return o.x - 1; };"
+        "%PrepareFunctionForOptimization(sub);"
+        "sub({x: 1}); sub({x: 2});");
+    Handle<JSFunction> sub = Handle<JSFunction>::cast(GetGlobalProperty("sub"));
+    CHECK(!OptimizationHints::ShouldOptimizeEarly(*sub));
+  }
+
+  bool exists = false;
+  std::string trace = ReadFile(kTraceFile, &exists);
+  CHECK(exists);
+  CHECK_NE(std::string::npos,
+           trace.find("for optimized recompilation, reason: "
+                      "optimization hint"));
+  base::OS::Remove(kHintsFile);
+  base::OS::Remove(kTraceFile);
+}
+
 TEST(ShallowEagerCompilation) {
   i::FLAG_always_opt = false;
   CcTest::InitializeVM();
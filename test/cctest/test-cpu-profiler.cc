@@ -293,6 +293,77 @@ TEST(TickEvents) {
   CHECK(top_down_ddd_children->empty());
 }
 
+TEST(TickEventsParallelSymbolization) {
+  TestSetup test_setup;
+  FlagScope<bool> parallel_symbolization(
+      &i::FLAG_cpu_profiler_parallel_symbolization, true);
+  LocalContext env;
+  i::Isolate* isolate = CcTest::i_isolate();
+  i::HandleScope scope(isolate);
+
+  i::Handle<i::AbstractCode> frame1_code(CreateCode(isolate, &env), isolate);
+  i::Handle<i::AbstractCode> frame2_code(CreateCode(isolate, &env), isolate);
+
+  CodeEntryStorage storage;
+  CpuProfilesCollection* profiles = new CpuProfilesCollection(isolate);
+  ProfilerCodeObserver* code_observer =
+      new ProfilerCodeObserver(isolate, storage);
+  Symbolizer* symbolizer = new Symbolizer(code_observer->code_map());
+  // Use a long sampling period so that the sampler thread does not add ticks
+  // while the test fills the ticks buffer.
+  SamplingEventsProcessor* processor = new SamplingEventsProcessor(
+      CcTest::i_isolate(), symbolizer, code_observer, profiles,
+      v8::base::TimeDelta::FromSeconds(100), true);
+  CpuProfiler profiler(isolate, kDebugNaming, kLazyLogging, profiles,
+                       symbolizer, processor, code_observer);
+  profiles->StartProfiling("");
+  CHECK(processor->Start());
+  ProfilerListener profiler_listener(isolate, processor,
+                                     *code_observer->code_entries(),
+                                     *code_observer->weak_code_registry());
+  isolate->logger()->AddCodeEventListener(&profiler_listener);
+
+  profiler_listener.CodeCreateEvent(i::Logger::BUILTIN_TAG, frame1_code, "bbb");
+  profiler_listener.CodeCreateEvent(i::Logger::STUB_TAG, frame2_code, "ccc");
+
+  // Enough ticks for several batches that are symbolized on worker threads,
+  // but fewer than fit into the ticks buffer.
+  const int kTicks = 200;
+  for (int i = 0; i < kTicks; i++) {
+    TickSample* sample = processor->StartTickSample();
+    CHECK_NOT_NULL(sample);
+    sample->pc = reinterpret_cast<void*>(frame2_code->raw_instruction_start());
+    sample->tos = sample->pc;
+    sample->stack[0] = reinterpret_cast<void*>(
+        frame1_code->raw_instruction_start() +
+        frame1_code->raw_instruction_size() / 2);
+    sample->frames_count = 1;
+    sample->timestamp = base::TimeTicks::HighResolutionNow();
+    processor->FinishTickSample();
+  }
+
+  isolate->logger()->RemoveCodeEventListener(&profiler_listener);
+  processor->StopSynchronously();
+  CpuProfile* profile = profiles->StopProfiling("");
+  CHECK(profile);
+  CHECK_EQ(kTicks, profile->samples_count());
+
+  // Samples are added in the order in which they were taken.
+  for (int i = 1; i < kTicks; i++) {
+    CHECK_LE(profile->sample(i - 1).timestamp, profile->sample(i).timestamp);
+  }
+
+  const std::vector<ProfileNode*>* top_down_root_children =
+      profile->top_down()->root()->children();
+  CHECK_EQ(1, top_down_root_children->size());
+  ProfileNode* bbb = top_down_root_children->back();
+  CHECK_EQ(0, strcmp("bbb", bbb->entry()->name()));
+  CHECK_EQ(1, bbb->children()->size());
+  ProfileNode* ccc = bbb->children()->back();
+  CHECK_EQ(0, strcmp("ccc", ccc->entry()->name()));
+  CHECK_EQ(kTicks, ccc->self_ticks());
+}
+
 TEST(CodeMapClearedBetweenProfilesWithLazyLogging) {
   TestSetup test_setup;
   LocalContext env;
@@ -279,6 +279,60 @@ TEST(HeapSnapshot) {
   CHECK(det.has_C2);
 }
 
+TEST(HeapSnapshotParallelExtraction) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  // Enough objects to span several extraction batches.
+  CompileRun(
+      "var shared = {};\n"
+      "var holder = [];\n"
+      "for (var i = 0; i < 10000; i++) holder.push({s: shared, n: i});");
+
+  i::FLAG_heap_snapshot_parallel_extraction = false;
+  const v8::HeapSnapshot* sequential = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(sequential));
+  i::FLAG_heap_snapshot_parallel_extraction = true;
+  const v8::HeapSnapshot* parallel = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(parallel));
+
+  const v8::HeapGraphNode* sequential_holder =
+      GetProperty(env->GetIsolate(), GetGlobalObject(sequential),
+                  v8::HeapGraphEdge::kProperty, "holder");
+  const v8::HeapGraphNode* parallel_holder =
+      GetProperty(env->GetIsolate(), GetGlobalObject(parallel),
+                  v8::HeapGraphEdge::kProperty, "holder");
+  CHECK(sequential_holder);
+  CHECK(parallel_holder);
+  CHECK_EQ(sequential_holder->GetId(), parallel_holder->GetId());
+
+  // The holder and its backing store have the same edges, including the
+  // hidden ones, in the same order.
+  const v8::HeapGraphNode* sequential_elements =
+      GetProperty(env->GetIsolate(), sequential_holder,
+                  v8::HeapGraphEdge::kInternal, "elements");
+  const v8::HeapGraphNode* parallel_elements =
+      GetProperty(env->GetIsolate(), parallel_holder,
+                  v8::HeapGraphEdge::kInternal, "elements");
+  CHECK(sequential_elements);
+  CHECK(parallel_elements);
+  CHECK_LE(10000, parallel_elements->GetChildrenCount());
+  const v8::HeapGraphNode* nodes[][2] = {
+      {sequential_holder, parallel_holder},
+      {sequential_elements, parallel_elements}};
+  for (const auto& pair : nodes) {
+    CHECK_EQ(pair[0]->GetChildrenCount(), pair[1]->GetChildrenCount());
+    for (int i = 0; i < pair[0]->GetChildrenCount(); i++) {
+      const v8::HeapGraphEdge* sequential_edge = pair[0]->GetChild(i);
+      const v8::HeapGraphEdge* parallel_edge = pair[1]->GetChild(i);
+      CHECK_EQ(sequential_edge->GetType(), parallel_edge->GetType());
+      CHECK_EQ(sequential_edge->GetToNode()->GetId(),
+               parallel_edge->GetToNode()->GetId());
+    }
+  }
+}
+
 TEST(HeapSnapshotLocations) {
   LocalContext env;
   v8::HandleScope scope(env->GetIsolate());
@@ -1230,6 +1284,45 @@ TEST(HeapSnapshotJSONSerializationAborting) {
   CHECK_EQ(0, stream.eos_signaled());
 }
 
+TEST(HeapSnapshotBinarySerialization) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  CompileRun(
+      "function A(s) { this.s = s; }\n"
+      "var a = new A(\"String \\n\\u0081\\u0801\");");
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+
+  TestJSONStream json_stream;
+  snapshot->Serialize(&json_stream, v8::HeapSnapshot::kJSON);
+  v8::base::ScopedVector<char> json(json_stream.size());
+  json_stream.WriteTo(json);
+
+  TestJSONStream binary_stream;
+  snapshot->Serialize(&binary_stream, v8::HeapSnapshot::kBinary);
+  CHECK_EQ(1, binary_stream.eos_signaled());
+  CHECK_LT(binary_stream.size(), json_stream.size());
+  v8::base::ScopedVector<char> binary(binary_stream.size());
+  binary_stream.WriteTo(binary);
+
+  // The converted snapshot matches the JSON serialization byte for byte.
+  TestJSONStream converted_stream;
+  CHECK(v8::HeapSnapshot::ConvertBinaryToJSON(
+      binary.begin(), binary.length(), &converted_stream));
+  CHECK_EQ(1, converted_stream.eos_signaled());
+  CHECK_EQ(json_stream.size(), converted_stream.size());
+  v8::base::ScopedVector<char> converted(converted_stream.size());
+  converted_stream.WriteTo(converted);
+  CHECK_EQ(0, memcmp(json.begin(), converted.begin(), json.length()));
+
+  // Truncated input is rejected.
+  TestJSONStream truncated_stream;
+  CHECK(!v8::HeapSnapshot::ConvertBinaryToJSON(
+      binary.begin(), binary.length() - 1, &truncated_stream));
+  CHECK_EQ(0, truncated_stream.eos_signaled());
+}
+
 namespace {
 
 class TestStatsStream : public v8::OutputStream {
@@ -4090,6 +4183,53 @@ TEST(SamplingHeapProfilerSampleDuringDeopt) {
   heap_profiler->StopSamplingHeapProfiler();
 }
 
+static const v8::AllocationCallsiteStats* FindAllocationCallsiteStats(
+    const std::vector<v8::AllocationCallsiteStats>& stats, const char* name) {
+  for (const auto& entry : stats) {
+    if (strcmp(entry.function_name, name) == 0) return &entry;
+  }
+  return nullptr;
+}
+
+TEST(AllocationCallsiteSampling) {
+  v8::HandleScope scope(CcTest::isolate());
+  LocalContext env;
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  // Turn off always_opt. Inlining would attribute allocations to foo().
+  v8::internal::FLAG_always_opt = false;
+
+  // Suppress randomness to avoid flakiness in tests.
+  v8::internal::FLAG_sampling_heap_profiler_suppress_randomness = true;
+
+  std::vector<v8::AllocationCallsiteStats> stats;
+  CHECK(!heap_profiler->GetAllocationCallsiteStats(&stats));
+
+  CHECK(heap_profiler->StartAllocationCallsiteSampling(1024, 2));
+  CHECK(!heap_profiler->StartAllocationCallsiteSampling(1024, 2));
+  CompileRun(simple_sampling_heap_profiler_script);
+  // Everything allocated by bar() is retained by A and survives.
+  CcTest::CollectAllGarbage();
+  CcTest::CollectAllGarbage();
+
+  CHECK(heap_profiler->GetAllocationCallsiteStats(&stats));
+  const v8::AllocationCallsiteStats* bar =
+      FindAllocationCallsiteStats(stats, "bar");
+  CHECK_NOT_NULL(bar);
+  CHECK_GT(bar->allocation_samples, 0u);
+  CHECK_GE(bar->allocation_bytes, bar->allocation_samples * 1024);
+  CHECK_GT(bar->surviving_samples, 0u);
+  CHECK_LE(bar->surviving_samples, bar->allocation_samples);
+
+  // Statistics are reported as deltas.
+  stats.clear();
+  CHECK(heap_profiler->GetAllocationCallsiteStats(&stats));
+  CHECK_NULL(FindAllocationCallsiteStats(stats, "bar"));
+
+  heap_profiler->StopAllocationCallsiteSampling();
+  CHECK(!heap_profiler->GetAllocationCallsiteStats(&stats));
+}
+
 TEST(WeakReference) {
   v8::Isolate* isolate = CcTest::isolate();
   i::Isolate* i_isolate = CcTest::i_isolate();
@@ -0,0 +1,98 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Loop kernels with independent arithmetic chains, whose speed depends on
+// how well the latencies of floating-point operations, integer
+// multiplications and divisions are hidden.
+
+const N = 256;
+const a = new Float64Array(N * N);
+const b = new Float64Array(N * N);
+const c = new Float64Array(N * N);
+const v = new Float64Array(4096);
+const w = new Float64Array(4096);
+const ints = new Int32Array(4096);
+
+function Setup() {
+  for (let i = 0; i < a.length; i++) {
+    a[i] = (i % 17) * 0.25;
+    b[i] = (i % 13) * 0.5;
+  }
+  for (let i = 0; i < v.length; i++) {
+    v[i] = i * 0.001;
+    w[i] = 1 - i * 0.0005;
+    ints[i] = (i * 2654435761) | 0;
+  }
+}
+
+function DotProduct() {
+  let sum0 = 0, sum1 = 0;
+  for (let i = 0; i < v.length; i += 2) {
+    sum0 += v[i] * w[i];
+    sum1 += v[i + 1] * w[i + 1];
+  }
+  return sum0 + sum1;
+}
+
+function MatrixMultiply() {
+  const n = 64;
+  for (let i = 0; i < n; i++) {
+    for (let j = 0; j < n; j++) {
+      let sum = 0;
+      for (let k = 0; k < n; k++) {
+        sum += a[i * N + k] * b[k * N + j];
+      }
+      c[i * N + j] = sum;
+    }
+  }
+  return c[0];
+}
+
+function Polynomial() {
+  let result = 0;
+  for (let i = 0; i < v.length; i++) {
+    const x = v[i];
+    const x2 = x * x;
+    const x4 = x2 * x2;
+    result += (1.5 + 2.5 * x) + (3.5 + 4.5 * x) * x2 +
+              (5.5 + 6.5 * x) * x4 + (7.5 + 8.5 * x) * x4 * x2;
+  }
+  return result;
+}
+
+function Normalize() {
+  let result = 0;
+  for (let i = 0; i < v.length - 1; i++) {
+    const length = Math.sqrt(v[i] * v[i] + w[i] * w[i] + 1);
+    result += v[i] / length + w[i + 1] / (length + 1);
+  }
+  return result;
+}
+
+function IntegerHash() {
+  let h = 0;
+  for (let i = 0; i < ints.length; i++) {
+    let k = Math.imul(ints[i], 0xcc9e2d51);
+    k = Math.imul((k << 15) | (k >>> 17), 0x1b873593);
+    h ^= k;
+    h = (Math.imul((h << 13) | (h >>> 19), 5) + 0xe6546b64) | 0;
+  }
+  return h;
+}
+
+function IntegerDivision() {
+  let sum = 0;
+  for (let i = 1; i < ints.length; i++) {
+    const x = ints[i] & 0xffff;
+    sum = (sum + ((x / ((i & 7) + 1)) | 0) + x % ((i & 15) + 3)) | 0;
+  }
+  return sum;
+}
+
+createSuite('DotProduct', 1000, DotProduct, Setup);
+createSuite('MatrixMultiply', 1000, MatrixMultiply, Setup);
+createSuite('Polynomial', 1000, Polynomial, Setup);
+createSuite('Normalize', 1000, Normalize, Setup);
+createSuite('IntegerHash', 1000, IntegerHash, Setup);
+createSuite('IntegerDivision', 1000, IntegerDivision, Setup);
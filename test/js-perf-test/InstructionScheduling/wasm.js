@@ -0,0 +1,58 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A wasm module exporting its memory and
+//   dot(n: i32, b: i32) -> f64
+// which returns the dot product of the n doubles at address 0 and the n
+// doubles at address b.
+const kDotModuleBytes = new Uint8Array([
+  0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,  // Header.
+  // Type section: (i32, i32) -> f64.
+  0x01, 0x07, 0x01, 0x60, 0x02, 0x7f, 0x7f, 0x01, 0x7c,
+  // Function section.
+  0x03, 0x02, 0x01, 0x00,
+  // Memory section: one page.
+  0x05, 0x03, 0x01, 0x00, 0x01,
+  // Export section: "dot" and "mem".
+  0x07, 0x0d, 0x02,
+  0x03, 0x64, 0x6f, 0x74, 0x00, 0x00,
+  0x03, 0x6d, 0x65, 0x6d, 0x02, 0x00,
+  // Code section.
+  0x0a, 0x3a, 0x01, 0x38,
+  0x02, 0x01, 0x7f, 0x01, 0x7c,              // Locals: i32 i, f64 sum.
+  0x20, 0x00, 0x41, 0x03, 0x74, 0x21, 0x00,  // n <<= 3
+  0x02, 0x40,                                // block
+  0x03, 0x40,                                // loop
+  0x20, 0x02, 0x20, 0x00, 0x4f, 0x0d, 0x01,  // br_if (i >= n) 1
+  0x20, 0x03,                                // sum
+  0x20, 0x02, 0x2b, 0x03, 0x00,              // f64.load [i]
+  0x20, 0x02, 0x20, 0x01, 0x6a,              // i + b
+  0x2b, 0x03, 0x00,                          // f64.load [i + b]
+  0xa2, 0xa0, 0x21, 0x03,                    // sum += product
+  0x20, 0x02, 0x41, 0x08, 0x6a, 0x21, 0x02,  // i += 8
+  0x0c, 0x00,                                // br 0
+  0x0b,                                      // end loop
+  0x0b,                                      // end block
+  0x20, 0x03,                                // return sum
+  0x0b,
+]);
+
+const kWasmElements = 2048;
+let wasmDot;
+
+function WasmSetup() {
+  const instance = new WebAssembly.Instance(
+      new WebAssembly.Module(kDotModuleBytes));
+  const memory = new Float64Array(instance.exports.mem.buffer);
+  for (let i = 0; i < 2 * kWasmElements; i++) {
+    memory[i] = (i % 19) * 0.125;
+  }
+  wasmDot = instance.exports.dot;
+}
+
+function WasmDotProduct() {
+  return wasmDot(kWasmElements, kWasmElements * 8);
+}
+
+createSuite('WasmDotProduct', 1000, WasmDotProduct, WasmSetup);
@@ -0,0 +1,31 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-parallel-register-allocation
+// Flags: --runtime-call-stats
+
+// The function has to be large enough for floating-point registers to be
+// allocated on a worker thread.
+let body = 'let d = x * 0.5; let i = y | 0;\n';
+for (let n = 0; n < 400; n++) {
+  body += `d = d * 1.0001 + ${n}.25; i = (i + d) | 0;\n`;
+  body += `if (i & 1) { d = d - i / 3; } else { i = (i ^ ${n}) | 0; }\n`;
+}
+body += 'return d + i;';
+const foo = new Function('x', 'y', body);
+
+%GetAndResetRuntimeCallStats();
+%PrepareFunctionForOptimization(foo);
+const expected = foo(1.5, 7);
+assertEquals(expected, foo(1.5, 7));
+%OptimizeFunctionOnNextCall(foo);
+assertEquals(expected, foo(1.5, 7));
+assertOptimized(foo);
+
+// The parallel phase has its own runtime call stats counter. The stats are
+// undefined in builds without runtime call stats.
+const stats = %GetAndResetRuntimeCallStats();
+if (stats !== undefined && isTurboFanned(foo)) {
+  assertMatches(/Optimize(Background)?AllocateRegistersInParallel\s/, stats);
+}
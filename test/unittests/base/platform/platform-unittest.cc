@@ -4,6 +4,9 @@
 
 #include "src/base/platform/platform.h"
 
+#include <cstring>
+
+#include "src/base/page-allocator.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 #if V8_OS_WIN
@@ -24,6 +27,57 @@ TEST(OS, GetCurrentProcessId) {
 #endif
 }
 
+TEST(OS, GetCurrentNumaNode) {
+  const int node = OS::GetCurrentNumaNode();
+  EXPECT_LE(0, node);
+  EXPECT_LT(node, OS::NumberOfNumaNodes());
+}
+
+namespace {
+
+// Transparent huge pages are only handed out for madvise()d regions if they
+// are enabled either for all or for madvise()d mappings.
+bool TransparentHugePagesAvailable() {
+#if V8_OS_LINUX && !V8_OS_ANDROID
+  FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+  if (file == nullptr) return false;
+  char line[128] = {};
+  const bool read = fgets(line, sizeof(line), file) != nullptr;
+  fclose(file);
+  return read && (strstr(line, "[always]") != nullptr ||
+                  strstr(line, "[madvise]") != nullptr);
+#else
+  return false;
+#endif
+}
+
+}  // namespace
+
+TEST(OS, HugePageBackedMemory) {
+  if (!TransparentHugePagesAvailable()) {
+    GTEST_SKIP_("Transparent huge pages are not available");
+  }
+  PageAllocator page_allocator;
+  const size_t size = 2 * OS::kHugePageSize;
+  void* address = page_allocator.AllocatePages(
+      nullptr, size, OS::kHugePageSize, PageAllocator::kReadWrite);
+  ASSERT_NE(nullptr, address);
+  if (!OS::AdviseHugePages(address, size)) {
+    EXPECT_TRUE(page_allocator.FreePages(address, size));
+    GTEST_SKIP_("madvise(MADV_HUGEPAGE) is not supported");
+  }
+  memset(address, 1, size);
+  const size_t backed_bytes = OS::HugePageBackedMemory(address, size);
+  EXPECT_LE(backed_bytes, size);
+  EXPECT_EQ(0u, backed_bytes % OS::kHugePageSize);
+  EXPECT_TRUE(page_allocator.FreePages(address, size));
+  if (backed_bytes == 0) {
+    // The kernel is free to back the range with small pages, e.g. when
+    // physical memory is fragmented.
+    GTEST_SKIP_("No huge page was obtained");
+  }
+}
+
 
 namespace {
 
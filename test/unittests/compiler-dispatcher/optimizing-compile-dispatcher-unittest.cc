@@ -8,6 +8,7 @@
 #include "src/base/atomic-utils.h"
 #include "src/base/platform/semaphore.h"
 #include "src/codegen/compiler.h"
+#include "src/codegen/optimization-hints.h"
 #include "src/codegen/optimized-compilation-info.h"
 #include "src/execution/isolate.h"
 #include "src/execution/local-isolate.h"
@@ -64,6 +65,19 @@ class BlockingCompilationJob : public OptimizedCompilationJob {
   base::Semaphore semaphore_;
 };
 
+Handle<JSFunction> EnsureCompiled(Isolate* isolate,
+                                  Handle<JSFunction> function) {
+  IsCompiledScope is_compiled_scope;
+  CHECK(Compiler::Compile(isolate, function, Compiler::CLEAR_EXCEPTION,
+                          &is_compiled_scope));
+  JSFunction::EnsureFeedbackVector(function, &is_compiled_scope);
+  return function;
+}
+
+uint32_t FeedbackDigestOf(Handle<JSFunction> function) {
+  return OptimizationHints::FeedbackDigest(function->feedback_vector());
+}
+
 }  // namespace
 
 TEST_F(OptimizingCompileDispatcherTest, Construct) {
@@ -97,5 +111,151 @@ TEST_F(OptimizingCompileDispatcherTest, NonBlockingFlush) {
   dispatcher.Stop();
 }
 
+TEST_F(OptimizingCompileDispatcherTest, PriorityFor) {
+  Handle<JSFunction> fun =
+      RunJS<JSFunction>("function f() { function g() {}; return g;}; f();");
+  using Priority = OptimizingCompileDispatcher::Priority;
+  Priority cold = OptimizingCompileDispatcher::PriorityFor(*fun, 1);
+  Priority hot = OptimizingCompileDispatcher::PriorityFor(*fun, 2);
+  ASSERT_LT(cold, hot);
+
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  ASSERT_TRUE(dispatcher.IsQueueAvailable(cold));
+  dispatcher.Stop();
+}
+
+// The tests below fill the input queue directly, so that no compile tasks are
+// posted that would race with the test for the queued jobs.
+
+TEST_F(OptimizingCompileDispatcherTest, HighestPriorityFirst) {
+  Handle<JSFunction> fun = EnsureCompiled(
+      i_isolate(), RunJS<JSFunction>("function f() {}; f;"));
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  BlockingCompilationJob* low = new BlockingCompilationJob(i_isolate(), fun);
+  BlockingCompilationJob* mid1 = new BlockingCompilationJob(i_isolate(), fun);
+  BlockingCompilationJob* high = new BlockingCompilationJob(i_isolate(), fun);
+  BlockingCompilationJob* mid2 = new BlockingCompilationJob(i_isolate(), fun);
+  base::TimeTicks now = base::TimeTicks::Now();
+  dispatcher.input_queue_.push_back({low, 1, 0, now});
+  dispatcher.input_queue_.push_back({mid1, 2, 0, now});
+  dispatcher.input_queue_.push_back({high, 3, 0, now});
+  dispatcher.input_queue_.push_back({mid2, 2, 0, now});
+
+  // Jobs of equal priority are dequeued in the order they were queued.
+  for (BlockingCompilationJob* expected : {high, mid1, mid2, low}) {
+    OptimizedCompilationJob* job = dispatcher.NextInput(nullptr);
+    ASSERT_EQ(expected, job);
+    delete job;
+  }
+  ASSERT_EQ(nullptr, dispatcher.NextInput(nullptr));
+  dispatcher.Stop();
+}
+
+TEST_F(OptimizingCompileDispatcherTest, EvictLowestPriority) {
+  Handle<JSFunction> fun = EnsureCompiled(
+      i_isolate(), RunJS<JSFunction>("function f() {}; f;"));
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  base::TimeTicks now = base::TimeTicks::Now();
+  BlockingCompilationJob* lowest = new BlockingCompilationJob(i_isolate(), fun);
+  dispatcher.input_queue_.push_back({lowest, 1, 0, now});
+  while (dispatcher.IsQueueAvailable()) {
+    dispatcher.input_queue_.push_back(
+        {new BlockingCompilationJob(i_isolate(), fun), 2, 0, now});
+  }
+  size_t capacity = dispatcher.input_queue_.size();
+
+  // Only jobs with a higher priority than the lowest queued one fit. Asking
+  // does not change the queue.
+  ASSERT_FALSE(dispatcher.IsQueueAvailable(1));
+  ASSERT_TRUE(dispatcher.IsQueueAvailable(2));
+  ASSERT_EQ(capacity, dispatcher.input_queue_.size());
+
+  BlockingCompilationJob* hot = new BlockingCompilationJob(i_isolate(), fun);
+  dispatcher.QueueForOptimization(hot, 3);
+
+  // The compile task posted for |hot| picks it up, as it has the highest
+  // priority.
+  while (!hot->IsBlocking()) {
+  }
+  {
+    base::MutexGuard access_input_queue(&dispatcher.input_queue_mutex_);
+    // Failing an ASSERT here would leave |hot| blocked.
+    EXPECT_EQ(capacity - 1, dispatcher.input_queue_.size());
+    for (const auto& entry : dispatcher.input_queue_) {
+      EXPECT_NE(lowest, entry.job);
+      EXPECT_EQ(2u, entry.priority);
+    }
+  }
+
+  hot->Signal();
+  dispatcher.Stop();
+}
+
+TEST_F(OptimizingCompileDispatcherTest, CancelStaleJobs) {
+  SaveFlags save_flags;
+  FLAG_concurrent_inlining = false;
+  Handle<JSFunction> changed = EnsureCompiled(
+      i_isolate(), RunJS<JSFunction>("function f(o) { return o.x; }; f;"));
+  Handle<JSFunction> unchanged = EnsureCompiled(
+      i_isolate(), RunJS<JSFunction>("function g(o) { return o.y; }; g;"));
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  base::TimeTicks now = base::TimeTicks::Now();
+  dispatcher.input_queue_.push_back(
+      {new BlockingCompilationJob(i_isolate(), changed), 1,
+       FeedbackDigestOf(changed), now});
+  BlockingCompilationJob* kept =
+      new BlockingCompilationJob(i_isolate(), unchanged);
+  dispatcher.input_queue_.push_back(
+      {kept, 1, FeedbackDigestOf(unchanged), now});
+
+  RunJS("f({x: 1});");
+  dispatcher.CancelStaleJobs();
+  ASSERT_EQ(1u, dispatcher.input_queue_.size());
+  ASSERT_EQ(kept, dispatcher.input_queue_.front().job);
+  dispatcher.Stop();
+}
+
+TEST_F(OptimizingCompileDispatcherTest, KeepChangedJobsWithConcurrentInlining) {
+  SaveFlags save_flags;
+  FLAG_concurrent_inlining = true;
+  Handle<JSFunction> changed = EnsureCompiled(
+      i_isolate(), RunJS<JSFunction>("function f(o) { return o.x; }; f;"));
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  dispatcher.input_queue_.push_back(
+      {new BlockingCompilationJob(i_isolate(), changed), 1,
+       FeedbackDigestOf(changed), base::TimeTicks::Now()});
+
+  RunJS("f({x: 1});");
+  dispatcher.CancelStaleJobs();
+  ASSERT_EQ(1u, dispatcher.input_queue_.size());
+  dispatcher.Stop();
+}
+
+TEST_F(OptimizingCompileDispatcherTest, Prioritize) {
+  Handle<JSFunction> hot = EnsureCompiled(
+      i_isolate(), RunJS<JSFunction>("function f() {}; f;"));
+  Handle<JSFunction> looping = EnsureCompiled(
+      i_isolate(), RunJS<JSFunction>("function g() {}; g;"));
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  BlockingCompilationJob* hot_job =
+      new BlockingCompilationJob(i_isolate(), hot);
+  BlockingCompilationJob* looping_job =
+      new BlockingCompilationJob(i_isolate(), looping);
+  base::TimeTicks now = base::TimeTicks::Now();
+  dispatcher.input_queue_.push_back(
+      {hot_job, OptimizingCompileDispatcher::PriorityFor(*hot, 100), 0, now});
+  dispatcher.input_queue_.push_back(
+      {looping_job, OptimizingCompileDispatcher::PriorityFor(*looping, 1), 0,
+       now});
+
+  dispatcher.Prioritize(*looping);
+  for (BlockingCompilationJob* expected : {looping_job, hot_job}) {
+    OptimizedCompilationJob* job = dispatcher.NextInput(nullptr);
+    ASSERT_EQ(expected, job);
+    delete job;
+  }
+  dispatcher.Stop();
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -106,6 +106,11 @@ class CompactorTest : public testing::TestWithPlatform {
   std::unique_ptr<cppgc::Heap> heap_;
 };
 
+class ParallelCompactorTest : public CompactorTest {
+ public:
+  ParallelCompactorTest() { compactor().set_parallel_compaction(true); }
+};
+
 }  // namespace
 
 }  // namespace internal
@@ -240,5 +245,69 @@ TEST_F(CompactorTest, InteriorSlotToNextObject) {
   EXPECT_EQ(references[1], holder->objects[1]->other);
 }
 
+TEST_F(ParallelCompactorTest, NonEmptySpaceHalfLive) {
+  static constexpr int kNumObjects = 10;
+  Persistent<CompactableHolder<kNumObjects>> holder =
+      MakeGarbageCollected<CompactableHolder<kNumObjects>>(
+          GetAllocationHandle(), GetAllocationHandle());
+  CompactableGCed* references[kNumObjects] = {nullptr};
+  for (int i = 0; i < kNumObjects; ++i) {
+    references[i] = holder->objects[i];
+    holder->objects[i]->id = i;
+  }
+  StartGC();
+  for (int i = 0; i < kNumObjects; i += 2) {
+    holder->objects[i] = nullptr;
+  }
+  EndGC();
+  EXPECT_EQ(5u, CompactableGCed::g_destructor_callcount);
+  for (int i = 1; i < kNumObjects; i += 2) {
+    EXPECT_EQ(holder->objects[i], references[i / 2]);
+    EXPECT_EQ(static_cast<size_t>(i), holder->objects[i]->id);
+  }
+}
+
+TEST_F(ParallelCompactorTest, CompactAcrossPages) {
+  Persistent<CompactableHolder<1>> holder =
+      MakeGarbageCollected<CompactableHolder<1>>(GetAllocationHandle(),
+                                                 GetAllocationHandle());
+  CompactableGCed* reference = holder->objects[0];
+  static constexpr size_t kObjectsPerPage =
+      kPageSize / (sizeof(CompactableGCed) + sizeof(HeapObjectHeader));
+  for (size_t i = 0; i < kObjectsPerPage; ++i) {
+    holder->objects[0] =
+        MakeGarbageCollected<CompactableGCed>(GetAllocationHandle());
+  }
+  EXPECT_NE(BasePage::FromInnerAddress(heap(), reference),
+            BasePage::FromInnerAddress(heap(), holder->objects[0].Get()));
+  StartGC();
+  EndGC();
+  EXPECT_EQ(kObjectsPerPage, CompactableGCed::g_destructor_callcount);
+  EXPECT_EQ(reference, holder->objects[0]);
+}
+
+TEST_F(ParallelCompactorTest, InteriorSlots) {
+  static constexpr int kNumObjects = 4;
+  Persistent<CompactableHolder<kNumObjects>> holder =
+      MakeGarbageCollected<CompactableHolder<kNumObjects>>(
+          GetAllocationHandle(), GetAllocationHandle());
+  CompactableGCed* references[kNumObjects] = {nullptr};
+  for (int i = 0; i < kNumObjects; ++i) {
+    references[i] = holder->objects[i];
+  }
+  // Slots in moving objects referring to a preceding and a following object.
+  holder->objects[1]->other = holder->objects[3];
+  holder->objects[3]->other = holder->objects[2];
+  holder->objects[2] = nullptr;
+  holder->objects[0] = nullptr;
+  StartGC();
+  EndGC();
+  EXPECT_EQ(1u, CompactableGCed::g_destructor_callcount);
+  EXPECT_EQ(references[0], holder->objects[1]);
+  EXPECT_EQ(references[2], holder->objects[1]->other);
+  EXPECT_EQ(references[2], holder->objects[3]);
+  EXPECT_EQ(references[1], holder->objects[3]->other);
+}
+
 }  // namespace internal
 }  // namespace cppgc
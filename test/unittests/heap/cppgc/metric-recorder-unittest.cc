@@ -17,6 +17,10 @@ class MetricRecorderImpl final : public MetricRecorder {
     FullCycle_event = event;
     FullCycle_callcount++;
   }
+  void AddMainThreadEvent(const YoungCycle& event) final {
+    YoungCycle_event = event;
+    YoungCycle_callcount++;
+  }
   void AddMainThreadEvent(const MainThreadIncrementalMark& event) final {
     MainThreadIncrementalMark_event = event;
     MainThreadIncrementalMark_callcount++;
@@ -28,6 +32,8 @@ class MetricRecorderImpl final : public MetricRecorder {
 
   static size_t FullCycle_callcount;
   static FullCycle FullCycle_event;
+  static size_t YoungCycle_callcount;
+  static YoungCycle YoungCycle_event;
   static size_t MainThreadIncrementalMark_callcount;
   static MainThreadIncrementalMark MainThreadIncrementalMark_event;
   static size_t MainThreadIncrementalSweep_callcount;
@@ -37,6 +43,8 @@ class MetricRecorderImpl final : public MetricRecorder {
 // static
 size_t MetricRecorderImpl::FullCycle_callcount = 0u;
 MetricRecorderImpl::FullCycle MetricRecorderImpl::FullCycle_event;
+size_t MetricRecorderImpl::YoungCycle_callcount = 0u;
+MetricRecorderImpl::YoungCycle MetricRecorderImpl::YoungCycle_event;
 size_t MetricRecorderImpl::MainThreadIncrementalMark_callcount = 0u;
 MetricRecorderImpl::MainThreadIncrementalMark
     MetricRecorderImpl::MainThreadIncrementalMark_event;
@@ -50,10 +58,10 @@ class MetricRecorderTest : public testing::TestWithHeap {
     stats->SetMetricRecorder(std::make_unique<MetricRecorderImpl>());
   }
 
-  void StartGC() {
+  void StartGC(GarbageCollector::Config::CollectionType collection_type =
+                   GarbageCollector::Config::CollectionType::kMajor) {
     stats->NotifyMarkingStarted(
-        GarbageCollector::Config::CollectionType::kMajor,
-        GarbageCollector::Config::IsForcedGC::kNotForced);
+        collection_type, GarbageCollector::Config::IsForcedGC::kNotForced);
   }
   void EndGC(size_t marked_bytes) {
     stats->NotifyMarkingCompleted(marked_bytes);
@@ -321,5 +329,29 @@ TEST_F(MetricRecorderTest, ObjectSizeMetricsWithAllocations) {
   EXPECT_EQ(400u, MetricRecorderImpl::FullCycle_event.memory.freed_bytes);
 }
 
+TEST_F(MetricRecorderTest, YoungCycleReportedForMinorGC) {
+  MetricRecorderImpl::FullCycle_callcount = 0u;
+  MetricRecorderImpl::YoungCycle_callcount = 0u;
+  StartGC();
+  EndGC(1000);
+  EXPECT_EQ(1u, MetricRecorderImpl::FullCycle_callcount);
+  EXPECT_EQ(0u, MetricRecorderImpl::YoungCycle_callcount);
+  StartGC(GarbageCollector::Config::CollectionType::kMinor);
+  {
+    StatsCollector::EnabledScope scope(Heap::From(GetHeap())->stats_collector(),
+                                       StatsCollector::kAtomicMark);
+    scope.DecreaseStartTimeForTesting(v8::base::TimeDelta::FromMilliseconds(1));
+  }
+  EndGC(100);
+  EXPECT_EQ(1u, MetricRecorderImpl::FullCycle_callcount);
+  EXPECT_EQ(1u, MetricRecorderImpl::YoungCycle_callcount);
+  EXPECT_LT(0,
+            MetricRecorderImpl::YoungCycle_event.main_thread.mark_duration_us);
+  EXPECT_EQ(100, MetricRecorderImpl::YoungCycle_event.promoted_bytes);
+  // Objects that survived the full GC are treated as live.
+  EXPECT_EQ(1100u, stats->marked_bytes());
+  EXPECT_EQ(100u, stats->marked_bytes_on_current_cycle());
+}
+
 }  // namespace internal
 }  // namespace cppgc
@@ -237,6 +237,21 @@ TYPED_TEST(MinorGCTestForType, OmitGenerationalBarrierForSentinels) {
   old->next = static_cast<Type*>(kSentinelPointer);
   EXPECT_EQ(set_size_before_barrier, set.size());
 }
+
+TYPED_TEST(MinorGCTestForType, ForcedYoungGenerationGC) {
+  using Type = typename TestFixture::Type;
+
+  Persistent<Type> old =
+      MakeGarbageCollected<Type>(this->GetAllocationHandle());
+  TestFixture::CollectMinor();
+  EXPECT_FALSE(HeapObjectHeader::FromObject(old.Get()).IsYoung());
+
+  old->next = MakeGarbageCollected<Type>(this->GetAllocationHandle());
+  MakeGarbageCollected<Type>(this->GetAllocationHandle());
+  this->GetHeap()->ForceYoungGenerationGarbageCollectionSlow("test", "test");
+  EXPECT_EQ(1u, TestFixture::DestructedObjects());
+  EXPECT_FALSE(HeapObjectHeader::FromObject(old->next.Get()).IsYoung());
+}
 }  // namespace internal
 }  // namespace cppgc
 
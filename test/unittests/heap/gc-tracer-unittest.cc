@@ -313,6 +313,45 @@ TEST_F(GCTracerTest, IncrementalMarkingSpeed) {
                        tracer->IncrementalMarkingSpeedInBytesPerMillisecond()));
 }
 
+TEST_F(GCTracerTest, ConcurrentSweepingSpeed) {
+  GCTracer* tracer = i_isolate()->heap()->tracer();
+  tracer->ResetForTesting();
+
+  EXPECT_EQ(0, tracer->ConcurrentSweepingSpeedInBytesPerMillisecond());
+  // 1000000 bytes in 100ms.
+  tracer->AddConcurrentSweepingEvent(100, 1000000);
+  EXPECT_EQ(1000000 / 100,
+            tracer->ConcurrentSweepingSpeedInBytesPerMillisecond());
+  // 3000000 bytes in 100ms.
+  tracer->AddConcurrentSweepingEvent(100, 3000000);
+  EXPECT_EQ(4000000 / 200,
+            tracer->ConcurrentSweepingSpeedInBytesPerMillisecond());
+}
+
+TEST_F(GCTracerTest, PauseHistogram) {
+  Heap* heap = i_isolate()->heap();
+  GCTracer* tracer = heap->tracer();
+  tracer->ResetForTesting();
+  const double previous_target = heap->gc_pause_target_ms();
+  heap->SetGCPauseTarget(2.0);
+
+  tracer->RecordPause(0.1);
+  tracer->RecordPause(1.5);
+  tracer->RecordPause(3.0);
+  tracer->RecordPause(1000.0);
+  const GCTracer::PauseHistogram& histogram = tracer->pause_histogram();
+  EXPECT_EQ(4u, histogram.total_pauses);
+  EXPECT_EQ(2u, histogram.pauses_over_target);
+  EXPECT_DOUBLE_EQ(1000.0, histogram.max_pause_in_ms);
+  // Buckets end at 0.25ms, 0.5ms, 1ms, 2ms, 4ms, ...
+  EXPECT_EQ(1u, histogram.buckets[0]);
+  EXPECT_EQ(1u, histogram.buckets[3]);
+  EXPECT_EQ(1u, histogram.buckets[4]);
+  EXPECT_EQ(1u, histogram.buckets[GCTracer::kPauseHistogramBuckets - 1]);
+
+  heap->SetGCPauseTarget(previous_target);
+}
+
 TEST_F(GCTracerTest, MutatorUtilization) {
   GCTracer* tracer = i_isolate()->heap()->tracer();
   tracer->ResetForTesting();
@@ -9,8 +9,10 @@
 #include <limits>
 
 #include "src/handles/handles-inl.h"
+#include "src/heap/memory-allocator.h"
 #include "src/heap/memory-chunk.h"
 #include "src/heap/safepoint.h"
+#include "src/heap/scavenger.h"
 #include "src/heap/spaces-inl.h"
 #include "src/objects/objects-inl.h"
 #include "test/unittests/test-utils.h"
@@ -174,5 +176,43 @@ TEST_F(HeapTest, HeapLayout) {
 }
 #endif  // V8_COMPRESS_POINTERS
 
+TEST_F(HeapTest, ScavengerJobOrdersPagesByNumaNode) {
+  if (FLAG_enable_third_party_heap) return;
+  SaveFlags save_flags;
+  FLAG_numa_aware_heap = true;
+  MemoryAllocator* allocator = i_isolate()->heap()->memory_allocator();
+  const int kNodes[] = {1, MemoryChunk::kNoNumaNode, 0, 1};
+  std::vector<std::pair<ParallelWorkItem, MemoryChunk*>> memory_chunks;
+  for (int node : kNodes) {
+    Page* page = allocator->AllocatePage(
+        MemoryChunkLayout::AllocatableMemoryInDataPage(),
+        static_cast<PagedSpace*>(i_isolate()->heap()->old_space()),
+        NOT_EXECUTABLE);
+    ASSERT_NE(nullptr, page);
+    page->set_numa_node(node);
+    memory_chunks.emplace_back(ParallelWorkItem{}, page);
+  }
+
+  ScavengerCollector::JobTask job(nullptr, nullptr, memory_chunks, nullptr,
+                                  nullptr);
+  // Pages are stably sorted by node, with pages of no node in front.
+  ASSERT_EQ(memory_chunks.size(), job.memory_chunks_.size());
+  EXPECT_EQ(memory_chunks[1].second, job.memory_chunks_[0].second);
+  EXPECT_EQ(memory_chunks[2].second, job.memory_chunks_[1].second);
+  EXPECT_EQ(memory_chunks[0].second, job.memory_chunks_[2].second);
+  EXPECT_EQ(memory_chunks[3].second, job.memory_chunks_[3].second);
+  // Workers start with the range of their own node.
+  ASSERT_EQ(static_cast<size_t>(base::OS::NumberOfNumaNodes()),
+            job.numa_node_ranges_.size());
+  EXPECT_EQ(std::make_pair(size_t{1}, size_t{2}), job.numa_node_ranges_[0]);
+  if (job.numa_node_ranges_.size() > 1) {
+    EXPECT_EQ(std::make_pair(size_t{2}, size_t{4}), job.numa_node_ranges_[1]);
+  }
+
+  for (auto& work_item : memory_chunks) {
+    allocator->Free<MemoryAllocator::kFull>(work_item.second);
+  }
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -296,5 +296,43 @@ TEST_F(SpacesTest,
   }
 }
 
+// Tests that FreeListSizeClasses::SelectFreeListCategoryType returns what it
+// should.
+TEST_F(SpacesTest, FreeListSizeClassesSelectFreeListCategoryType) {
+  FreeListSizeClasses free_list;
+
+  // Every size up to kMaxExactSize has a category of its own.
+  for (size_t size = FreeListSizeClasses::kMinBlockSize;
+       size <= FreeListSizeClasses::kMaxExactSize; size += kTaggedSize) {
+    FreeListCategoryType cat = free_list.SelectFreeListCategoryType(size);
+    EXPECT_TRUE(FreeListSizeClasses::IsExactCategory(cat));
+    EXPECT_EQ(size, FreeListSizeClasses::CategoryMinSize(cat));
+  }
+
+  // Larger sizes fit in their category, but not in the next one.
+  for (size_t size = FreeListSizeClasses::kMaxExactSize + kTaggedSize;
+       size <= FreeListSizeClasses::kMaxBlockSize; size += 4 * kTaggedSize) {
+    FreeListCategoryType cat = free_list.SelectFreeListCategoryType(size);
+    EXPECT_FALSE(FreeListSizeClasses::IsExactCategory(cat));
+    EXPECT_LE(FreeListSizeClasses::CategoryMinSize(cat), size);
+    if (cat != free_list.last_category_) {
+      EXPECT_LT(size, FreeListSizeClasses::CategoryMinSize(cat + 1));
+    }
+  }
+}
+
+// Tests that FreeListSizeClasses::GuaranteedAllocatable returns what it
+// should.
+TEST_F(SpacesTest, FreeListSizeClassesGuaranteedAllocatable) {
+  FreeListSizeClasses free_list;
+
+  EXPECT_EQ(0u, free_list.GuaranteedAllocatable(
+                    FreeListSizeClasses::kMinBlockSize - kTaggedSize));
+  for (int cat = kFirstCategory; cat <= free_list.last_category_; cat++) {
+    size_t size = FreeListSizeClasses::CategoryMinSize(cat);
+    EXPECT_EQ(size, free_list.GuaranteedAllocatable(size));
+  }
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,312 @@
+// Copyright 2021 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <unordered_set>
+#include <vector>
+
+#include "src/base/memory.h"
+#include "src/execution/isolate.h"
+#include "src/handles/global-handles.h"
+#include "src/handles/handles-inl.h"
+#include "src/heap/factory.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/third-party/heap-api.h"
+#include "src/objects/fixed-array-inl.h"
+#include "src/objects/js-objects-inl.h"
+#include "test/unittests/heap/heap-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+#ifdef V8_ENABLE_THIRD_PARTY_HEAP
+
+namespace v8 {
+namespace internal {
+
+using ThirdPartyHeapTest = TestWithHeapInternals;
+using ThirdPartyHeapWithContextTest =  //
+    WithHeapInternals<                  //
+        WithInternalIsolateMixin<       //
+            WithContextMixin<           //
+                WithIsolateScopeMixin<  //
+                    WithIsolateMixin<   //
+                        ::testing::Test>>>>>;
+using TPHeap = third_party_heap::Heap;
+
+namespace {
+
+std::unordered_set<Address> IterableObjects(Heap* heap) {
+  std::unordered_set<Address> objects;
+  HeapObjectIterator iterator(heap);
+  for (HeapObject obj = iterator.Next(); !obj.is_null();
+       obj = iterator.Next()) {
+    objects.insert(obj.address());
+  }
+  return objects;
+}
+
+}  // namespace
+
+TEST_F(ThirdPartyHeapTest, AllocatedObjectsAreIterable) {
+  HandleScope scope(i_isolate());
+  std::vector<Handle<FixedArray>> arrays;
+  // Sizes covering the exact and geometric size classes, bump allocation of
+  // medium sized objects and large objects.
+  for (int length : {0, 1, 7, 31, 100, 1000, 5000, 100000}) {
+    arrays.push_back(
+        i_isolate()->factory()->NewFixedArray(length, AllocationType::kOld));
+    arrays.push_back(
+        i_isolate()->factory()->NewFixedArray(length, AllocationType::kYoung));
+  }
+
+  std::unordered_set<Address> objects = IterableObjects(heap());
+  for (Handle<FixedArray> array : arrays) {
+    if (array->length() == 0) continue;  // The canonical empty array.
+    EXPECT_TRUE(TPHeap::IsValidHeapObject(*array));
+    EXPECT_EQ(1u, objects.count(array->address()));
+  }
+  Handle<FixedArray> large = arrays.back();
+  EXPECT_LT(heap()->MaxRegularHeapObjectSize(AllocationType::kOld),
+            large->Size());
+  EXPECT_TRUE(TPHeap::InLargeObjectSpace(large->address()));
+}
+
+TEST_F(ThirdPartyHeapTest, CollectGarbageKeepsReachableObjects) {
+  static const int kObjects = 2000;
+  HandleScope scope(i_isolate());
+  Handle<FixedArray> holder =
+      i_isolate()->factory()->NewFixedArray(kObjects, AllocationType::kOld);
+  std::vector<Address> survivors;
+  std::vector<Address> dead;
+  {
+    HandleScope inner_scope(i_isolate());
+    // Interleave live and dead objects of the same size, so that every block
+    // holding a dead object also holds a live one and is swept rather than
+    // released.
+    for (int i = 0; i < kObjects; i++) {
+      Handle<FixedArray> live =
+          i_isolate()->factory()->NewFixedArray(2, AllocationType::kOld);
+      live->set(0, Smi::FromInt(i));
+      holder->set(i, *live);
+      survivors.push_back(live->address());
+      dead.push_back(i_isolate()
+                         ->factory()
+                         ->NewFixedArray(2, AllocationType::kOld)
+                         ->address());
+    }
+  }
+
+  CollectGarbage(OLD_SPACE);
+
+  std::unordered_set<Address> objects = IterableObjects(heap());
+  EXPECT_EQ(1u, objects.count(holder->address()));
+  for (int i = 0; i < kObjects; i++) {
+    // The heap does not move objects.
+    FixedArray live = FixedArray::cast(holder->get(i));
+    EXPECT_EQ(survivors[i], live.address());
+    EXPECT_EQ(Smi::FromInt(i), live.get(0));
+    EXPECT_EQ(1u, objects.count(survivors[i]));
+    EXPECT_EQ(0u, objects.count(dead[i]));
+  }
+}
+
+TEST_F(ThirdPartyHeapTest, CollectGarbageTracesLongChains) {
+  // Only the head of the list is referenced from a handle.
+  static const int kChainLength = 5000;
+  HandleScope scope(i_isolate());
+  Handle<FixedArray> head;
+  std::vector<Address> nodes;
+  {
+    HandleScope inner_scope(i_isolate());
+    Handle<Object> next = i_isolate()->factory()->undefined_value();
+    for (int i = 0; i < kChainLength; i++) {
+      Handle<FixedArray> node =
+          i_isolate()->factory()->NewFixedArray(2, AllocationType::kOld);
+      node->set(0, *next);
+      node->set(1, Smi::FromInt(i));
+      nodes.push_back(node->address());
+      next = node;
+    }
+    head = inner_scope.CloseAndEscape(Handle<FixedArray>::cast(next));
+  }
+
+  CollectGarbage(OLD_SPACE);
+
+  std::unordered_set<Address> objects = IterableObjects(heap());
+  int index = kChainLength - 1;
+  for (Object current = *head; !current.IsUndefined(i_isolate());
+       current = FixedArray::cast(current).get(0), index--) {
+    ASSERT_LE(0, index);
+    EXPECT_EQ(nodes[index], HeapObject::cast(current).address());
+    EXPECT_EQ(Smi::FromInt(index), FixedArray::cast(current).get(1));
+    EXPECT_EQ(1u, objects.count(nodes[index]));
+  }
+  EXPECT_EQ(-1, index);
+}
+
+TEST_F(ThirdPartyHeapTest, CollectGarbageClearsWeakReferencesToDeadObjects) {
+  HandleScope scope(i_isolate());
+  GlobalHandles* global_handles = i_isolate()->global_handles();
+  Handle<FixedArray> live =
+      i_isolate()->factory()->NewFixedArray(2, AllocationType::kOld);
+  Handle<WeakFixedArray> weak_refs =
+      i_isolate()->factory()->NewWeakFixedArray(2, AllocationType::kOld);
+  Address* live_location = global_handles->Create(*live).location();
+  Address* dead_location;
+  {
+    HandleScope inner_scope(i_isolate());
+    Handle<FixedArray> dead =
+        i_isolate()->factory()->NewFixedArray(2, AllocationType::kOld);
+    dead_location = global_handles->Create(*dead).location();
+    weak_refs->Set(0, HeapObjectReference::Weak(*dead));
+    weak_refs->Set(1, HeapObjectReference::Weak(*live));
+  }
+  GlobalHandles::MakeWeak(&live_location);
+  GlobalHandles::MakeWeak(&dead_location);
+
+  CollectGarbage(OLD_SPACE);
+
+  // Only weak handles refer to the dead array, so they are reset.
+  EXPECT_EQ(nullptr, dead_location);
+  EXPECT_TRUE(weak_refs->Get(0)->IsCleared());
+  ASSERT_NE(nullptr, live_location);
+  EXPECT_EQ(*live, Object(*live_location));
+  EXPECT_EQ(HeapObjectReference::Weak(*live), weak_refs->Get(1));
+  GlobalHandles::Destroy(live_location);
+}
+
+#ifdef V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL
+
+namespace {
+
+bool IsCardDirty(Heap* heap, Address slot) {
+  const Address card_table_base = *heap->ThirdPartyHeapCardTableBaseAddress();
+  return base::Memory<uint8_t>(card_table_base +
+                               (slot >> TPHeap::kCardSizeLog2)) ==
+         TPHeap::kDirtyCard;
+}
+
+}  // namespace
+
+TEST_F(ThirdPartyHeapTest, OldToYoungStoreMarksCard) {
+  HandleScope scope(i_isolate());
+  Handle<FixedArray> old_host =
+      i_isolate()->factory()->NewFixedArray(2, AllocationType::kOld);
+  Handle<FixedArray> old_value =
+      i_isolate()->factory()->NewFixedArray(2, AllocationType::kOld);
+  // A full GC clears all cards.
+  CollectGarbage(OLD_SPACE);
+  Handle<FixedArray> young_host =
+      i_isolate()->factory()->NewFixedArray(2, AllocationType::kYoung);
+  Handle<FixedArray> young_value =
+      i_isolate()->factory()->NewFixedArray(2, AllocationType::kYoung);
+  EXPECT_FALSE(TPHeap::InYoungGeneration(*old_host));
+  EXPECT_TRUE(TPHeap::InYoungGeneration(*young_host));
+  const Address slot = old_host->RawFieldOfElementAt(0).address();
+  ASSERT_FALSE(IsCardDirty(heap(), slot));
+
+  old_host->set(0, *old_value);
+  EXPECT_FALSE(IsCardDirty(heap(), slot));
+  young_host->set(0, *young_value);
+  EXPECT_FALSE(
+      IsCardDirty(heap(), young_host->RawFieldOfElementAt(0).address()));
+  old_host->set(0, *young_value);
+  EXPECT_TRUE(IsCardDirty(heap(), slot));
+}
+
+TEST_F(ThirdPartyHeapTest, NurseryCollectionUsesDirtyCardsAsRoots) {
+  HandleScope scope(i_isolate());
+  Handle<FixedArray> old_host =
+      i_isolate()->factory()->NewFixedArray(2, AllocationType::kOld);
+  CollectGarbage(OLD_SPACE);
+  const Address slot = old_host->RawFieldOfElementAt(0).address();
+  ASSERT_FALSE(IsCardDirty(heap(), slot));
+
+  Address survivor;
+  Address dead;
+  {
+    HandleScope inner_scope(i_isolate());
+    Handle<FixedArray> young =
+        i_isolate()->factory()->NewFixedArray(2, AllocationType::kYoung);
+    young->set(0, Smi::FromInt(42));
+    // The old host is the only retainer of the young object.
+    old_host->set(0, *young);
+    survivor = young->address();
+    dead = i_isolate()
+               ->factory()
+               ->NewFixedArray(2, AllocationType::kYoung)
+               ->address();
+  }
+  ASSERT_TRUE(IsCardDirty(heap(), slot));
+
+  CollectGarbage(NEW_SPACE);
+
+  FixedArray promoted = FixedArray::cast(old_host->get(0));
+  EXPECT_EQ(survivor, promoted.address());
+  EXPECT_EQ(Smi::FromInt(42), promoted.get(0));
+  // Survivors are promoted in place and no old-to-young references remain.
+  EXPECT_FALSE(TPHeap::InYoungGeneration(promoted));
+  EXPECT_FALSE(IsCardDirty(heap(), slot));
+
+  std::unordered_set<Address> objects = IterableObjects(heap());
+  EXPECT_EQ(1u, objects.count(survivor));
+  EXPECT_EQ(0u, objects.count(dead));
+}
+
+TEST_F(ThirdPartyHeapWithContextTest, OptimizedFieldStoreMarksCard) {
+  if (!FLAG_opt) return;
+  FLAG_allow_natives_syntax = true;
+  HandleScope scope(i_isolate());
+  Handle<JSObject> host = RunJS<JSObject>(
+      "function store(o, v) { o.field = v; }"
+      "%PrepareFunctionForOptimization(store);"
+      "store({field: null}, {value: 0});"
+      "store({field: null}, {value: 0});"
+      "%OptimizeFunctionOnNextCall(store);"
+      "store({field: null}, {value: 0});"
+      "var host = {field: null};"
+      "host");
+  Handle<JSFunction> store = RunJS<JSFunction>("store");
+  ASSERT_TRUE(store->HasAttachedOptimizedCode());
+  CollectGarbage(OLD_SPACE);
+  ASSERT_FALSE(TPHeap::InYoungGeneration(*host));
+  const Address slot =
+      host->address() + host->map().GetInObjectPropertyOffset(0);
+  ASSERT_FALSE(IsCardDirty(heap(), slot));
+
+  RunJS("store(host, {value: 42});");
+  EXPECT_TRUE(store->HasAttachedOptimizedCode());
+  EXPECT_TRUE(IsCardDirty(heap(), slot));
+  // The young value is only retained by the old host.
+  CollectGarbage(NEW_SPACE);
+  EXPECT_EQ(Smi::FromInt(42), *RunJS("host.field.value"));
+}
+
+TEST_F(ThirdPartyHeapWithContextTest, StubElementStoreMarksCard) {
+  // Keeps the keyed store in the stub handler of the IC rather than the
+  // runtime.
+  FLAG_lazy_feedback_allocation = false;
+  HandleScope scope(i_isolate());
+  Handle<JSArray> host = RunJS<JSArray>(
+      "function store(a, v) { a[0] = v; }"
+      "store([{}, {}], {value: 0});"
+      "store([{}, {}], {value: 0});"
+      "var host = [{}, {}];"
+      "host");
+  CollectGarbage(OLD_SPACE);
+  FixedArray elements = FixedArray::cast(host->elements());
+  ASSERT_FALSE(TPHeap::InYoungGeneration(elements));
+  const Address slot = elements.RawFieldOfElementAt(0).address();
+  ASSERT_FALSE(IsCardDirty(heap(), slot));
+
+  RunJS("store(host, {value: 42});");
+  EXPECT_TRUE(IsCardDirty(heap(), slot));
+  CollectGarbage(NEW_SPACE);
+  EXPECT_EQ(Smi::FromInt(42), *RunJS("host[0].value"));
+}
+
+#endif  // V8_ENABLE_THIRD_PARTY_HEAP_GENERATIONAL
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_ENABLE_THIRD_PARTY_HEAP
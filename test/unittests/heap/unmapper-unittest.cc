@@ -8,6 +8,7 @@
 #include "src/execution/isolate.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/memory-allocator.h"
+#include "src/heap/new-spaces.h"
 #include "src/heap/spaces-inl.h"
 #include "src/utils/ostreams.h"
 #include "test/unittests/test-utils.h"
@@ -362,6 +363,42 @@ TEST_F(SequentialUnmapperTest, UnmapOnTeardown) {
   tracking_page_allocator()->CheckIsFree(page->address(), page_size);
 #endif  // V8_COMPRESS_POINTERS
 }
+
+TEST_F(SequentialUnmapperTest, PooledPagesPreferNumaNode) {
+  if (FLAG_enable_third_party_heap) return;
+  SaveFlags save_flags;
+  FLAG_numa_aware_heap = true;
+  const int node = base::OS::GetCurrentNumaNode();
+  SemiSpace* semi_space = &heap()->new_space()->to_space();
+  Page* local_page = allocator()->AllocatePage<MemoryAllocator::kPooled>(
+      MemoryChunkLayout::AllocatableMemoryInDataPage(), semi_space,
+      NOT_EXECUTABLE);
+  Page* remote_page = allocator()->AllocatePage<MemoryAllocator::kPooled>(
+      MemoryChunkLayout::AllocatableMemoryInDataPage(), semi_space,
+      NOT_EXECUTABLE);
+  ASSERT_NE(nullptr, local_page);
+  ASSERT_NE(nullptr, remote_page);
+  // Binding may fail, e.g. under seccomp sandboxes, so nodes are assigned
+  // directly.
+  local_page->set_numa_node(node);
+  remote_page->set_numa_node(node + 1);
+  const Address local_address = local_page->address();
+
+  // The remote page is pooled last and would be reused first without a node
+  // preference.
+  allocator()->Free<MemoryAllocator::kPooledAndQueue>(local_page);
+  allocator()->Free<MemoryAllocator::kPooledAndQueue>(remote_page);
+  unmapper()->FreeQueuedChunks();
+
+  Page* page = allocator()->AllocatePage<MemoryAllocator::kPooled>(
+      MemoryChunkLayout::AllocatableMemoryInDataPage(), semi_space,
+      NOT_EXECUTABLE);
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ(local_address, page->address());
+  EXPECT_EQ(node, page->numa_node());
+  allocator()->Free<MemoryAllocator::kPooledAndQueue>(page);
+  unmapper()->FreeQueuedChunks();
+}
 #endif  // !V8_OS_FUCHSIA
 
 }  // namespace internal
@@ -34,6 +34,7 @@ export const CATEGORIES = new Map([
   ],
   [
     'compiler-huge', new Set([
+      'fp-register-allocation-zone',
       'graph-zone',
       'instruction-zone',
       'pipeline-compilation-job-zone',
@@ -46,6 +47,7 @@ export const CATEGORIES = new Map([
       'Compile',
       'V8.TFAllocateFPRegisters',
       'V8.TFAllocateGeneralRegisters',
+      'V8.TFAllocateRegistersInParallel',
       'V8.TFAssembleCode',
       'V8.TFAssignSpillSlots',
       'V8.TFBuildLiveRangeBundles',